@@ -90,6 +90,13 @@ namespace ion
 			m_dataSize = 0;
 		}
 
+		void Buffer::Truncate(u32 size)
+		{
+			debug::Assert(m_lockCountWrite > 0, "Buffer::Truncate() - Buffer not locked for writing");
+			debug::Assert(size <= m_dataSize, "Buffer::Truncate() - Larger than data size");
+			m_dataSize = size;
+		}
+
 		u32 Buffer::GetReservedSize() const
 		{
 			return m_reservedSize;
@@ -30,6 +30,9 @@ namespace ion
 			void Clear();
 			void Reset();
 
+			//Shrink data to size, keeping its contents
+			void Truncate(u32 size);
+
 			u32 GetReservedSize() const;
 			virtual u32 GetDataSize() const;
 
@@ -7,7 +7,8 @@ namespace ion
 		enum class DataFormat
 		{
 			PCM8,
-			PCM16
+			PCM16,
+			Vorbis
 		};
 	}
 }
\ No newline at end of file
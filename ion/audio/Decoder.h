@@ -0,0 +1,35 @@
+#pragma once
+
+#include <core/Types.h>
+
+namespace ion
+{
+	namespace audio
+	{
+		//Decodes packets of a compressed stream to interleaved PCM16. The container (e.g. FileReaderOGG)
+		//splits the stream into packets, handles seeking, and tells the decoder when the stream is discontinuous.
+		class Decoder
+		{
+		public:
+			virtual ~Decoder() {}
+
+			//Stream setup packets, in order. Returns false if the stream isn't supported.
+			virtual bool DecodeHeader(const u8* data, u32 size) = 0;
+
+			//All setup packets have been decoded
+			virtual bool IsReady() const = 0;
+
+			virtual u32 GetNumChannels() const = 0;
+			virtual u32 GetSampleRate() const = 0;
+
+			//Most frames one packet can produce
+			virtual u32 GetMaxPacketFrames() const = 0;
+
+			//Decode one audio packet into output (room for GetMaxPacketFrames()), returns frames written
+			virtual u32 DecodePacket(const u8* data, u32 size, s16* output) = 0;
+
+			//Discard state carried between packets, after a seek
+			virtual void Reset() = 0;
+		};
+	}
+}
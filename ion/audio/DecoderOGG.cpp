@@ -0,0 +1,1419 @@
+#include "DecoderOGG.h"
+
+#include <core/debug/Debug.h>
+#include <core/memory/Memory.h>
+#include <maths/Maths.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ion
+{
+	namespace audio
+	{
+		static const float s_pi = 3.14159265358979323846f;
+
+		//Floor 1 amplitude ranges, by multiplier
+		static const u32 s_floor1Ranges[4] = { 256, 128, 86, 64 };
+
+		//Floor 1 decibel steps, 0 is -140dB, 255 is 0dB
+		static float s_floor1InverseDB[256];
+		static bool s_floor1InverseDBInitialised = false;
+
+		static u32 ILog(u32 value)
+		{
+			u32 bits = 0;
+			while (value)
+			{
+				bits++;
+				value >>= 1;
+			}
+
+			return bits;
+		}
+
+		static u32 BitReverse(u32 value, u32 numBits)
+		{
+			u32 reversed = 0;
+			for (u32 i = 0; i < numBits; i++)
+			{
+				reversed = (reversed << 1) | (value & 1);
+				value >>= 1;
+			}
+
+			return reversed;
+		}
+
+		static float Float32Unpack(u32 value)
+		{
+			double mantissa = (double)(value & 0x1fffff);
+			int exponent = (int)((value & 0x7fe00000) >> 21);
+
+			if (value & 0x80000000)
+				mantissa = -mantissa;
+
+			return (float)ldexp(mantissa, exponent - 788);
+		}
+
+		//Largest r where r^dimensions <= numEntries
+		static u32 Lookup1Values(u32 numEntries, u32 dimensions)
+		{
+			u32 r = (u32)floor(pow((double)numEntries, 1.0 / (double)dimensions));
+
+			while (pow((double)(r + 1), (double)dimensions) <= (double)numEntries)
+				r++;
+			while (r > 0 && pow((double)r, (double)dimensions) > (double)numEntries)
+				r--;
+
+			return r;
+		}
+
+		//LSB first bit reader over one packet. Reading past the end returns zeros and flags end of packet.
+		class DecoderOGG::BitReader
+		{
+		public:
+			BitReader(const u8* data, u32 size)
+				: m_data(data)
+				, m_size(size)
+				, m_bytePos(0)
+				, m_bits(0)
+				, m_numBits(0)
+				, m_endOfPacket(false)
+			{
+			}
+
+			u32 Read(u32 numBits)
+			{
+				if (numBits == 0)
+					return 0;
+
+				Refill();
+
+				u32 value = (u32)(m_bits & ((1ull << numBits) - 1));
+
+				if (numBits > m_numBits)
+				{
+					m_endOfPacket = true;
+					m_numBits = 0;
+					m_bits = 0;
+				}
+				else
+				{
+					m_bits >>= numBits;
+					m_numBits -= numBits;
+				}
+
+				return value;
+			}
+
+			u32 Peek(u32 numBits)
+			{
+				Refill();
+				return (u32)(m_bits & ((1ull << numBits) - 1));
+			}
+
+			void Skip(u32 numBits)
+			{
+				Read(numBits);
+			}
+
+			bool ReadFlag()
+			{
+				return Read(1) != 0;
+			}
+
+			bool IsEndOfPacket() const
+			{
+				return m_endOfPacket;
+			}
+
+		private:
+			void Refill()
+			{
+				while (m_numBits <= 56 && m_bytePos < m_size)
+				{
+					m_bits |= (u64)m_data[m_bytePos++] << m_numBits;
+					m_numBits += 8;
+				}
+			}
+
+			const u8* m_data;
+			u32 m_size;
+			u32 m_bytePos;
+			u64 m_bits;
+			u32 m_numBits;
+			bool m_endOfPacket;
+		};
+
+		DecoderOGG::DecoderOGG()
+		{
+			if (!s_floor1InverseDBInitialised)
+			{
+				//Geometric from 1.0649863e-07 to 1.0, as the specification's table
+				for (int i = 0; i < 256; i++)
+				{
+					s_floor1InverseDB[i] = (float)exp(log(1.0649863e-07) * (double)(255 - i) / 255.0);
+				}
+
+				s_floor1InverseDBInitialised = true;
+			}
+
+			m_numHeaders = 0;
+			m_numChannels = 0;
+			m_sampleRate = 0;
+			m_blockSizes[0] = 0;
+			m_blockSizes[1] = 0;
+			m_havePrevious = false;
+			m_prevRightStart = 0;
+			m_prevRightEnd = 0;
+		}
+
+		DecoderOGG::~DecoderOGG()
+		{
+		}
+
+		bool DecoderOGG::IsReady() const
+		{
+			return m_numHeaders == 3;
+		}
+
+		u32 DecoderOGG::GetNumChannels() const
+		{
+			return m_numChannels;
+		}
+
+		u32 DecoderOGG::GetSampleRate() const
+		{
+			return m_sampleRate;
+		}
+
+		u32 DecoderOGG::GetMaxPacketFrames() const
+		{
+			//Long block following a long block
+			return m_blockSizes[1] / 2;
+		}
+
+		void DecoderOGG::Reset()
+		{
+			m_havePrevious = false;
+		}
+
+		bool DecoderOGG::DecodeHeader(const u8* data, u32 size)
+		{
+			static const u8 s_headerTypes[3] = { 1, 3, 5 };
+
+			//Packet type, then "vorbis"
+			if (m_numHeaders >= 3 || size < 7 || data[0] != s_headerTypes[m_numHeaders] || memcmp(data + 1, "vorbis", 6) != 0)
+			{
+				debug::log << "DecoderOGG::DecodeHeader() - Not a Vorbis header packet" << debug::end;
+				return false;
+			}
+
+			BitReader reader(data + 7, size - 7);
+			bool result = true;
+
+			switch (m_numHeaders)
+			{
+			case 0:
+				result = DecodeIdentificationHeader(reader);
+				break;
+			case 1:
+				//Comments aren't used
+				break;
+			case 2:
+				result = DecodeSetupHeader(reader);
+				break;
+			}
+
+			if (result)
+			{
+				m_numHeaders++;
+			}
+
+			return result;
+		}
+
+		bool DecoderOGG::DecodeIdentificationHeader(BitReader& reader)
+		{
+			u32 version = reader.Read(32);
+			m_numChannels = reader.Read(8);
+			m_sampleRate = reader.Read(32);
+			reader.Read(32);	//Bitrate maximum
+			reader.Read(32);	//Bitrate nominal
+			reader.Read(32);	//Bitrate minimum
+			u32 blockSize0 = reader.Read(4);
+			u32 blockSize1 = reader.Read(4);
+			bool framing = reader.ReadFlag();
+
+			if (version != 0 || m_numChannels == 0 || m_sampleRate == 0 || !framing)
+			{
+				debug::log << "DecoderOGG::DecodeIdentificationHeader() - Bad identification header" << debug::end;
+				return false;
+			}
+
+			if (m_numChannels > s_maxChannels)
+			{
+				debug::log << "DecoderOGG::DecodeIdentificationHeader() - " << m_numChannels << " channels not supported" << debug::end;
+				return false;
+			}
+
+			if (blockSize0 < 6 || blockSize0 > 13 || blockSize1 < 6 || blockSize1 > 13 || blockSize0 > blockSize1)
+			{
+				debug::log << "DecoderOGG::DecodeIdentificationHeader() - Bad block sizes" << debug::end;
+				return false;
+			}
+
+			m_blockSizes[0] = 1 << blockSize0;
+			m_blockSizes[1] = 1 << blockSize1;
+
+			for (u32 i = 0; i < m_numChannels; i++)
+			{
+				m_spectra[i].resize(m_blockSizes[1] / 2);
+				m_blocks[i].resize(m_blockSizes[1]);
+				m_overlap[i].resize(m_blockSizes[1] / 2);
+			}
+
+			InitTransform(m_transforms[0], m_blockSizes[0]);
+			InitTransform(m_transforms[1], m_blockSizes[1]);
+			m_fftBuffer.resize(m_blockSizes[1] / 2);
+			m_interleaved.resize((m_blockSizes[1] / 2) * m_numChannels);
+
+			return true;
+		}
+
+		bool DecoderOGG::DecodeSetupHeader(BitReader& reader)
+		{
+			//Codebooks
+			m_codebooks.resize(reader.Read(8) + 1);
+			for (int i = 0; i < m_codebooks.size(); i++)
+			{
+				if (!DecodeCodebook(reader, m_codebooks[i]))
+					return false;
+			}
+
+			//Time domain transforms, placeholders
+			u32 numTimeTransforms = reader.Read(6) + 1;
+			for (u32 i = 0; i < numTimeTransforms; i++)
+			{
+				if (reader.Read(16) != 0)
+				{
+					debug::log << "DecoderOGG::DecodeSetupHeader() - Bad time domain transform" << debug::end;
+					return false;
+				}
+			}
+
+			//Floors
+			m_floors.resize(reader.Read(6) + 1);
+			for (int i = 0; i < m_floors.size(); i++)
+			{
+				if (!DecodeFloor(reader, m_floors[i]))
+					return false;
+			}
+
+			//Residues
+			m_residues.resize(reader.Read(6) + 1);
+			for (int i = 0; i < m_residues.size(); i++)
+			{
+				if (!DecodeResidue(reader, m_residues[i]))
+					return false;
+			}
+
+			//Mappings
+			m_mappings.resize(reader.Read(6) + 1);
+			for (int i = 0; i < m_mappings.size(); i++)
+			{
+				if (!DecodeMapping(reader, m_mappings[i]))
+					return false;
+			}
+
+			//Modes
+			m_modes.resize(reader.Read(6) + 1);
+			for (int i = 0; i < m_modes.size(); i++)
+			{
+				m_modes[i].blockFlag = reader.Read(1);
+				u32 windowType = reader.Read(16);
+				u32 transformType = reader.Read(16);
+				m_modes[i].mapping = reader.Read(8);
+
+				if (windowType != 0 || transformType != 0 || m_modes[i].mapping >= m_mappings.size())
+				{
+					debug::log << "DecoderOGG::DecodeSetupHeader() - Bad mode" << debug::end;
+					return false;
+				}
+			}
+
+			if (!reader.ReadFlag() || reader.IsEndOfPacket())
+			{
+				debug::log << "DecoderOGG::DecodeSetupHeader() - Bad framing" << debug::end;
+				return false;
+			}
+
+			return true;
+		}
+
+		bool DecoderOGG::DecodeCodebook(BitReader& reader, Codebook& codebook)
+		{
+			if (reader.Read(24) != 0x564342)
+			{
+				debug::log << "DecoderOGG::DecodeCodebook() - Bad sync pattern" << debug::end;
+				return false;
+			}
+
+			codebook.dimensions = reader.Read(16);
+			codebook.numEntries = reader.Read(24);
+
+			std::vector<u8> lengths(codebook.numEntries, 0);
+
+			if (reader.ReadFlag())
+			{
+				//Ordered, runs of entries with increasing lengths
+				u32 entry = 0;
+				u32 length = reader.Read(5) + 1;
+
+				while (entry < codebook.numEntries)
+				{
+					u32 count = reader.Read(ILog(codebook.numEntries - entry));
+					if (entry + count > codebook.numEntries || length > 32)
+					{
+						debug::log << "DecoderOGG::DecodeCodebook() - Bad ordered lengths" << debug::end;
+						return false;
+					}
+
+					memory::MemSet(lengths.data() + entry, length, count);
+					entry += count;
+					length++;
+				}
+			}
+			else
+			{
+				bool sparse = reader.ReadFlag();
+
+				for (u32 i = 0; i < codebook.numEntries; i++)
+				{
+					if (!sparse || reader.ReadFlag())
+					{
+						lengths[i] = reader.Read(5) + 1;
+					}
+				}
+			}
+
+			//Assign canonical codewords in entry order, each taking the lowest free code of its length
+			u32 marker[33] = { 0 };
+			std::vector<Codebook::LongCode> codes;
+
+			for (u32 i = 0; i < codebook.numEntries; i++)
+			{
+				u32 length = lengths[i];
+				if (length == 0)
+					continue;
+
+				u32 codeword = marker[length];
+				if (length < 32 && (codeword >> length))
+				{
+					debug::log << "DecoderOGG::DecodeCodebook() - Overspecified Huffman tree" << debug::end;
+					return false;
+				}
+
+				//Step past this code, then move longer markers off its branch
+				for (u32 j = length; j > 0; j--)
+				{
+					if (marker[j] & 1)
+					{
+						marker[j] = (j == 1) ? marker[1] + 1 : marker[j - 1] << 1;
+						break;
+					}
+
+					marker[j]++;
+				}
+
+				u32 branch = codeword;
+				for (u32 j = length + 1; j < 33 && (marker[j] >> 1) == branch; j++)
+				{
+					branch = marker[j];
+					marker[j] = marker[j - 1] << 1;
+				}
+
+				Codebook::LongCode code;
+				code.codeword = BitReverse(codeword, length);
+				code.length = length;
+				code.entry = i;
+				codes.push_back(code);
+			}
+
+			const u32 numUsed = (u32)codes.size();
+
+			//Fast table for short codes, long codes sorted by their table prefix
+			const u32 fastSize = 1 << s_fastBits;
+			const u32 fastMask = fastSize - 1;
+
+			Codebook::FastEntry invalid = { -1, 0 };
+			codebook.fastTable.assign(fastSize, invalid);
+			codebook.longCodes.clear();
+
+			for (int i = 0; i < codes.size(); i++)
+			{
+				const Codebook::LongCode& code = codes[i];
+
+				if (numUsed == 1)
+				{
+					//Single entry books consume their length whatever the bits
+					for (u32 slot = 0; slot < fastSize; slot++)
+					{
+						codebook.fastTable[slot].entry = code.entry;
+						codebook.fastTable[slot].length = maths::Max(code.length, 1u);
+					}
+				}
+				else if (code.length <= s_fastBits)
+				{
+					for (u32 slot = code.codeword; slot < fastSize; slot += (1 << code.length))
+					{
+						codebook.fastTable[slot].entry = code.entry;
+						codebook.fastTable[slot].length = code.length;
+					}
+				}
+				else
+				{
+					codebook.longCodes.push_back(code);
+				}
+			}
+
+			std::sort(codebook.longCodes.begin(), codebook.longCodes.end(), [fastMask](const Codebook::LongCode& a, const Codebook::LongCode& b)
+			{
+				return (a.codeword & fastMask) < (b.codeword & fastMask);
+			});
+
+			for (int i = (int)codebook.longCodes.size() - 1; i >= 0; i--)
+			{
+				codebook.fastTable[codebook.longCodes[i].codeword & fastMask].entry = i;
+			}
+
+			//Vector lookup
+			u32 lookupType = reader.Read(4);
+
+			if (lookupType == 1 || lookupType == 2)
+			{
+				float minimum = Float32Unpack(reader.Read(32));
+				float delta = Float32Unpack(reader.Read(32));
+				u32 valueBits = reader.Read(4) + 1;
+				bool sequence = reader.ReadFlag();
+
+				u32 numValues = (lookupType == 1) ? Lookup1Values(codebook.numEntries, codebook.dimensions) : codebook.numEntries * codebook.dimensions;
+
+				std::vector<u32> multiplicands(numValues);
+				for (u32 i = 0; i < numValues; i++)
+				{
+					multiplicands[i] = reader.Read(valueBits);
+				}
+
+				codebook.vectors.resize(codebook.numEntries * codebook.dimensions);
+
+				for (u32 entry = 0; entry < codebook.numEntries; entry++)
+				{
+					float last = 0.0f;
+					u32 indexDivisor = 1;
+
+					for (u32 i = 0; i < codebook.dimensions; i++)
+					{
+						u32 index = (lookupType == 1) ? ((entry / indexDivisor) % numValues) : ((entry * codebook.dimensions) + i);
+						float value = ((float)multiplicands[index] * delta) + minimum + last;
+
+						if (sequence)
+							last = value;
+
+						codebook.vectors[(entry * codebook.dimensions) + i] = value;
+						indexDivisor *= numValues;
+					}
+				}
+			}
+			else if (lookupType != 0)
+			{
+				debug::log << "DecoderOGG::DecodeCodebook() - Bad lookup type" << debug::end;
+				return false;
+			}
+
+			return !reader.IsEndOfPacket();
+		}
+
+		bool DecoderOGG::DecodeFloor(BitReader& reader, Floor& floor)
+		{
+			u32 floorType = reader.Read(16);
+
+			if (floorType != 1)
+			{
+				debug::log << "DecoderOGG::DecodeFloor() - Floor type " << floorType << " not supported" << debug::end;
+				return false;
+			}
+
+			floor.numPartitions = reader.Read(5);
+
+			int numClasses = 0;
+			for (u32 i = 0; i < floor.numPartitions; i++)
+			{
+				floor.partitionClasses[i] = reader.Read(4);
+				numClasses = maths::Max(numClasses, (int)floor.partitionClasses[i] + 1);
+			}
+
+			for (int i = 0; i < numClasses; i++)
+			{
+				floor.classDimensions[i] = reader.Read(3) + 1;
+				floor.classSubclasses[i] = reader.Read(2);
+				floor.classMasterbooks[i] = floor.classSubclasses[i] ? reader.Read(8) : -1;
+
+				for (int j = 0; j < (1 << floor.classSubclasses[i]); j++)
+				{
+					floor.subclassBooks[i][j] = (s16)reader.Read(8) - 1;
+				}
+			}
+
+			floor.multiplier = reader.Read(2) + 1;
+			u32 rangeBits = reader.Read(4);
+
+			floor.x[0] = 0;
+			floor.x[1] = 1 << rangeBits;
+			floor.numValues = 2;
+
+			for (u32 i = 0; i < floor.numPartitions; i++)
+			{
+				u32 classIdx = floor.partitionClasses[i];
+
+				for (u32 j = 0; j < floor.classDimensions[classIdx]; j++)
+				{
+					if (floor.numValues >= s_maxFloorValues)
+					{
+						debug::log << "DecoderOGG::DecodeFloor() - Too many floor values" << debug::end;
+						return false;
+					}
+
+					floor.x[floor.numValues++] = reader.Read(rangeBits);
+				}
+			}
+
+			//Render order
+			for (u32 i = 0; i < floor.numValues; i++)
+			{
+				floor.sortedOrder[i] = i;
+			}
+
+			std::sort(floor.sortedOrder, floor.sortedOrder + floor.numValues, [&floor](u8 a, u8 b) { return floor.x[a] < floor.x[b]; });
+
+			//Nearest lower and higher x among earlier values
+			for (u32 i = 2; i < floor.numValues; i++)
+			{
+				int low = 0;
+				int high = 1;
+				int lowX = -1;
+				int highX = 0x10000;
+
+				for (u32 j = 0; j < i; j++)
+				{
+					if (floor.x[j] > lowX && floor.x[j] < floor.x[i])
+					{
+						low = j;
+						lowX = floor.x[j];
+					}
+
+					if (floor.x[j] < highX && floor.x[j] > floor.x[i])
+					{
+						high = j;
+						highX = floor.x[j];
+					}
+				}
+
+				floor.lowNeighbour[i] = low;
+				floor.highNeighbour[i] = high;
+			}
+
+			for (int i = 0; i < numClasses; i++)
+			{
+				if (floor.classMasterbooks[i] >= (int)m_codebooks.size())
+					return false;
+
+				for (int j = 0; j < (1 << floor.classSubclasses[i]); j++)
+				{
+					if (floor.subclassBooks[i][j] >= (int)m_codebooks.size())
+						return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool DecoderOGG::DecodeResidue(BitReader& reader, Residue& residue)
+		{
+			residue.type = reader.Read(16);
+			residue.begin = reader.Read(24);
+			residue.end = reader.Read(24);
+			residue.partitionSize = reader.Read(24) + 1;
+			residue.numClassifications = reader.Read(6) + 1;
+			residue.classbook = reader.Read(8);
+
+			if (residue.type > 2 || residue.classbook >= m_codebooks.size())
+			{
+				debug::log << "DecoderOGG::DecodeResidue() - Bad residue" << debug::end;
+				return false;
+			}
+
+			u8 cascade[64];
+			for (u32 i = 0; i < residue.numClassifications; i++)
+			{
+				u32 lowBits = reader.Read(3);
+				u32 highBits = reader.ReadFlag() ? reader.Read(5) : 0;
+				cascade[i] = (highBits << 3) | lowBits;
+			}
+
+			for (u32 i = 0; i < residue.numClassifications; i++)
+			{
+				for (int pass = 0; pass < 8; pass++)
+				{
+					residue.books[i][pass] = (cascade[i] & (1 << pass)) ? reader.Read(8) : -1;
+
+					if (residue.books[i][pass] >= (int)m_codebooks.size() || (residue.books[i][pass] >= 0 && m_codebooks[residue.books[i][pass]].vectors.empty()))
+					{
+						debug::log << "DecoderOGG::DecodeResidue() - Bad residue book" << debug::end;
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		bool DecoderOGG::DecodeMapping(BitReader& reader, Mapping& mapping)
+		{
+			if (reader.Read(16) != 0)
+			{
+				debug::log << "DecoderOGG::DecodeMapping() - Bad mapping type" << debug::end;
+				return false;
+			}
+
+			mapping.numSubmaps = reader.ReadFlag() ? reader.Read(4) + 1 : 1;
+			mapping.numCouplingSteps = reader.ReadFlag() ? reader.Read(8) + 1 : 0;
+
+			u32 channelBits = ILog(m_numChannels - 1);
+
+			for (u32 i = 0; i < mapping.numCouplingSteps; i++)
+			{
+				mapping.magnitude[i] = reader.Read(channelBits);
+				mapping.angle[i] = reader.Read(channelBits);
+
+				if (mapping.magnitude[i] == mapping.angle[i] || mapping.magnitude[i] >= m_numChannels || mapping.angle[i] >= m_numChannels)
+				{
+					debug::log << "DecoderOGG::DecodeMapping() - Bad channel coupling" << debug::end;
+					return false;
+				}
+			}
+
+			if (reader.Read(2) != 0)
+			{
+				debug::log << "DecoderOGG::DecodeMapping() - Bad reserved field" << debug::end;
+				return false;
+			}
+
+			for (u32 i = 0; i < m_numChannels; i++)
+			{
+				mapping.mux[i] = (mapping.numSubmaps > 1) ? reader.Read(4) : 0;
+
+				if (mapping.mux[i] >= mapping.numSubmaps)
+					return false;
+			}
+
+			for (u32 i = 0; i < mapping.numSubmaps; i++)
+			{
+				reader.Read(8);	//Unused time configuration
+				mapping.submapFloor[i] = reader.Read(8);
+				mapping.submapResidue[i] = reader.Read(8);
+
+				if (mapping.submapFloor[i] >= m_floors.size() || mapping.submapResidue[i] >= m_residues.size())
+				{
+					debug::log << "DecoderOGG::DecodeMapping() - Bad submap" << debug::end;
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		void DecoderOGG::InitTransform(Transform& transform, u32 size)
+		{
+			transform.size = size;
+
+			//Vorbis power sine window, rising half
+			u32 halfSize = size / 2;
+			transform.window.resize(halfSize);
+			for (u32 i = 0; i < halfSize; i++)
+			{
+				double s = sin((((double)i + 0.5) / (double)halfSize) * (s_pi / 2.0));
+				transform.window[i] = (float)sin((s_pi / 2.0) * s * s);
+			}
+
+			//DCT-IV of size N/2 through a complex FFT of size N/4. Pre-rotation e^(-i*pi*(4k+1)/(4*N/2)),
+			//post-rotation e^(-i*pi*k/(N/2)), interleaved per k.
+			u32 dctSize = size / 2;
+			u32 fftSize = size / 4;
+
+			transform.twiddle.resize(fftSize * 4);
+			for (u32 k = 0; k < fftSize; k++)
+			{
+				double preAngle = -s_pi * ((4.0 * k) + 1.0) / (4.0 * dctSize);
+				double postAngle = -s_pi * (double)k / (double)dctSize;
+				transform.twiddle[(k * 4)] = (float)cos(preAngle);
+				transform.twiddle[(k * 4) + 1] = (float)sin(preAngle);
+				transform.twiddle[(k * 4) + 2] = (float)cos(postAngle);
+				transform.twiddle[(k * 4) + 3] = (float)sin(postAngle);
+			}
+
+			transform.fftTwiddle.resize(fftSize);
+			for (u32 k = 0; k < fftSize / 2; k++)
+			{
+				double angle = -2.0 * s_pi * (double)k / (double)fftSize;
+				transform.fftTwiddle[(k * 2)] = (float)cos(angle);
+				transform.fftTwiddle[(k * 2) + 1] = (float)sin(angle);
+			}
+
+			u32 fftBits = ILog(fftSize) - 1;
+			transform.bitReverse.resize(fftSize);
+			for (u32 k = 0; k < fftSize; k++)
+			{
+				transform.bitReverse[k] = BitReverse(k, fftBits);
+			}
+		}
+
+		s32 DecoderOGG::DecodeScalar(BitReader& reader, const Codebook& codebook) const
+		{
+			const u32 fastMask = (1 << s_fastBits) - 1;
+
+			u32 bits = reader.Peek(s_fastBits);
+			const Codebook::FastEntry& fastEntry = codebook.fastTable[bits];
+
+			if (fastEntry.length > 0)
+			{
+				reader.Skip(fastEntry.length);
+				return fastEntry.entry;
+			}
+
+			if (fastEntry.entry >= 0)
+			{
+				//Long code, scan those sharing this prefix
+				u32 peeked = reader.Peek(32);
+
+				for (u32 i = fastEntry.entry; i < codebook.longCodes.size() && (codebook.longCodes[i].codeword & fastMask) == bits; i++)
+				{
+					const Codebook::LongCode& code = codebook.longCodes[i];
+					u32 mask = (code.length < 32) ? ((1u << code.length) - 1) : 0xffffffff;
+
+					if ((peeked & mask) == code.codeword)
+					{
+						reader.Skip(code.length);
+						return code.entry;
+					}
+				}
+			}
+
+			//Invalid code, or ran out of packet
+			reader.Skip(32);
+			return -1;
+		}
+
+		const float* DecoderOGG::DecodeVector(BitReader& reader, const Codebook& codebook) const
+		{
+			s32 entry = DecodeScalar(reader, codebook);
+			return (entry >= 0 && !reader.IsEndOfPacket()) ? &codebook.vectors[entry * codebook.dimensions] : nullptr;
+		}
+
+		u32 DecoderOGG::GetPacketBlockSize(const u8* data, u32 size) const
+		{
+			if (!IsReady() || size == 0 || (data[0] & 1))
+				return 0;
+
+			BitReader reader(data, size);
+			reader.Read(1);
+			u32 modeIdx = reader.Read(ILog((u32)m_modes.size() - 1));
+
+			return (modeIdx < m_modes.size()) ? m_blockSizes[m_modes[modeIdx].blockFlag] : 0;
+		}
+
+		bool DecoderOGG::DecodeFloorCurve(BitReader& reader, const Floor& floor, s32* values) const
+		{
+			if (!reader.ReadFlag())
+				return false;
+
+			u32 range = s_floor1Ranges[floor.multiplier - 1];
+			u32 rangeBits = ILog(range - 1);
+
+			values[0] = reader.Read(rangeBits);
+			values[1] = reader.Read(rangeBits);
+
+			u32 offset = 2;
+
+			for (u32 i = 0; i < floor.numPartitions; i++)
+			{
+				u32 classIdx = floor.partitionClasses[i];
+				u32 dimensions = floor.classDimensions[classIdx];
+				u32 subclassBits = floor.classSubclasses[classIdx];
+				u32 subclassMask = (1 << subclassBits) - 1;
+				u32 classValue = 0;
+
+				if (subclassBits > 0)
+				{
+					s32 entry = DecodeScalar(reader, m_codebooks[floor.classMasterbooks[classIdx]]);
+					classValue = (entry >= 0) ? entry : 0;
+				}
+
+				for (u32 j = 0; j < dimensions; j++)
+				{
+					s32 book = floor.subclassBooks[classIdx][classValue & subclassMask];
+					classValue >>= subclassBits;
+
+					if (book >= 0)
+					{
+						s32 entry = DecodeScalar(reader, m_codebooks[book]);
+						values[offset + j] = (entry >= 0) ? entry : 0;
+					}
+					else
+					{
+						values[offset + j] = 0;
+					}
+				}
+
+				offset += dimensions;
+			}
+
+			//Packet ended mid floor, channel is silent
+			return !reader.IsEndOfPacket();
+		}
+
+		static s32 RenderPoint(s32 x0, s32 y0, s32 x1, s32 y1, s32 x)
+		{
+			s32 dy = y1 - y0;
+			s32 adx = x1 - x0;
+			s32 err = abs(dy) * (x - x0);
+			s32 off = err / adx;
+			return (dy < 0) ? (y0 - off) : (y0 + off);
+		}
+
+		static void RenderLine(s32 x0, s32 y0, s32 x1, s32 y1, s32 n, float* spectrum, const float* inverseDB)
+		{
+			s32 dy = y1 - y0;
+			s32 adx = x1 - x0;
+			s32 base = dy / adx;
+			s32 sy = (dy < 0) ? (base - 1) : (base + 1);
+			s32 ady = abs(dy) - (abs(base) * adx);
+			s32 y = y0;
+			s32 err = 0;
+			s32 end = maths::Min(x1, n);
+
+			if (x0 < end)
+			{
+				spectrum[x0] *= inverseDB[maths::Clamp(y, 0, 255)];
+			}
+
+			for (s32 x = x0 + 1; x < end; x++)
+			{
+				err += ady;
+				if (err >= adx)
+				{
+					err -= adx;
+					y += sy;
+				}
+				else
+				{
+					y += base;
+				}
+
+				spectrum[x] *= inverseDB[maths::Clamp(y, 0, 255)];
+			}
+		}
+
+		void DecoderOGG::RenderFloorCurve(const Floor& floor, const s32* values, u32 n, float* spectrum) const
+		{
+			//Amplitude synthesis, values are offsets from the line between neighbours
+			s32 finalY[s_maxFloorValues];
+			bool step2[s_maxFloorValues];
+
+			s32 range = s_floor1Ranges[floor.multiplier - 1];
+
+			finalY[0] = values[0];
+			finalY[1] = values[1];
+			step2[0] = true;
+			step2[1] = true;
+
+			for (u32 i = 2; i < floor.numValues; i++)
+			{
+				u32 low = floor.lowNeighbour[i];
+				u32 high = floor.highNeighbour[i];
+				s32 predicted = RenderPoint(floor.x[low], finalY[low], floor.x[high], finalY[high], floor.x[i]);
+				s32 value = values[i];
+				s32 highRoom = range - predicted;
+				s32 lowRoom = predicted;
+				s32 room = ((highRoom < lowRoom) ? highRoom : lowRoom) * 2;
+
+				if (value != 0)
+				{
+					step2[low] = true;
+					step2[high] = true;
+					step2[i] = true;
+
+					if (value >= room)
+					{
+						finalY[i] = (highRoom > lowRoom) ? (value - lowRoom + predicted) : (predicted - value + highRoom - 1);
+					}
+					else
+					{
+						finalY[i] = (value & 1) ? (predicted - ((value + 1) >> 1)) : (predicted + (value >> 1));
+					}
+				}
+				else
+				{
+					step2[i] = false;
+					finalY[i] = predicted;
+				}
+			}
+
+			//Curve through used points, applied straight to spectrum
+			s32 lx = 0;
+			s32 ly = finalY[floor.sortedOrder[0]] * floor.multiplier;
+			s32 hx = 0;
+			s32 hy = 0;
+
+			for (u32 i = 1; i < floor.numValues; i++)
+			{
+				u32 j = floor.sortedOrder[i];
+
+				if (step2[j])
+				{
+					hy = finalY[j] * floor.multiplier;
+					hx = floor.x[j];
+					RenderLine(lx, ly, hx, hy, n, spectrum, s_floor1InverseDB);
+					lx = hx;
+					ly = hy;
+				}
+			}
+
+			if (hx < (s32)n)
+			{
+				RenderLine(hx, hy, n, hy, n, spectrum, s_floor1InverseDB);
+			}
+		}
+
+		void DecoderOGG::DecodeResidueVectors(BitReader& reader, const Residue& residue, float** vectors, const bool* doNotDecode, u32 numVectors, u32 n)
+		{
+			const Codebook& classbook = m_codebooks[residue.classbook];
+			u32 classWordsPerCodeword = classbook.dimensions;
+
+			u32 limitBegin = maths::Min(residue.begin, n);
+			u32 limitEnd = maths::Min(residue.end, n);
+			u32 numPartitions = (limitEnd > limitBegin) ? ((limitEnd - limitBegin) / residue.partitionSize) : 0;
+
+			if (numPartitions == 0)
+				return;
+
+			//Classification per vector per partition
+			u32 classificationsSize = numVectors * (numPartitions + classWordsPerCodeword);
+			if (m_classifications.size() < classificationsSize)
+				m_classifications.resize(classificationsSize);
+
+			u8* classifications = m_classifications.data();
+			u32 classificationStride = numPartitions + classWordsPerCodeword;
+
+			for (int pass = 0; pass < 8; pass++)
+			{
+				u32 partition = 0;
+
+				while (partition < numPartitions)
+				{
+					if (pass == 0)
+					{
+						for (u32 j = 0; j < numVectors; j++)
+						{
+							if (doNotDecode[j])
+								continue;
+
+							s32 entry = DecodeScalar(reader, classbook);
+							if (entry < 0 || reader.IsEndOfPacket())
+								return;
+
+							for (int i = (int)classWordsPerCodeword - 1; i >= 0; i--)
+							{
+								classifications[(j * classificationStride) + partition + i] = entry % residue.numClassifications;
+								entry /= residue.numClassifications;
+							}
+						}
+					}
+
+					for (u32 i = 0; i < classWordsPerCodeword && partition < numPartitions; i++, partition++)
+					{
+						for (u32 j = 0; j < numVectors; j++)
+						{
+							if (doNotDecode[j])
+								continue;
+
+							s32 book = residue.books[classifications[(j * classificationStride) + partition]][pass];
+							if (book < 0)
+								continue;
+
+							const Codebook& codebook = m_codebooks[book];
+							u32 dimensions = codebook.dimensions;
+							u32 offset = limitBegin + (partition * residue.partitionSize);
+							float* vector = vectors[j] + offset;
+
+							if (residue.type == 0)
+							{
+								//Interleaved by step
+								u32 step = residue.partitionSize / dimensions;
+
+								for (u32 k = 0; k < step; k++)
+								{
+									const float* values = DecodeVector(reader, codebook);
+									if (!values)
+										return;
+
+									for (u32 d = 0; d < dimensions; d++)
+									{
+										vector[k + (d * step)] += values[d];
+									}
+								}
+							}
+							else
+							{
+								//Consecutive
+								for (u32 k = 0; k < residue.partitionSize; k += dimensions)
+								{
+									const float* values = DecodeVector(reader, codebook);
+									if (!values)
+										return;
+
+									for (u32 d = 0; d < dimensions && (k + d) < residue.partitionSize; d++)
+									{
+										vector[k + d] += values[d];
+									}
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+
+		void DecoderOGG::InverseMDCT(const Transform& transform, float* spectrum, float* output)
+		{
+			const u32 n = transform.size;
+			const u32 dctSize = n / 2;
+			const u32 fftSize = n / 4;
+			float* fft = m_fftBuffer.data();
+
+			//Pack pairs into complex values, rotate, store bit reversed for FFT
+			for (u32 k = 0; k < fftSize; k++)
+			{
+				float re = spectrum[k * 2];
+				float im = spectrum[dctSize - 1 - (k * 2)];
+				float twRe = transform.twiddle[(k * 4)];
+				float twIm = transform.twiddle[(k * 4) + 1];
+				u32 dest = transform.bitReverse[k] * 2;
+				fft[dest] = (re * twRe) - (im * twIm);
+				fft[dest + 1] = (re * twIm) + (im * twRe);
+			}
+
+			//Radix 2 FFT
+			for (u32 span = 1; span < fftSize; span <<= 1)
+			{
+				u32 twiddleStep = fftSize / (span * 2);
+
+				for (u32 start = 0; start < fftSize; start += span * 2)
+				{
+					for (u32 k = 0; k < span; k++)
+					{
+						float twRe = transform.fftTwiddle[(k * twiddleStep) * 2];
+						float twIm = transform.fftTwiddle[((k * twiddleStep) * 2) + 1];
+
+						float* a = fft + ((start + k) * 2);
+						float* b = fft + ((start + k + span) * 2);
+
+						float bRe = (b[0] * twRe) - (b[1] * twIm);
+						float bIm = (b[0] * twIm) + (b[1] * twRe);
+
+						b[0] = a[0] - bRe;
+						b[1] = a[1] - bIm;
+						a[0] += bRe;
+						a[1] += bIm;
+					}
+				}
+			}
+
+			//Rotate back, unpack DCT-IV into spectrum
+			for (u32 k = 0; k < fftSize; k++)
+			{
+				float re = fft[k * 2];
+				float im = fft[(k * 2) + 1];
+				float twRe = transform.twiddle[(k * 4) + 2];
+				float twIm = transform.twiddle[(k * 4) + 3];
+				spectrum[k * 2] = (re * twRe) - (im * twIm);
+				spectrum[dctSize - 1 - (k * 2)] = -((re * twIm) + (im * twRe));
+			}
+
+			//Unfold DCT-IV to MDCT output, with its odd/even symmetry
+			const u32 quarter = n / 4;
+
+			for (u32 i = 0; i < quarter; i++)
+			{
+				output[i] = spectrum[quarter + i];
+			}
+
+			for (u32 i = quarter; i < quarter * 3; i++)
+			{
+				output[i] = -spectrum[(quarter * 3) - 1 - i];
+			}
+
+			for (u32 i = quarter * 3; i < n; i++)
+			{
+				output[i] = -spectrum[i - (quarter * 3)];
+			}
+		}
+
+		u32 DecoderOGG::DecodePacket(const u8* data, u32 size, s16* output)
+		{
+			if (!IsReady() || size == 0)
+				return 0;
+
+			BitReader reader(data, size);
+
+			//Audio packets start with a 0 bit
+			if (reader.Read(1) != 0)
+				return 0;
+
+			u32 modeIdx = reader.Read(ILog((u32)m_modes.size() - 1));
+			if (modeIdx >= m_modes.size())
+				return 0;
+
+			const Mode& mode = m_modes[modeIdx];
+			const Mapping& mapping = m_mappings[mode.mapping];
+			const u32 n = m_blockSizes[mode.blockFlag];
+			const u32 halfN = n / 2;
+			const u32 shortN = m_blockSizes[0];
+
+			bool prevWindowLong = true;
+			bool nextWindowLong = true;
+
+			if (mode.blockFlag)
+			{
+				prevWindowLong = reader.ReadFlag();
+				nextWindowLong = reader.ReadFlag();
+			}
+
+			//Window slopes, a long block next to a short one uses a short slope
+			u32 leftStart = 0;
+			u32 leftEnd = halfN;
+			u32 rightStart = halfN;
+			u32 rightEnd = n;
+
+			if (mode.blockFlag && !prevWindowLong)
+			{
+				leftStart = (n / 4) - (shortN / 4);
+				leftEnd = (n / 4) + (shortN / 4);
+			}
+
+			if (mode.blockFlag && !nextWindowLong)
+			{
+				rightStart = ((n * 3) / 4) - (shortN / 4);
+				rightEnd = ((n * 3) / 4) + (shortN / 4);
+			}
+
+			//Floors
+			s32 floorValues[s_maxChannels][s_maxFloorValues];
+			bool floorUsed[s_maxChannels];
+			bool noResidue[s_maxChannels];
+
+			for (u32 ch = 0; ch < m_numChannels; ch++)
+			{
+				const Floor& floor = m_floors[mapping.submapFloor[mapping.mux[ch]]];
+				floorUsed[ch] = DecodeFloorCurve(reader, floor, floorValues[ch]);
+				noResidue[ch] = !floorUsed[ch];
+				memory::MemSet(m_spectra[ch].data(), 0, halfN * sizeof(float));
+			}
+
+			//Coupled channels decode residue if either is used
+			for (u32 i = 0; i < mapping.numCouplingSteps; i++)
+			{
+				if (!noResidue[mapping.magnitude[i]] || !noResidue[mapping.angle[i]])
+				{
+					noResidue[mapping.magnitude[i]] = false;
+					noResidue[mapping.angle[i]] = false;
+				}
+			}
+
+			//Residues, per submap
+			for (u32 submap = 0; submap < mapping.numSubmaps; submap++)
+			{
+				float* vectors[s_maxChannels];
+				bool doNotDecode[s_maxChannels];
+				u32 numVectors = 0;
+
+				for (u32 ch = 0; ch < m_numChannels; ch++)
+				{
+					if (mapping.mux[ch] == submap)
+					{
+						vectors[numVectors] = m_spectra[ch].data();
+						doNotDecode[numVectors] = noResidue[ch];
+						numVectors++;
+					}
+				}
+
+				const Residue& residue = m_residues[mapping.submapResidue[submap]];
+
+				if (residue.type == 2)
+				{
+					//One vector with channels interleaved, decoded as type 1 then split
+					bool anyUsed = false;
+					for (u32 j = 0; j < numVectors; j++)
+					{
+						anyUsed |= !doNotDecode[j];
+					}
+
+					if (anyUsed)
+					{
+						std::vector<float>& interleaved = m_interleaved;
+
+						memory::MemSet(interleaved.data(), 0, halfN * numVectors * sizeof(float));
+
+						Residue type1 = residue;
+						type1.type = 1;
+						float* interleavedVector = interleaved.data();
+						bool decode = false;
+						DecodeResidueVectors(reader, type1, &interleavedVector, &decode, 1, halfN * numVectors);
+
+						for (u32 i = 0; i < halfN; i++)
+						{
+							for (u32 j = 0; j < numVectors; j++)
+							{
+								vectors[j][i] = interleaved[(i * numVectors) + j];
+							}
+						}
+					}
+				}
+				else
+				{
+					DecodeResidueVectors(reader, residue, vectors, doNotDecode, numVectors, halfN);
+				}
+			}
+
+			//Inverse coupling, last step first
+			for (int i = (int)mapping.numCouplingSteps - 1; i >= 0; i--)
+			{
+				float* magnitudes = m_spectra[mapping.magnitude[i]].data();
+				float* angles = m_spectra[mapping.angle[i]].data();
+
+				for (u32 j = 0; j < halfN; j++)
+				{
+					float m = magnitudes[j];
+					float a = angles[j];
+
+					if (m > 0.0f)
+					{
+						if (a > 0.0f)
+						{
+							angles[j] = m - a;
+						}
+						else
+						{
+							angles[j] = m;
+							magnitudes[j] = m + a;
+						}
+					}
+					else
+					{
+						if (a > 0.0f)
+						{
+							angles[j] = m + a;
+						}
+						else
+						{
+							angles[j] = m;
+							magnitudes[j] = m - a;
+						}
+					}
+				}
+			}
+
+			//Floor curve times residue, then back to time domain
+			const Transform& transform = m_transforms[mode.blockFlag];
+
+			for (u32 ch = 0; ch < m_numChannels; ch++)
+			{
+				float* spectrum = m_spectra[ch].data();
+
+				if (floorUsed[ch])
+				{
+					const Floor& floor = m_floors[mapping.submapFloor[mapping.mux[ch]]];
+					RenderFloorCurve(floor, floorValues[ch], halfN, spectrum);
+				}
+				else
+				{
+					memory::MemSet(spectrum, 0, halfN * sizeof(float));
+				}
+
+				float* block = m_blocks[ch].data();
+				InverseMDCT(transform, spectrum, block);
+
+				//Window both slopes, zero outside them
+				const float* leftWindow = m_transforms[(leftEnd - leftStart) == halfN ? mode.blockFlag : 0].window.data();
+				const float* rightWindow = m_transforms[(rightEnd - rightStart) == halfN ? mode.blockFlag : 0].window.data();
+				u32 leftSize = leftEnd - leftStart;
+				u32 rightSize = rightEnd - rightStart;
+
+				for (u32 i = 0; i < leftStart; i++)
+					block[i] = 0.0f;
+				for (u32 i = 0; i < leftSize; i++)
+					block[leftStart + i] *= leftWindow[i];
+				for (u32 i = 0; i < rightSize; i++)
+					block[rightStart + i] *= rightWindow[rightSize - 1 - i];
+				for (u32 i = rightEnd; i < n; i++)
+					block[i] = 0.0f;
+			}
+
+			//Output runs from previous block's centre to this block's centre
+			u32 numFrames = 0;
+
+			if (m_havePrevious)
+			{
+				u32 overlapSize = maths::Min(m_prevRightEnd - m_prevRightStart, leftEnd - leftStart);
+				numFrames = m_prevRightStart + overlapSize + (halfN - leftEnd);
+
+				for (u32 ch = 0; ch < m_numChannels; ch++)
+				{
+					const float* overlap = m_overlap[ch].data();
+					const float* block = m_blocks[ch].data();
+					s16* dest = output + ch;
+					u32 frame = 0;
+
+					for (u32 i = 0; i < m_prevRightStart; i++, frame++)
+					{
+						dest[frame * m_numChannels] = (s16)maths::Clamp((int)lrintf(overlap[i] * 32767.0f), -32768, 32767);
+					}
+
+					for (u32 i = 0; i < overlapSize; i++, frame++)
+					{
+						float sample = overlap[m_prevRightStart + i] + block[leftStart + i];
+						dest[frame * m_numChannels] = (s16)maths::Clamp((int)lrintf(sample * 32767.0f), -32768, 32767);
+					}
+
+					for (u32 i = leftEnd; i < halfN; i++, frame++)
+					{
+						dest[frame * m_numChannels] = (s16)maths::Clamp((int)lrintf(block[i] * 32767.0f), -32768, 32767);
+					}
+				}
+			}
+
+			//Keep right half for next packet
+			for (u32 ch = 0; ch < m_numChannels; ch++)
+			{
+				memory::MemCopy(m_overlap[ch].data(), m_blocks[ch].data() + halfN, halfN * sizeof(float));
+			}
+
+			m_prevRightStart = rightStart - halfN;
+			m_prevRightEnd = rightEnd - halfN;
+			m_havePrevious = true;
+
+			return numFrames;
+		}
+	}
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <audio/Decoder.h>
+
+#include <vector>
+
+namespace ion
+{
+	namespace audio
+	{
+		//Vorbis I packet decoder, for the audio streams in Ogg files.
+		//Supports floor type 1, residue types 0-2, and up to 8 channels. Floor type 0 streams are rejected,
+		//no encoder has written them since the Vorbis 1.0 betas.
+		class DecoderOGG : public Decoder
+		{
+		public:
+			static const u32 s_maxChannels = 8;
+
+			DecoderOGG();
+			virtual ~DecoderOGG();
+
+			virtual bool DecodeHeader(const u8* data, u32 size);
+			virtual bool IsReady() const;
+
+			virtual u32 GetNumChannels() const;
+			virtual u32 GetSampleRate() const;
+			virtual u32 GetMaxPacketFrames() const;
+
+			virtual u32 DecodePacket(const u8* data, u32 size, s16* output);
+			virtual void Reset();
+
+			//Block size of a packet without decoding it, for positioning after a seek. 0 if not an audio packet.
+			u32 GetPacketBlockSize(const u8* data, u32 size) const;
+
+			u32 GetBlockSize(int blockFlag) const { return m_blockSizes[blockFlag]; }
+
+		private:
+			class BitReader;
+
+			//Huffman codes up to this length are decoded with one table lookup
+			static const u32 s_fastBits = 10;
+
+			static const int s_maxFloorValues = 65;
+			static const int s_maxPartitionClasses = 16;
+
+			struct Codebook
+			{
+				struct FastEntry
+				{
+					s32 entry;		//Entry, or first long code with this prefix if length is 0
+					u32 length;
+				};
+
+				struct LongCode
+				{
+					u32 codeword;	//Bit reversed, in stream order
+					u32 length;
+					u32 entry;
+				};
+
+				u32 dimensions;
+				u32 numEntries;
+				std::vector<FastEntry> fastTable;
+				std::vector<LongCode> longCodes;
+
+				//Unpacked VQ vectors, numEntries * dimensions, empty for scalar only books
+				std::vector<float> vectors;
+			};
+
+			struct Floor
+			{
+				u32 numPartitions;
+				u8 partitionClasses[32];
+				u8 classDimensions[s_maxPartitionClasses];
+				u8 classSubclasses[s_maxPartitionClasses];
+				s16 classMasterbooks[s_maxPartitionClasses];
+				s16 subclassBooks[s_maxPartitionClasses][8];
+				u32 multiplier;
+				u32 numValues;
+				u16 x[s_maxFloorValues];
+				u8 sortedOrder[s_maxFloorValues];
+				u8 lowNeighbour[s_maxFloorValues];
+				u8 highNeighbour[s_maxFloorValues];
+			};
+
+			struct Residue
+			{
+				u32 type;
+				u32 begin;
+				u32 end;
+				u32 partitionSize;
+				u32 numClassifications;
+				u32 classbook;
+				s16 books[64][8];
+			};
+
+			struct Mapping
+			{
+				u32 numCouplingSteps;
+				u8 magnitude[256];
+				u8 angle[256];
+				u32 numSubmaps;
+				u8 mux[s_maxChannels];
+				u8 submapFloor[16];
+				u8 submapResidue[16];
+			};
+
+			struct Mode
+			{
+				u32 blockFlag;
+				u32 mapping;
+			};
+
+			//Per block size
+			struct Transform
+			{
+				u32 size;
+				std::vector<float> window;		//Rising half, size / 2
+				std::vector<float> twiddle;		//DCT-IV pre/post rotation
+				std::vector<float> fftTwiddle;
+				std::vector<u32> bitReverse;
+			};
+
+			bool DecodeIdentificationHeader(BitReader& reader);
+			bool DecodeSetupHeader(BitReader& reader);
+			bool DecodeCodebook(BitReader& reader, Codebook& codebook);
+			bool DecodeFloor(BitReader& reader, Floor& floor);
+			bool DecodeResidue(BitReader& reader, Residue& residue);
+			bool DecodeMapping(BitReader& reader, Mapping& mapping);
+			void InitTransform(Transform& transform, u32 size);
+
+			s32 DecodeScalar(BitReader& reader, const Codebook& codebook) const;
+			const float* DecodeVector(BitReader& reader, const Codebook& codebook) const;
+
+			bool DecodeFloorCurve(BitReader& reader, const Floor& floor, s32* values) const;
+			void RenderFloorCurve(const Floor& floor, const s32* values, u32 n, float* spectrum) const;
+			void DecodeResidueVectors(BitReader& reader, const Residue& residue, float** vectors, const bool* doNotDecode, u32 numVectors, u32 n);
+
+			void InverseMDCT(const Transform& transform, float* spectrum, float* output);
+
+			int m_numHeaders;
+
+			u32 m_numChannels;
+			u32 m_sampleRate;
+			u32 m_blockSizes[2];
+
+			std::vector<Codebook> m_codebooks;
+			std::vector<Floor> m_floors;
+			std::vector<Residue> m_residues;
+			std::vector<Mapping> m_mappings;
+			std::vector<Mode> m_modes;
+			Transform m_transforms[2];
+
+			//Packet state
+			std::vector<float> m_spectra[s_maxChannels];
+			std::vector<float> m_blocks[s_maxChannels];
+			std::vector<float> m_overlap[s_maxChannels];
+			std::vector<float> m_fftBuffer;
+			std::vector<float> m_interleaved;		//Residue type 2 scratch
+			std::vector<u8> m_classifications;
+
+			//Overlap carried from previous packet, relative to its centre
+			bool m_havePrevious;
+			u32 m_prevRightStart;
+			u32 m_prevRightEnd;
+		};
+	}
+}
@@ -1,3 +1,5 @@
+#pragma once
+
 namespace ion
 {
 	namespace audio
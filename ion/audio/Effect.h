@@ -1,22 +1,34 @@
 #pragma once
 
+#include <core/Types.h>
+
 namespace ion
 {
 	namespace audio
 	{
 		class Voice;
 
+		//Processes a voice's audio in blocks on the mixer thread, after resampling and before gain and pan
 		class Effect
 		{
 		protected:
 			Effect() {}
 			virtual ~Effect() {}
 
-			virtual void Update(float deltaTime) = 0;
-			virtual void Apply(Voice* voice) = 0;
+			//Interleaved float frames at the output sample rate, processed in place.
+			//Mixer thread: must not lock, allocate or call back into game code.
+			virtual void Process(float* samples, u32 numFrames, u32 numChannels, u32 sampleRate) = 0;
+
+			//Game thread, from Voice::Update(), for notifications raised by Process() or Apply()
+			virtual void Update() {}
+
+			//Game thread fallback for voices the Mixer doesn't process (XAudio, Android), which can't run Process().
+			//Advances by deltaTime and applies through the voice's own properties.
+			virtual void Apply(Voice& voice, float deltaTime) {}
 
 			friend class Engine;
 			friend class Voice;
+			friend class MixerVoice;
 		};
 	}
 }
\ No newline at end of file
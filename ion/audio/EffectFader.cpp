@@ -1,4 +1,5 @@
 #include "EffectFader.h"
+#include "MixKernels.h"
 #include "Voice.h"
 
 #include <ion/maths/Maths.h>
@@ -11,6 +12,9 @@ namespace ion
 		{
 			m_volume = 0.0f;
 			m_speed = 0.0f;
+			m_generation = 1;
+			m_finishedGeneration = 0;
+			m_reportedGeneration = 0;
 		}
 
 		EffectFader::~EffectFader()
@@ -20,43 +24,96 @@ namespace ion
 
 		void EffectFader::FadeIn(float speed, OnFadeFinished const& onFinished)
 		{
-			m_speed = speed;
-			m_onFinished = onFinished;
-
-			if (m_volume == 1.0f && onFinished)
-			{
-				onFinished(*this);
-			}
+			StartFade(speed, onFinished, 1.0f);
 		}
 
 		void EffectFader::FadeOut(float speed, OnFadeFinished const& onFinished)
 		{
-			m_speed = -speed;
-			m_onFinished = onFinished;
+			StartFade(-speed, onFinished, 0.0f);
+		}
+
+		void EffectFader::StartFade(float speed, OnFadeFinished const& onFinished, float targetVolume)
+		{
+			//Speed is published by the generation bump
+			m_finishedGeneration.store(0, std::memory_order_relaxed);
+			m_speed.store(speed, std::memory_order_relaxed);
+			m_generation.fetch_add(1, std::memory_order_release);
 
-			if (m_volume == 0.0f && onFinished)
+			if (m_volume == targetVolume)
 			{
-				onFinished(*this);
+				//Already there, finish now rather than on the next Update()
+				m_onFinished = nullptr;
+
+				if (onFinished)
+				{
+					onFinished(*this);
+				}
+			}
+			else
+			{
+				m_onFinished = onFinished;
 			}
 		}
 
-		void EffectFader::Update(float deltaTime)
+		float EffectFader::GetVolume() const
+		{
+			return m_volume;
+		}
+
+		void EffectFader::Process(float* samples, u32 numFrames, u32 numChannels, u32 sampleRate)
 		{
-			float prev = m_volume;
-			m_volume = ion::maths::Clamp(m_volume + (m_speed * deltaTime), 0.0f, 1.0f);
+			float startVolume = 0.0f;
+			float endVolume = 0.0f;
+			Advance((float)numFrames / (float)sampleRate, startVolume, endVolume);
 
-			if (m_volume != prev && (m_volume == 0.0f || m_volume == 1.0f))
+			//Unity once faded in
+			if (startVolume == 1.0f && endVolume == 1.0f)
+				return;
+
+			mix::ScaleRamp(samples, numFrames, numChannels, startVolume, endVolume);
+		}
+
+		void EffectFader::Apply(Voice& voice, float deltaTime)
+		{
+			float startVolume = 0.0f;
+			float endVolume = 0.0f;
+			Advance(deltaTime, startVolume, endVolume);
+			voice.SetVolume(endVolume);
+		}
+
+		void EffectFader::Advance(float numSeconds, float& startVolume, float& endVolume)
+		{
+			u32 generation = m_generation.load(std::memory_order_acquire);
+			float speed = m_speed.load(std::memory_order_relaxed);
+			startVolume = m_volume.load(std::memory_order_relaxed);
+			endVolume = ion::maths::Clamp(startVolume + (speed * numSeconds), 0.0f, 1.0f);
+
+			if (endVolume != startVolume)
 			{
-				if (m_onFinished)
-				{
-					m_onFinished(*this);
-				}
+				m_volume.store(endVolume, std::memory_order_relaxed);
+			}
+
+			//Report once per fade on reaching its target. Not only when volume changes, a block that read the new speed
+			//under the old generation may have already got there.
+			bool reachedTarget = (speed > 0.0f && endVolume == 1.0f) || (speed < 0.0f && endVolume == 0.0f);
+			if (reachedTarget && generation != m_reportedGeneration)
+			{
+				//Callback on game thread
+				m_reportedGeneration = generation;
+				m_finishedGeneration.store(generation, std::memory_order_release);
 			}
 		}
 
-		void EffectFader::Apply(Voice* voice)
+		void EffectFader::Update()
 		{
-			voice->SetVolume(m_volume);
+			//Stale if a fade started since, its own finish is still to come
+			u32 finishedGeneration = m_finishedGeneration.exchange(0, std::memory_order_acquire);
+			if (finishedGeneration == m_generation.load(std::memory_order_relaxed) && m_onFinished)
+			{
+				OnFadeFinished onFinished = m_onFinished;
+				m_onFinished = nullptr;
+				onFinished(*this);
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Effect.h"
 
+#include <atomic>
 #include <functional>
 
 namespace ion
@@ -16,16 +17,38 @@ namespace ion
 			EffectFader();
 			virtual ~EffectFader();
 
+			//Speed is full volume per second. onFinished is called from Voice::Update() once the fade ends.
+			//On voices without a Mixer the fade is applied with Voice::SetVolume(), replacing the voice's volume.
 			void FadeIn(float speed, OnFadeFinished const& onFinished = nullptr);
 			void FadeOut(float speed, OnFadeFinished const& onFinished = nullptr);
 
+			float GetVolume() const;
+
 		protected:
-			virtual void Update(float deltaTime);
-			virtual void Apply(Voice* voice);
+			virtual void Process(float* samples, u32 numFrames, u32 numChannels, u32 sampleRate);
+			virtual void Update();
+			virtual void Apply(Voice& voice, float deltaTime);
 
 		private:
-			float m_volume;
-			float m_speed;
+			//Steps the fade by numSeconds, from the thread driving it (mixer, or game thread via Apply())
+			void Advance(float numSeconds, float& startVolume, float& endVolume);
+
+			//Starts a new fade generation at speed, clearing any finish not yet delivered
+			void StartFade(float speed, OnFadeFinished const& onFinished, float targetVolume);
+
+			//Set by game thread, ramped by mixer thread
+			std::atomic<float> m_speed;
+			std::atomic<float> m_volume;
+
+			//Bumped per fade, so a block stepped under the previous fade can't finish the new one
+			std::atomic<u32> m_generation;
+
+			//Generation of the last fade to finish, 0 if none. Written by Advance(), consumed by Update().
+			std::atomic<u32> m_finishedGeneration;
+
+			//Last generation Advance() reported, only touched by the thread driving the fade
+			u32 m_reportedGeneration;
+
 			OnFadeFinished m_onFinished;
 		};
 	}
@@ -1,12 +1,25 @@
 #include "Engine.h"
 #include "Voice.h"
+#include "Mixer.h"
+#include "MixerVoice.h"
 
+#include <core/debug/Debug.h>
 #include <core/utils/STL.h>
 
 namespace ion
 {
 	namespace audio
 	{
+		Engine::Engine()
+		{
+			m_mixer = nullptr;
+		}
+
+		Engine::~Engine()
+		{
+			delete m_mixer;
+		}
+
 		void Engine::AddVoice(Voice* voice)
 		{
 			m_voiceListCritSec.Begin();
@@ -21,6 +34,29 @@ namespace ion
 			m_voiceListCritSec.End();
 		}
 
+		void Engine::CreateMixer(u32 sampleRate)
+		{
+			debug::Assert(!m_mixer, "Engine::CreateMixer() - Mixer already created");
+			m_mixer = new Mixer(sampleRate);
+		}
+
+		Voice* Engine::CreateMixerVoice(Source& source, bool loop)
+		{
+			debug::Assert(m_mixer, "Engine::CreateMixerVoice() - No mixer");
+			MixerVoice* voice = new MixerVoice(source, loop, m_mixer->GetSampleRate());
+			AddVoice(voice);
+			m_mixer->AddVoice(*voice);
+			return voice;
+		}
+
+		void Engine::ReleaseMixerVoice(Voice& voice)
+		{
+			MixerVoice& mixerVoice = (MixerVoice&)voice;
+			m_mixer->RemoveVoice(mixerVoice);
+			RemoveVoice(&voice);
+			delete &mixerVoice;
+		}
+
 		void Engine::Update(float deltaTime)
 		{
 			m_voiceListCritSec.Begin();
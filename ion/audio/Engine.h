@@ -1,5 +1,6 @@
 #pragma once
 
+#include <core/Types.h>
 #include <core/thread/CriticalSection.h>
 #include <core/thread/Event.h>
 #include <vector>
@@ -9,6 +10,7 @@ namespace ion
 	namespace audio
 	{
 		class Device;
+		class Mixer;
 		class Source;
 		class Voice;
 
@@ -16,7 +18,7 @@ namespace ion
 		{
 		public:
 			static Engine* Create();
-			virtual ~Engine() {}
+			virtual ~Engine();
 
 			virtual int EnumerateDevices(std::vector<Device*>& devices) = 0;
 
@@ -27,11 +29,21 @@ namespace ion
 
 			virtual void WaitNextUpdateEvent() {}
 
+			//Software mixer, null if backend plays voices through the OS
+			Mixer* GetMixer() const { return m_mixer; }
+
 		protected:
-			Engine() {}
+			Engine();
 			void AddVoice(Voice* voice);
 			void RemoveVoice(Voice* voice);
 
+			//Software mixing, for backends that play all voices through one output device
+			void CreateMixer(u32 sampleRate);
+			Voice* CreateMixerVoice(Source& source, bool loop);
+			void ReleaseMixerVoice(Voice& voice);
+
+			Mixer* m_mixer;
+
 		private:
 			std::vector<Voice*> m_voices;
 			ion::thread::CriticalSection m_voiceListCritSec;
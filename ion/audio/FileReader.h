@@ -1,7 +1,7 @@
 #pragma once
 
 #include <audio/StreamDesc.h>
-#include <core/io/File.h>
+#include <core/io/MappedFileStream.h>
 #include <string>
 
 namespace ion
@@ -39,7 +39,7 @@ namespace ion
 			virtual bool ReadHeader() = 0;
 
 			std::string m_filename;
-			io::File m_file;
+			io::MappedFileStream m_file;
 		};
 
 		template <class HeaderT> class FileReaderT : public FileReader
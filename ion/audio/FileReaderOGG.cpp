@@ -0,0 +1,542 @@
+#include <core/debug/Debug.h>
+#include <core/memory/Memory.h>
+#include <maths/Maths.h>
+
+#include "FileReaderOGG.h"
+
+#include <cstring>
+
+namespace ion
+{
+	namespace audio
+	{
+		//Page checksum, CRC32 polynomial 0x04c11db7, no reflection
+		static u32 s_crcTable[256];
+		static bool s_crcTableInitialised = false;
+
+		static u32 UpdateCRC(u32 crc, const u8* data, u32 size)
+		{
+			for (u32 i = 0; i < size; i++)
+			{
+				crc = (crc << 8) ^ s_crcTable[(crc >> 24) ^ data[i]];
+			}
+
+			return crc;
+		}
+
+		static u32 ReadU32(const u8* data)
+		{
+			return (u32)data[0] | ((u32)data[1] << 8) | ((u32)data[2] << 16) | ((u32)data[3] << 24);
+		}
+
+		static u64 ReadU64(const u8* data)
+		{
+			return (u64)ReadU32(data) | ((u64)ReadU32(data + 4) << 32);
+		}
+
+		FileReaderOGG::FileReaderOGG(const char* filename)
+			: FileReaderT(filename)
+		{
+			if (!s_crcTableInitialised)
+			{
+				for (u32 i = 0; i < 256; i++)
+				{
+					u32 crc = i << 24;
+					for (int bit = 0; bit < 8; bit++)
+					{
+						crc = (crc & 0x80000000) ? ((crc << 1) ^ 0x04c11db7) : (crc << 1);
+					}
+
+					s_crcTable[i] = crc;
+				}
+
+				s_crcTableInitialised = true;
+			}
+
+			m_data = nullptr;
+			m_size = 0;
+			m_serial = 0;
+			m_pcmFrame = 0;
+			m_pcmFrames = 0;
+			m_position = 0;
+			m_skipFrames = 0;
+			m_header.m_numChannels = 0;
+			m_header.m_sampleRate = 0;
+			m_header.m_numSamples = 0;
+			m_header.m_encodedSize = 0;
+		}
+
+		FileReaderOGG::~FileReaderOGG()
+		{
+		}
+
+		bool FileReaderOGG::Open()
+		{
+			if (m_file.Open(m_filename))
+			{
+				m_size = (u32)m_file.GetSize();
+				m_data = m_file.GetView(0, m_size);
+
+				if (m_data && ReadHeader())
+				{
+					SeekRaw(0);
+					return true;
+				}
+
+				Close();
+			}
+
+			return false;
+		}
+
+		void FileReaderOGG::Close()
+		{
+			if (m_file.IsOpen())
+				m_file.Close();
+
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+		u32 FileReaderOGG::Read(char* data, u32 bytes)
+		{
+			const u32 numChannels = m_header.GetNumChannels();
+			const u32 blockSize = m_header.GetBlockSize();
+
+			u32 framesRemaining = bytes / blockSize;
+			u32 framesRead = 0;
+
+			while (framesRemaining && m_position < m_header.m_numSamples)
+			{
+				if (m_pcmFrame == m_pcmFrames && !DecodeNextPacket())
+					break;
+
+				//Last page's granule trims the final packet
+				u32 numFrames = maths::Min(framesRemaining, maths::Min(m_pcmFrames - m_pcmFrame, m_header.m_numSamples - m_position));
+				memory::MemCopy(data + (framesRead * blockSize), m_pcm.data() + (m_pcmFrame * numChannels), numFrames * blockSize);
+
+				m_pcmFrame += numFrames;
+				m_position += numFrames;
+				framesRead += numFrames;
+				framesRemaining -= numFrames;
+			}
+
+			return framesRead * blockSize;
+		}
+
+		u32 FileReaderOGG::GetPosition()
+		{
+			//Decoded bytes, same as SeekRaw()
+			return m_position * m_header.GetBlockSize();
+		}
+
+		void FileReaderOGG::SeekRaw(u32 byte)
+		{
+			SeekSample(byte / m_header.GetBlockSize());
+		}
+
+		void FileReaderOGG::SeekSample(u32 sample)
+		{
+			sample = maths::Min(sample, m_header.m_numSamples);
+
+			m_decoder.Reset();
+			m_pcmFrame = 0;
+			m_pcmFrames = 0;
+			m_position = sample;
+
+			//A page's granule is where output ends after decoding its last packet. Look for the last page at least
+			//one long block before the target, then decode from the packets after it and discard up to the target.
+			const u32 margin = m_decoder.GetBlockSize(1);
+
+			if (sample > margin * 2)
+			{
+				s64 target = sample - margin;
+				Page page;
+
+				while (target >= 0 && FindPageBefore((u32)target, page))
+				{
+					Cursor cursor = { page.GetEnd(), 0, 0 };
+					SetCursor(cursor);
+					SkipContinuedPacket();
+
+					s64 startSample = 0;
+					if (FindCursorSample(startSample) && startSample >= 0 && startSample <= sample)
+					{
+						m_skipFrames = sample - (u32)startSample;
+						return;
+					}
+
+					//Next granule was the trimmed end of stream, position from the page before
+					target = page.granule - 1;
+				}
+			}
+
+			//Near the start, or couldn't position from a page, decode from the first audio packet
+			SetCursor(m_dataStart);
+			m_skipFrames = sample;
+		}
+
+		bool FileReaderOGG::FindPageBefore(u32 sample, Page& page) const
+		{
+			bool found = false;
+
+			//Bisect, pages without a granule (packet spans the page) don't narrow the range
+			u32 low = m_dataStart.pageOffset;
+			u32 high = m_size;
+
+			while (high - low > s_bisectMinBytes)
+			{
+				u32 middle = low + ((high - low) / 2);
+
+				Page candidate;
+				bool foundGranule = false;
+
+				for (u32 offset = middle; FindPage(offset, candidate) && candidate.offset < high; offset = candidate.GetEnd())
+				{
+					if (candidate.granule >= 0)
+					{
+						foundGranule = true;
+						break;
+					}
+				}
+
+				if (foundGranule && candidate.granule <= sample)
+				{
+					page = candidate;
+					found = true;
+					low = candidate.GetEnd();
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+
+			//Finish linearly
+			Page candidate;
+			for (u32 offset = low; FindPage(offset, candidate); offset = candidate.GetEnd())
+			{
+				if (candidate.granule >= 0)
+				{
+					if (candidate.granule > sample)
+						break;
+
+					page = candidate;
+					found = true;
+				}
+			}
+
+			return found;
+		}
+
+		void FileReaderOGG::SeekTime(float time)
+		{
+			SeekSample((u32)(time * m_header.GetSampleRate()));
+		}
+
+		bool FileReaderOGG::ReadHeader()
+		{
+			Page page;
+			if (!ParsePage(0, page) || !(page.flags & s_flagFirst))
+			{
+				debug::log << "FileReaderOGG::ReadHeader() - " << m_filename.c_str() << " is not an Ogg file" << debug::end;
+				return false;
+			}
+
+			//Follow the first logical stream, pages of any others are skipped
+			m_serial = page.serial;
+			m_decoder = DecoderOGG();
+
+			Cursor cursor = { 0, 0, 0 };
+			SetCursor(cursor);
+
+			//Identification, comment and setup packets
+			for (int i = 0; i < 3; i++)
+			{
+				const u8* data = nullptr;
+				u32 size = 0;
+
+				if (!ReadPacket(data, size) || !m_decoder.DecodeHeader(data, size))
+				{
+					debug::log << "FileReaderOGG::ReadHeader() - " << m_filename.c_str() << " is not a supported Vorbis stream" << debug::end;
+					return false;
+				}
+			}
+
+			//Audio starts at the next packet
+			m_dataStart = m_cursor;
+
+			m_header.m_numChannels = m_decoder.GetNumChannels();
+			m_header.m_sampleRate = m_decoder.GetSampleRate();
+			m_header.m_encodedSize = m_size;
+			m_pcm.resize(m_decoder.GetMaxPacketFrames() * m_header.m_numChannels);
+
+			//Length from the last granule, search back from the end of the file until a page has one
+			s64 lastGranule = -1;
+
+			for (u32 windowSize = s_lengthSearchBytes; lastGranule < 0; windowSize *= 2)
+			{
+				u32 start = (m_size > windowSize) ? maths::Max(m_size - windowSize, m_dataStart.pageOffset) : m_dataStart.pageOffset;
+
+				for (u32 offset = start; FindPage(offset, page); offset = page.GetEnd())
+				{
+					if (page.granule >= 0)
+						lastGranule = page.granule;
+				}
+
+				if (start == m_dataStart.pageOffset)
+					break;
+			}
+
+			m_header.m_numSamples = (lastGranule > 0) ? (u32)lastGranule : 0;
+
+			return true;
+		}
+
+		bool FileReaderOGG::ParsePage(u32 offset, Page& page) const
+		{
+			static const u32 s_pageHeaderSize = 27;
+			static const u32 s_crcOffset = 22;
+			static const u8 s_zeroCRC[4] = { 0 };
+
+			if (offset + s_pageHeaderSize > m_size)
+				return false;
+
+			const u8* header = m_data + offset;
+
+			if (memcmp(header, "OggS", 4) != 0 || header[4] != 0)
+				return false;
+
+			page.offset = offset;
+			page.flags = header[5];
+			page.granule = (s64)ReadU64(header + 6);
+			page.serial = ReadU32(header + 14);
+			page.numSegments = header[26];
+			page.headerSize = s_pageHeaderSize + page.numSegments;
+
+			if (offset + page.headerSize > m_size)
+				return false;
+
+			page.lacing = header + s_pageHeaderSize;
+			page.body = header + page.headerSize;
+			page.bodySize = 0;
+
+			for (int i = 0; i < page.numSegments; i++)
+			{
+				page.bodySize += page.lacing[i];
+			}
+
+			if (page.GetEnd() > m_size)
+				return false;
+
+			//Checksum of whole page, with its own field as zero
+			u32 crc = UpdateCRC(0, header, s_crcOffset);
+			crc = UpdateCRC(crc, s_zeroCRC, 4);
+			crc = UpdateCRC(crc, header + s_crcOffset + 4, page.headerSize + page.bodySize - s_crcOffset - 4);
+
+			return crc == ReadU32(header + s_crcOffset);
+		}
+
+		bool FileReaderOGG::FindPage(u32 offset, Page& page) const
+		{
+			while (offset < m_size)
+			{
+				//Next capture pattern
+				const u8* capture = (const u8*)memchr(m_data + offset, 'O', m_size - offset);
+				if (!capture)
+					break;
+
+				offset = (u32)(capture - m_data);
+
+				if (ParsePage(offset, page))
+				{
+					if (page.serial == m_serial)
+						return true;
+
+					offset = page.GetEnd();
+				}
+				else
+				{
+					offset++;
+				}
+			}
+
+			return false;
+		}
+
+		void FileReaderOGG::SetCursor(const Cursor& cursor)
+		{
+			m_cursor = cursor;
+			m_packet.clear();
+
+			if (FindPage(cursor.pageOffset, m_page))
+			{
+				if (m_page.offset != cursor.pageOffset)
+				{
+					//Resynced further on
+					m_cursor.pageOffset = m_page.offset;
+					m_cursor.segment = 0;
+					m_cursor.bodyOffset = 0;
+				}
+			}
+			else
+			{
+				//End of stream
+				m_page.numSegments = 0;
+				m_page.flags = s_flagLast;
+				m_cursor.segment = 0;
+			}
+		}
+
+		bool FileReaderOGG::NextPage()
+		{
+			if (!FindPage(m_page.GetEnd(), m_page))
+				return false;
+
+			m_cursor.pageOffset = m_page.offset;
+			m_cursor.segment = 0;
+			m_cursor.bodyOffset = 0;
+
+			return true;
+		}
+
+		bool FileReaderOGG::ReadPacket(const u8*& data, u32& size)
+		{
+			m_packet.clear();
+
+			while (true)
+			{
+				if (m_cursor.segment >= m_page.numSegments)
+				{
+					if ((m_page.flags & s_flagLast) || !NextPage())
+						return false;
+
+					//Lost the rest of a packet that spanned pages
+					if (!(m_page.flags & s_flagContinued))
+						m_packet.clear();
+
+					continue;
+				}
+
+				//Segments up to the first short one
+				u32 start = m_cursor.bodyOffset;
+				u32 length = 0;
+				bool complete = false;
+
+				while (m_cursor.segment < m_page.numSegments && !complete)
+				{
+					u8 lacing = m_page.lacing[m_cursor.segment++];
+					length += lacing;
+					complete = (lacing < 255);
+				}
+
+				m_cursor.bodyOffset += length;
+
+				if (complete && m_packet.empty())
+				{
+					//Within one page, no copy
+					data = m_page.body + start;
+					size = length;
+					return true;
+				}
+
+				m_packet.insert(m_packet.end(), m_page.body + start, m_page.body + start + length);
+
+				if (complete)
+				{
+					data = m_packet.data();
+					size = (u32)m_packet.size();
+					return true;
+				}
+			}
+		}
+
+		void FileReaderOGG::SkipContinuedPacket()
+		{
+			//Tail of a packet started before the cursor's page
+			while (m_cursor.segment == 0 && (m_page.flags & s_flagContinued))
+			{
+				while (m_cursor.segment < m_page.numSegments)
+				{
+					u8 lacing = m_page.lacing[m_cursor.segment++];
+					m_cursor.bodyOffset += lacing;
+
+					if (lacing < 255)
+						return;
+				}
+
+				if ((m_page.flags & s_flagLast) || !NextPage())
+					return;
+			}
+		}
+
+		bool FileReaderOGG::DecodeNextPacket()
+		{
+			const u8* data = nullptr;
+			u32 size = 0;
+
+			while (ReadPacket(data, size))
+			{
+				u32 numFrames = m_decoder.DecodePacket(data, size, m_pcm.data());
+
+				//Discard up to seek target
+				u32 numSkipped = maths::Min(numFrames, m_skipFrames);
+				m_skipFrames -= numSkipped;
+				m_pcmFrame = numSkipped;
+				m_pcmFrames = numFrames;
+
+				if (m_pcmFrame < m_pcmFrames)
+					return true;
+			}
+
+			m_pcmFrame = 0;
+			m_pcmFrames = 0;
+			return false;
+		}
+
+		bool FileReaderOGG::FindCursorSample(s64& sample)
+		{
+			//Each packet after the first outputs a quarter of its own block and a quarter of the previous one,
+			//so block sizes alone give the output length up to the next page with a granule
+			const Cursor cursor = m_cursor;
+			const u8* data = nullptr;
+			u32 size = 0;
+			u32 prevBlockSize = 0;
+			s64 numFrames = 0;
+			bool found = false;
+
+			while (!found && ReadPacket(data, size))
+			{
+				u32 blockSize = m_decoder.GetPacketBlockSize(data, size);
+				if (blockSize == 0)
+					continue;
+
+				if (prevBlockSize)
+					numFrames += (prevBlockSize / 4) + (blockSize / 4);
+
+				prevBlockSize = blockSize;
+
+				//End of stream granule can be trimmed short of the decoded length
+				if (m_page.flags & s_flagLast)
+					break;
+
+				//Last packet completed on this page
+				if (m_page.granule >= 0)
+				{
+					found = true;
+					for (u32 i = m_cursor.segment; i < m_page.numSegments && found; i++)
+					{
+						found = (m_page.lacing[i] == 255);
+					}
+				}
+			}
+
+			if (found)
+				sample = m_page.granule - numFrames;
+
+			SetCursor(cursor);
+
+			return found;
+		}
+	}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <audio/DataFormat.h>
+#include <audio/DecoderOGG.h>
+#include <audio/FileReader.h>
+
+#include <vector>
+
+namespace ion
+{
+	namespace audio
+	{
+		class FileHeaderOGG : public FileHeader
+		{
+		public:
+			FileHeaderOGG() {}
+
+			virtual DataFormat GetEncodedFormat() const { return DataFormat::Vorbis; }
+			virtual DataFormat GetDecodedFormat() const { return DataFormat::PCM16; }
+			virtual u32 GetNumChannels() const { return m_numChannels; }
+			virtual u32 GetSampleRate() const { return m_sampleRate; }
+			virtual u32 GetBitsPerSample() const { return 16; }
+			virtual u32 GetBlockSize() const { return m_numChannels * 2; }
+			virtual u32 GetEncodedSizeBytes() const { return m_encodedSize; }
+			virtual u32 GetDecodedSizeBytes() const { return m_numSamples * GetBlockSize(); }
+			virtual u32 GetSizeSamples() const { return m_numSamples; }
+
+			u32 m_numChannels;
+			u32 m_sampleRate;
+			u32 m_numSamples;
+			u32 m_encodedSize;
+		};
+
+		//Ogg Vorbis file, decoded to PCM16 as it's read. Positions (GetPosition(), SeekRaw()) are in decoded bytes,
+		//same as FileReaderWAV, so FileSource can treat both alike. Seeks are sample accurate.
+		class FileReaderOGG : public FileReaderT<FileHeaderOGG>
+		{
+		public:
+			FileReaderOGG(const char* filename);
+			virtual ~FileReaderOGG();
+
+			virtual bool Open();
+			virtual void Close();
+
+			virtual u32 Read(char* data, u32 bytes);
+
+			virtual u32 GetPosition();
+
+			virtual void SeekRaw(u32 byte);
+			virtual void SeekSample(u32 sample);
+			virtual void SeekTime(float time);
+
+		protected:
+			virtual bool ReadHeader();
+
+		private:
+			struct Page
+			{
+				u32 offset;
+				u32 headerSize;
+				u32 bodySize;
+				s64 granule;		//Sample position at end of last packet completed on this page, -1 if none
+				u32 serial;
+				u8 flags;
+				u8 numSegments;
+				const u8* lacing;
+				const u8* body;
+
+				u32 GetEnd() const { return offset + headerSize + bodySize; }
+			};
+
+			//Page and segment being read from
+			struct Cursor
+			{
+				u32 pageOffset;
+				u32 segment;
+				u32 bodyOffset;
+			};
+
+			static const u8 s_flagContinued = 0x01;
+			static const u8 s_flagFirst = 0x02;
+			static const u8 s_flagLast = 0x04;
+
+			//Seek bisection stops at this range and scans the rest
+			static const u32 s_bisectMinBytes = 16 * 1024;
+
+			//Initial size of the search back from the end of the file for the stream length
+			static const u32 s_lengthSearchBytes = 64 * 1024;
+
+			//Valid page of this stream at offset, or the next one found after it
+			bool ParsePage(u32 offset, Page& page) const;
+			bool FindPage(u32 offset, Page& page) const;
+
+			//Last page with a granule at or before sample
+			bool FindPageBefore(u32 sample, Page& page) const;
+
+			void SetCursor(const Cursor& cursor);
+			bool NextPage();
+
+			//Next whole packet, pointing into the file where it doesn't cross pages
+			bool ReadPacket(const u8*& data, u32& size);
+			void SkipContinuedPacket();
+
+			//Decode until a packet produces frames
+			bool DecodeNextPacket();
+
+			//Sample position of the first frame decoded from the cursor, counts block sizes up to the next granule
+			bool FindCursorSample(s64& sample);
+
+			const u8* m_data;
+			u32 m_size;
+			u32 m_serial;
+
+			DecoderOGG m_decoder;
+
+			Cursor m_dataStart;
+			Cursor m_cursor;
+			Page m_page;
+			std::vector<u8> m_packet;
+
+			//Decoded frames of current packet
+			std::vector<s16> m_pcm;
+			u32 m_pcmFrame;
+			u32 m_pcmFrames;
+
+			//Sample position of next frame returned, and frames still to discard after a seek
+			u32 m_position;
+			u32 m_skipFrames;
+		};
+	}
+}
@@ -18,7 +18,7 @@ namespace ion
 
 		bool FileReaderWAV::Open()
 		{
-			if(m_file.Open(m_filename.c_str(), io::File::OpenMode::Read))
+			if(m_file.Open(m_filename))
 			{
 				//Seek to 'RIFF' chunk
 				RIFFChunk chunk;
@@ -61,7 +61,8 @@ namespace ion
 
 		u32 FileReaderWAV::GetPosition()
 		{
-			return (u32)m_file.GetPosition();
+			//Relative to start of data, same as SeekRaw()
+			return (u32)m_file.GetPosition() - m_header.m_dataOffset;
 		}
 
 		void FileReaderWAV::SeekRaw(u32 byte)
@@ -20,9 +20,14 @@ namespace ion
 			m_streamDesc = &m_fileReader.GetStreamDesc();
 			m_buffer = nullptr;
 			m_loop = loop;
+			m_starvationCount = 0;
+			m_endOfStream = false;
+			m_pendingReads = 0;
+			m_numStreamBuffers = s_defaultStreamBuffers;
+			m_streamBufferSize = s_defaultStreamBufferSize;
 			m_debugName = m_fileReader.GetFilename();
 
-			for (int i = 0; i < s_numStreamBuffers; i++)
+			for (int i = 0; i < s_maxStreamBuffers; i++)
 			{
 				m_streamBuffers[i] = nullptr;
 			}
@@ -55,14 +60,19 @@ namespace ion
 					//Set stream desc
 					m_streamDesc = &m_fileReader.GetStreamDesc();
 
-					//Alloc buffer
-					m_buffer = Buffer::Create(m_streamDesc->GetEncodedSizeBytes());
+					//Alloc buffer, compressed files are decoded while reading
+					m_buffer = Buffer::Create(m_streamDesc->GetDecodedSizeBytes());
 
-					//Lock buffer while stream is open
+					//Size buffer to fit whole file
 					m_buffer->WriteLock();
+					m_buffer->Reserve(m_streamDesc->GetDecodedSizeBytes());
+					m_buffer->WriteUnlock();
+
+					//Lock buffer while stream is open, voices read lock it too
+					m_buffer->ReadLock();
 
 					//Read data
-					m_fileReader.Read(m_buffer->Get(0), m_streamDesc->GetEncodedSizeBytes());
+					m_fileReader.Read(m_buffer->Get(0), m_streamDesc->GetDecodedSizeBytes());
 
 					//Close file
 					m_fileReader.Close();
@@ -95,7 +105,7 @@ namespace ion
 			{
 				if (m_buffer)
 				{
-					m_buffer->WriteUnlock();
+					m_buffer->ReadUnlock();
 					delete m_buffer;
 					m_buffer = nullptr;
 				}
@@ -113,19 +123,27 @@ namespace ion
 		{
 			bool success = false;
 
+			m_endOfStream = false;
+
 			if (m_fileReader.Open())
 			{
-				//Alloc buffers
-				for (int i = 0; i < s_numStreamBuffers; i++)
+				//Alloc buffers, whole frames each
+				u32 blockSize = GetStreamDesc()->GetBlockSize();
+				u32 bufferSize = (m_streamBufferSize / blockSize) * blockSize;
+
+				for (int i = 0; i < m_numStreamBuffers; i++)
 				{
-					m_streamBuffers[i] = Buffer::Create(s_streamBufferSize);
+					m_streamBuffers[i] = Buffer::Create(bufferSize);
 					m_streamBuffers[i]->WriteLock();
-					m_streamBuffers[i]->Reserve(s_streamBufferSize);
+					m_streamBuffers[i]->Reserve(bufferSize);
 					m_streamBuffers[i]->WriteUnlock();
+					m_freeBuffers.TryPush(m_streamBuffers[i]);
 				}
 
-				//Read first buffer
-				StreamThreadReadNextBuffer();
+				//Fill all buffers before playback starts
+				while (StreamThreadReadNextBuffer())
+				{
+				}
 
 				success = true;
 			}
@@ -139,7 +157,11 @@ namespace ion
 
 		void FileSource::StreamThreadClose()
 		{
-			for (int i = 0; i < s_numStreamBuffers; i++)
+			Buffer* buffer = nullptr;
+			while (m_freeBuffers.TryPop(buffer)) {}
+			while (m_filledBuffers.TryPop(buffer)) {}
+
+			for (int i = 0; i < s_maxStreamBuffers; i++)
 			{
 				if (m_streamBuffers[i])
 				{
@@ -157,14 +179,37 @@ namespace ion
 			}
 		}
 
-		void FileSource::StreamThreadReadNextBuffer()
+		bool FileSource::StreamThreadReadNextBuffer()
 		{
+			//Nothing more to read
+			if (m_endOfStream.load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			//Take a recycled buffer, if the voice has returned one
+			Buffer* buffer = nullptr;
+			if (!m_freeBuffers.TryPop(buffer))
+			{
+				return false;
+			}
+
+			//Restore full size if the previous fill was truncated
+			if (buffer->GetDataSize() < buffer->GetReservedSize())
+			{
+				buffer->WriteLock();
+				buffer->Reset();
+				buffer->Reserve(buffer->GetReservedSize());
+				buffer->WriteUnlock();
+			}
+
 			//Read buffer
-			Buffer* buffer = m_streamBuffers[m_bufferIdxProducer % s_numStreamBuffers];
 			buffer->ReadLock();
 
-			u32 bytesRemaining = s_streamBufferSize;
+			//Compressed readers decode straight into the buffer
+			u32 bytesRemaining = buffer->GetReservedSize();
 			u32 bufferPosition = 0;
+			bool endOfStream = false;
 
 			while (bytesRemaining)
 			{
@@ -180,8 +225,10 @@ namespace ion
 					}
 					else
 					{
-						//TODO: End of stream
-						bytesRemaining = 0;
+						//End of stream, keep what was read
+						bufferPosition += bytesRead;
+						endOfStream = true;
+						break;
 					}
 				}
 
@@ -191,8 +238,34 @@ namespace ion
 
 			buffer->ReadUnlock();
 
-			//Next buffer
-			ion::thread::atomic::Increment(m_bufferIdxProducer);
+			if (bufferPosition < buffer->GetDataSize())
+			{
+				//Voice plays only the bytes read
+				buffer->WriteLock();
+				buffer->Truncate(bufferPosition);
+				buffer->WriteUnlock();
+			}
+
+			bool filled = (bufferPosition > 0);
+
+			if (filled)
+			{
+				//Ready for voice
+				m_filledBuffers.TryPush(buffer);
+			}
+			else
+			{
+				//Ended exactly on the previous buffer, nothing to play
+				m_freeBuffers.TryPush(buffer);
+			}
+
+			if (endOfStream)
+			{
+				//After the push, so a voice that sees the flag also sees the last buffer
+				m_endOfStream.store(true, std::memory_order_release);
+			}
+
+			return filled;
 		}
 
 		void FileSource::RequestBuffer(SourceCallback& callback)
@@ -203,17 +276,58 @@ namespace ion
 			}
 			else
 			{
-				//Submit next buffer
-				callback.SubmitBuffer(*m_streamBuffers[m_bufferIdxConsumer % s_numStreamBuffers]);
-
-				//Next buffer
-				ion::thread::atomic::Increment(m_bufferIdxConsumer);
+				//Submit next filled buffer
+				Buffer* buffer = nullptr;
+				if (m_filledBuffers.TryPop(buffer))
+				{
+					callback.SubmitBuffer(*buffer);
+				}
+				else if (!m_endOfStream.load(std::memory_order_relaxed))
+				{
+					//Streaming thread hasn't caught up, callback asks again later
+					ion::thread::atomic::Increment(m_starvationCount);
+				}
+			}
+		}
 
-				//Request next
+		void FileSource::ReleaseBuffer(Buffer& buffer)
+		{
+			if (m_feedType == FeedType::Streaming)
+			{
+				//Back to free list, and refill it
+				m_freeBuffers.TryPush(&buffer);
+				m_pendingReads++;
 				s_streamingThread->RequestBuffer(*this);
 			}
 		}
 
+		bool FileSource::IsEndOfStream() const
+		{
+			return m_endOfStream.load(std::memory_order_acquire) && m_filledBuffers.IsEmpty();
+		}
+
+		void FileSource::WaitForPendingReads()
+		{
+			while (m_pendingReads > 0)
+			{
+				ion::thread::Sleep(0);
+			}
+		}
+
+		u32 FileSource::GetStarvationCount() const
+		{
+			return m_starvationCount;
+		}
+
+		void FileSource::SetDecodeAhead(int numBuffers, u32 bufferSize)
+		{
+			debug::Assert(numBuffers > 0 && numBuffers <= s_maxStreamBuffers, "FileSource::SetDecodeAhead() - Bad buffer count");
+			debug::Assert(!m_streamBuffers[0], "FileSource::SetDecodeAhead() - Stream already open");
+
+			m_numStreamBuffers = numBuffers;
+			m_streamBufferSize = bufferSize;
+		}
+
 		StreamingThread::StreamingThread()
 			: ion::thread::Thread("AudioStreaming")
 			, m_jobSemaphore(s_maxJobs)
@@ -270,6 +384,7 @@ namespace ion
 					break;
 				case JobType::Read:
 					job.fileSource->StreamThreadReadNextBuffer();
+					job.fileSource->m_pendingReads--;
 					break;
 				case JobType::Shutdown:
 					running = false;
@@ -280,19 +395,15 @@ namespace ion
 
 		void StreamingThread::PushJob(Job& job)
 		{
-			m_jobCriticalSection.Begin();
+			//Blocks if streaming thread is s_maxJobs behind
 			m_jobs.Push(job);
-			m_jobCriticalSection.End();
 			m_jobSemaphore.Signal();
 		}
 
 		StreamingThread::Job StreamingThread::PopJob()
 		{
 			m_jobSemaphore.Wait();
-			m_jobCriticalSection.Begin();
-			Job job = m_jobs.Pop();
-			m_jobCriticalSection.End();
-			return job;
+			return m_jobs.Pop();
 		}
 	}
 }
\ No newline at end of file
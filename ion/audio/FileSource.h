@@ -2,12 +2,13 @@
 
 #include <core/thread/Thread.h>
 #include <core/thread/Semaphore.h>
-#include <core/thread/CriticalSection.h>
 #include <core/containers/Queue.h>
 #include <audio/Buffer.h>
 #include <audio/FileReader.h>
 #include <audio/Source.h>
 
+#include <atomic>
+
 namespace ion
 {
 	namespace audio
@@ -27,16 +28,34 @@ namespace ion
 			virtual bool OpenStream(OnStreamOpened const& onOpened);
 			virtual void CloseStream(OnStreamClosed const& onClosed);
 
-			//Get next buffer
+			//Get next buffer, streaming submits nothing if the streaming thread hasn't filled one yet
 			virtual void RequestBuffer(SourceCallback& callback);
 
+			//Recycle streaming buffer for refilling
+			virtual void ReleaseBuffer(Buffer& buffer);
+
+			//Non-looping stream read to the end and all filled buffers taken
+			virtual bool IsEndOfStream() const;
+
+			//Spin until the streaming thread has run all refills queued by ReleaseBuffer()
+			virtual void WaitForPendingReads();
+
+			//Number of buffer requests made before the streaming thread had filled one
+			u32 GetStarvationCount() const;
+
+			//Streaming decode-ahead, number of buffers the streaming thread keeps filled ahead of the voice,
+			//and their size in decoded bytes. Set before OpenStream().
+			void SetDecodeAhead(int numBuffers, u32 bufferSize);
+
+			static const int s_maxStreamBuffers = 8;
+			static const int s_defaultStreamBuffers = 3;
+			static const u32 s_defaultStreamBufferSize = (1024 * 256);
+
 		protected:
-			static const int s_streamBufferSize = (1024 * 256);
-			static const int s_numStreamBuffers = 3;
 
 			void StreamThreadOpen();
 			void StreamThreadClose();
-			void StreamThreadReadNextBuffer();
+			bool StreamThreadReadNextBuffer();
 
 			friend class StreamingThread;
 
@@ -44,10 +63,20 @@ namespace ion
 			FileReader& m_fileReader;
 			bool m_loop;
 			Buffer* m_buffer;
-			Buffer* m_streamBuffers[s_numStreamBuffers];
+			Buffer* m_streamBuffers[s_maxStreamBuffers];
+			int m_numStreamBuffers;
+			u32 m_streamBufferSize;
+
+			//Streaming buffers cycle from free, to filled by the streaming thread, to the voice, and back to free
+			ion::Queue<Buffer*, s_maxStreamBuffers> m_freeBuffers;
+			ion::Queue<Buffer*, s_maxStreamBuffers> m_filledBuffers;
+			u32 m_starvationCount;
+
+			//Set by streaming thread after the last buffer is queued
+			std::atomic<bool> m_endOfStream;
 
-			u32 m_bufferIdxProducer;
-			u32 m_bufferIdxConsumer;
+			//Read jobs queued but not yet run by the streaming thread
+			std::atomic<u32> m_pendingReads;
 
 			OnStreamOpened m_onOpenedCallback;
 			OnStreamClosed m_onClosedCallback;
@@ -89,7 +118,6 @@ namespace ion
 
 			ion::Queue<Job, s_maxJobs> m_jobs;
 			ion::thread::Semaphore m_jobSemaphore;
-			ion::thread::CriticalSection m_jobCriticalSection;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,400 @@
+#include "MixKernels.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ION_MIX_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ION_MIX_NEON
+#include <arm_neon.h>
+#endif
+
+namespace ion
+{
+	namespace audio
+	{
+		namespace mix
+		{
+			//Same scale both ways so PCM16 round trips exactly, full scale positive clamps to 32767
+			static const float s_pcm16ToFloat = 1.0f / 32768.0f;
+			static const float s_floatToPCM16 = 32768.0f;
+
+			void ConvertPCM16ToFloat(const s16* source, float* dest, u32 count)
+			{
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				const __m128 scale = _mm_set1_ps(s_pcm16ToFloat);
+				for(; i + 8 <= count; i += 8)
+				{
+					//Sign extend by unpacking into the high half and shifting down
+					__m128i samples = _mm_loadu_si128((const __m128i*)(source + i));
+					__m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+					__m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+					_mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+					_mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+				}
+#elif defined ION_MIX_NEON
+				for(; i + 8 <= count; i += 8)
+				{
+					int16x8_t samples = vld1q_s16(source + i);
+					vst1q_f32(dest + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), s_pcm16ToFloat));
+					vst1q_f32(dest + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), s_pcm16ToFloat));
+				}
+#endif
+
+				for(; i < count; i++)
+				{
+					dest[i] = (float)source[i] * s_pcm16ToFloat;
+				}
+			}
+
+			void ConvertPCM8ToFloat(const u8* source, float* dest, u32 count)
+			{
+				//8 bit PCM is unsigned, centred on 128
+				for(u32 i = 0; i < count; i++)
+				{
+					dest[i] = (float)((int)source[i] - 128) * (1.0f / 128.0f);
+				}
+			}
+
+			void ConvertFloatToPCM16(const float* source, s16* dest, u32 count)
+			{
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				//Clamp first, out of range floats convert to 0x80000000. Round to nearest, pack saturates to s16 range.
+				const __m128 scale = _mm_set1_ps(s_floatToPCM16);
+				const __m128 minValue = _mm_set1_ps(-32768.0f);
+				const __m128 maxValue = _mm_set1_ps(32767.0f);
+				for(; i + 8 <= count; i += 8)
+				{
+					__m128i low = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(source + i), scale), minValue), maxValue));
+					__m128i high = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(source + i + 4), scale), minValue), maxValue));
+					_mm_storeu_si128((__m128i*)(dest + i), _mm_packs_epi32(low, high));
+				}
+#elif defined ION_MIX_NEON
+				for(; i + 8 <= count; i += 8)
+				{
+					int32x4_t low = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(source + i), s_floatToPCM16));
+					int32x4_t high = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(source + i + 4), s_floatToPCM16));
+					vst1q_s16(dest + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+				}
+#endif
+
+				for(; i < count; i++)
+				{
+					float value = nearbyintf(source[i] * s_floatToPCM16);
+					value = (value > 32767.0f) ? 32767.0f : ((value < -32768.0f) ? -32768.0f : value);
+					dest[i] = (s16)value;
+				}
+			}
+
+			void MixMonoToStereo(float* bus, const float* source, u32 numFrames, float gainLeft, float gainRight)
+			{
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				const __m128 gain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+				for(; i + 4 <= numFrames; i += 4)
+				{
+					//Duplicate each mono sample to left and right
+					__m128 samples = _mm_loadu_ps(source + i);
+					__m128 low = _mm_unpacklo_ps(samples, samples);
+					__m128 high = _mm_unpackhi_ps(samples, samples);
+					float* out = bus + (i * 2);
+					_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(low, gain)));
+					_mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(high, gain)));
+				}
+#elif defined ION_MIX_NEON
+				const float gains[4] = { gainLeft, gainRight, gainLeft, gainRight };
+				const float32x4_t gain = vld1q_f32(gains);
+				for(; i + 4 <= numFrames; i += 4)
+				{
+					float32x4_t samples = vld1q_f32(source + i);
+					float32x4x2_t duplicated = vzipq_f32(samples, samples);
+					float* out = bus + (i * 2);
+					vst1q_f32(out, vmlaq_f32(vld1q_f32(out), duplicated.val[0], gain));
+					vst1q_f32(out + 4, vmlaq_f32(vld1q_f32(out + 4), duplicated.val[1], gain));
+				}
+#endif
+
+				for(; i < numFrames; i++)
+				{
+					bus[(i * 2)] += source[i] * gainLeft;
+					bus[(i * 2) + 1] += source[i] * gainRight;
+				}
+			}
+
+			void MixStereo(float* bus, const float* source, u32 numFrames, float gainLeft, float gainRight)
+			{
+				const u32 count = numFrames * 2;
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				const __m128 gain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+				for(; i + 4 <= count; i += 4)
+				{
+					_mm_storeu_ps(bus + i, _mm_add_ps(_mm_loadu_ps(bus + i), _mm_mul_ps(_mm_loadu_ps(source + i), gain)));
+				}
+#elif defined ION_MIX_NEON
+				const float gains[4] = { gainLeft, gainRight, gainLeft, gainRight };
+				const float32x4_t gain = vld1q_f32(gains);
+				for(; i + 4 <= count; i += 4)
+				{
+					vst1q_f32(bus + i, vmlaq_f32(vld1q_f32(bus + i), vld1q_f32(source + i), gain));
+				}
+#endif
+
+				for(; i < count; i += 2)
+				{
+					bus[i] += source[i] * gainLeft;
+					bus[i + 1] += source[i + 1] * gainRight;
+				}
+			}
+
+			void MixMonoToStereoRamp(float* bus, const float* source, u32 numFrames, float startLeft, float startRight, float endLeft, float endRight)
+			{
+				const float deltaLeft = (endLeft - startLeft) / (float)numFrames;
+				const float deltaRight = (endRight - startRight) / (float)numFrames;
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				//Gains for two frames per register, stepped four frames per iteration
+				__m128 gainLow = _mm_setr_ps(startLeft, startRight, startLeft + deltaLeft, startRight + deltaRight);
+				__m128 gainHigh = _mm_add_ps(gainLow, _mm_setr_ps(deltaLeft * 2.0f, deltaRight * 2.0f, deltaLeft * 2.0f, deltaRight * 2.0f));
+				const __m128 gainStep = _mm_setr_ps(deltaLeft * 4.0f, deltaRight * 4.0f, deltaLeft * 4.0f, deltaRight * 4.0f);
+				for(; i + 4 <= numFrames; i += 4)
+				{
+					__m128 samples = _mm_loadu_ps(source + i);
+					__m128 low = _mm_unpacklo_ps(samples, samples);
+					__m128 high = _mm_unpackhi_ps(samples, samples);
+					float* out = bus + (i * 2);
+					_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(low, gainLow)));
+					_mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(high, gainHigh)));
+					gainLow = _mm_add_ps(gainLow, gainStep);
+					gainHigh = _mm_add_ps(gainHigh, gainStep);
+				}
+#elif defined ION_MIX_NEON
+				const float gains[4] = { startLeft, startRight, startLeft + deltaLeft, startRight + deltaRight };
+				const float steps[4] = { deltaLeft * 4.0f, deltaRight * 4.0f, deltaLeft * 4.0f, deltaRight * 4.0f };
+				float32x4_t gainLow = vld1q_f32(gains);
+				float32x4_t gainHigh = vaddq_f32(gainLow, vmulq_n_f32(vld1q_f32(steps), 0.5f));
+				const float32x4_t gainStep = vld1q_f32(steps);
+				for(; i + 4 <= numFrames; i += 4)
+				{
+					float32x4_t samples = vld1q_f32(source + i);
+					float32x4x2_t duplicated = vzipq_f32(samples, samples);
+					float* out = bus + (i * 2);
+					vst1q_f32(out, vmlaq_f32(vld1q_f32(out), duplicated.val[0], gainLow));
+					vst1q_f32(out + 4, vmlaq_f32(vld1q_f32(out + 4), duplicated.val[1], gainHigh));
+					gainLow = vaddq_f32(gainLow, gainStep);
+					gainHigh = vaddq_f32(gainHigh, gainStep);
+				}
+#endif
+
+				for(; i < numFrames; i++)
+				{
+					bus[(i * 2)] += source[i] * (startLeft + (deltaLeft * (float)i));
+					bus[(i * 2) + 1] += source[i] * (startRight + (deltaRight * (float)i));
+				}
+			}
+
+			void MixStereoRamp(float* bus, const float* source, u32 numFrames, float startLeft, float startRight, float endLeft, float endRight)
+			{
+				const float deltaLeft = (endLeft - startLeft) / (float)numFrames;
+				const float deltaRight = (endRight - startRight) / (float)numFrames;
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				__m128 gain = _mm_setr_ps(startLeft, startRight, startLeft + deltaLeft, startRight + deltaRight);
+				const __m128 gainStep = _mm_setr_ps(deltaLeft * 2.0f, deltaRight * 2.0f, deltaLeft * 2.0f, deltaRight * 2.0f);
+				for(; i + 2 <= numFrames; i += 2)
+				{
+					float* out = bus + (i * 2);
+					_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(_mm_loadu_ps(source + (i * 2)), gain)));
+					gain = _mm_add_ps(gain, gainStep);
+				}
+#elif defined ION_MIX_NEON
+				const float gains[4] = { startLeft, startRight, startLeft + deltaLeft, startRight + deltaRight };
+				const float steps[4] = { deltaLeft * 2.0f, deltaRight * 2.0f, deltaLeft * 2.0f, deltaRight * 2.0f };
+				float32x4_t gain = vld1q_f32(gains);
+				const float32x4_t gainStep = vld1q_f32(steps);
+				for(; i + 2 <= numFrames; i += 2)
+				{
+					float* out = bus + (i * 2);
+					vst1q_f32(out, vmlaq_f32(vld1q_f32(out), vld1q_f32(source + (i * 2)), gain));
+					gain = vaddq_f32(gain, gainStep);
+				}
+#endif
+
+				for(; i < numFrames; i++)
+				{
+					bus[(i * 2)] += source[(i * 2)] * (startLeft + (deltaLeft * (float)i));
+					bus[(i * 2) + 1] += source[(i * 2) + 1] * (startRight + (deltaRight * (float)i));
+				}
+			}
+
+			void ScaleRamp(float* samples, u32 numFrames, u32 numChannels, float startGain, float endGain)
+			{
+				const float delta = (endGain - startGain) / (float)numFrames;
+				const u32 count = numFrames * numChannels;
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				//Four samples per iteration, one or two frames' gain each
+				__m128 gain = (numChannels == 1)
+					? _mm_setr_ps(startGain, startGain + delta, startGain + (delta * 2.0f), startGain + (delta * 3.0f))
+					: _mm_setr_ps(startGain, startGain, startGain + delta, startGain + delta);
+				const __m128 gainStep = _mm_set1_ps(delta * (float)(4 / numChannels));
+				for(; i + 4 <= count; i += 4)
+				{
+					_mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), gain));
+					gain = _mm_add_ps(gain, gainStep);
+				}
+#elif defined ION_MIX_NEON
+				const float monoGains[4] = { startGain, startGain + delta, startGain + (delta * 2.0f), startGain + (delta * 3.0f) };
+				const float stereoGains[4] = { startGain, startGain, startGain + delta, startGain + delta };
+				float32x4_t gain = vld1q_f32((numChannels == 1) ? monoGains : stereoGains);
+				const float32x4_t gainStep = vdupq_n_f32(delta * (float)(4 / numChannels));
+				for(; i + 4 <= count; i += 4)
+				{
+					vst1q_f32(samples + i, vmulq_f32(vld1q_f32(samples + i), gain));
+					gain = vaddq_f32(gain, gainStep);
+				}
+#endif
+
+				for(; i < count; i++)
+				{
+					samples[i] *= startGain + (delta * (float)(i / numChannels));
+				}
+			}
+
+			//Catmull-Rom weights for taps -1, 0, 1, 2 as cubics in t, highest power first
+			static const float s_cubic3[4] = { -0.5f, 1.5f, -1.5f, 0.5f };
+			static const float s_cubic2[4] = { 1.0f, -2.5f, 2.0f, -0.5f };
+			static const float s_cubic1[4] = { -0.5f, 0.0f, 0.5f, 0.0f };
+			static const float s_cubic0[4] = { 0.0f, 1.0f, 0.0f, 0.0f };
+
+			static const u64 s_resampleFractionMask = s_resampleUnityStep - 1;
+			static const float s_resampleFractionScale = 1.0f / (float)s_resampleUnityStep;
+
+			u32 GetResampleInputFrames(u32 numFrames, u64 position, u64 step)
+			{
+				return (numFrames > 0) ? (u32)((position + ((u64)(numFrames - 1) * step)) >> s_resampleFractionBits) + 4 : 0;
+			}
+
+			u32 GetResampleOutputFrames(u32 numInputFrames, u64 position, u64 step)
+			{
+				//Frames where the last tap is inside the input
+				u64 end = (numInputFrames > 3) ? ((u64)(numInputFrames - 3) << s_resampleFractionBits) : 0;
+				return (end > position) ? (u32)((end - position + step - 1) / step) : 0;
+			}
+
+			void ResampleCubicMono(const float* input, float* output, u32 numFrames, u64 position, u64 step)
+			{
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				const __m128 cubic3 = _mm_loadu_ps(s_cubic3);
+				const __m128 cubic2 = _mm_loadu_ps(s_cubic2);
+				const __m128 cubic1 = _mm_loadu_ps(s_cubic1);
+				const __m128 cubic0 = _mm_loadu_ps(s_cubic0);
+				for(; i < numFrames; i++, position += step)
+				{
+					//All four tap weights at once, taps are contiguous
+					__m128 t = _mm_set1_ps((float)(position & s_resampleFractionMask) * s_resampleFractionScale);
+					__m128 weights = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(cubic3, t), cubic2), t), cubic1), t), cubic0);
+					__m128 products = _mm_mul_ps(_mm_loadu_ps(input + (position >> s_resampleFractionBits)), weights);
+					products = _mm_add_ps(products, _mm_movehl_ps(products, products));
+					_mm_store_ss(output + i, _mm_add_ss(products, _mm_shuffle_ps(products, products, 1)));
+				}
+#elif defined ION_MIX_NEON
+				const float32x4_t cubic3 = vld1q_f32(s_cubic3);
+				const float32x4_t cubic2 = vld1q_f32(s_cubic2);
+				const float32x4_t cubic1 = vld1q_f32(s_cubic1);
+				const float32x4_t cubic0 = vld1q_f32(s_cubic0);
+				for(; i < numFrames; i++, position += step)
+				{
+					float t = (float)(position & s_resampleFractionMask) * s_resampleFractionScale;
+					float32x4_t weights = vmlaq_n_f32(cubic0, vmlaq_n_f32(cubic1, vmlaq_n_f32(cubic2, cubic3, t), t), t);
+					float32x4_t products = vmulq_f32(vld1q_f32(input + (position >> s_resampleFractionBits)), weights);
+					float32x2_t sum = vadd_f32(vget_low_f32(products), vget_high_f32(products));
+					output[i] = vget_lane_f32(vpadd_f32(sum, sum), 0);
+				}
+#endif
+
+				for(; i < numFrames; i++, position += step)
+				{
+					float t = (float)(position & s_resampleFractionMask) * s_resampleFractionScale;
+					const float* taps = input + (position >> s_resampleFractionBits);
+					float sample = 0.0f;
+
+					for(int tap = 0; tap < 4; tap++)
+					{
+						sample += taps[tap] * ((((s_cubic3[tap] * t) + s_cubic2[tap]) * t + s_cubic1[tap]) * t + s_cubic0[tap]);
+					}
+
+					output[i] = sample;
+				}
+			}
+
+			void ResampleCubicStereo(const float* input, float* output, u32 numFrames, u64 position, u64 step)
+			{
+				u32 i = 0;
+
+#if defined ION_MIX_SSE2
+				const __m128 cubic3 = _mm_loadu_ps(s_cubic3);
+				const __m128 cubic2 = _mm_loadu_ps(s_cubic2);
+				const __m128 cubic1 = _mm_loadu_ps(s_cubic1);
+				const __m128 cubic0 = _mm_loadu_ps(s_cubic0);
+				for(; i < numFrames; i++, position += step)
+				{
+					__m128 t = _mm_set1_ps((float)(position & s_resampleFractionMask) * s_resampleFractionScale);
+					__m128 weights = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(cubic3, t), cubic2), t), cubic1), t), cubic0);
+
+					//Taps -1, 0 and 1, 2 as left/right pairs, weights duplicated to match
+					const float* taps = input + ((position >> s_resampleFractionBits) * 2);
+					__m128 products = _mm_add_ps(
+						_mm_mul_ps(_mm_loadu_ps(taps), _mm_unpacklo_ps(weights, weights)),
+						_mm_mul_ps(_mm_loadu_ps(taps + 4), _mm_unpackhi_ps(weights, weights)));
+					_mm_storel_pi((__m64*)(output + (i * 2)), _mm_add_ps(products, _mm_movehl_ps(products, products)));
+				}
+#elif defined ION_MIX_NEON
+				const float32x4_t cubic3 = vld1q_f32(s_cubic3);
+				const float32x4_t cubic2 = vld1q_f32(s_cubic2);
+				const float32x4_t cubic1 = vld1q_f32(s_cubic1);
+				const float32x4_t cubic0 = vld1q_f32(s_cubic0);
+				for(; i < numFrames; i++, position += step)
+				{
+					float t = (float)(position & s_resampleFractionMask) * s_resampleFractionScale;
+					float32x4_t weights = vmlaq_n_f32(cubic0, vmlaq_n_f32(cubic1, vmlaq_n_f32(cubic2, cubic3, t), t), t);
+					float32x4x2_t pairs = vzipq_f32(weights, weights);
+					const float* taps = input + ((position >> s_resampleFractionBits) * 2);
+					float32x4_t products = vmlaq_f32(vmulq_f32(vld1q_f32(taps), pairs.val[0]), vld1q_f32(taps + 4), pairs.val[1]);
+					vst1_f32(output + (i * 2), vadd_f32(vget_low_f32(products), vget_high_f32(products)));
+				}
+#endif
+
+				for(; i < numFrames; i++, position += step)
+				{
+					float t = (float)(position & s_resampleFractionMask) * s_resampleFractionScale;
+					const float* taps = input + ((position >> s_resampleFractionBits) * 2);
+					float left = 0.0f;
+					float right = 0.0f;
+
+					for(int tap = 0; tap < 4; tap++)
+					{
+						float weight = (((s_cubic3[tap] * t) + s_cubic2[tap]) * t + s_cubic1[tap]) * t + s_cubic0[tap];
+						left += taps[(tap * 2)] * weight;
+						right += taps[(tap * 2) + 1] * weight;
+					}
+
+					output[(i * 2)] = left;
+					output[(i * 2) + 1] = right;
+				}
+			}
+		}
+	}
+}
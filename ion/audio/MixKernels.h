@@ -0,0 +1,46 @@
+#pragma once
+
+#include <core/Types.h>
+
+namespace ion
+{
+	namespace audio
+	{
+		//Block kernels for the software mixer. Mix bus is interleaved stereo float, full scale is [-1, 1].
+		namespace mix
+		{
+			//Source PCM to float, count is in samples (frames * channels)
+			void ConvertPCM16ToFloat(const s16* source, float* dest, u32 count);
+			void ConvertPCM8ToFloat(const u8* source, float* dest, u32 count);
+
+			//Float to device PCM, clipped to full scale
+			void ConvertFloatToPCM16(const float* source, s16* dest, u32 count);
+
+			//Scale and accumulate into stereo bus
+			void MixMonoToStereo(float* bus, const float* source, u32 numFrames, float gainLeft, float gainRight);
+			void MixStereo(float* bus, const float* source, u32 numFrames, float gainLeft, float gainRight);
+
+			//As above, gain ramps linearly from start at the first frame towards end, reaching it at the next block's first frame
+			void MixMonoToStereoRamp(float* bus, const float* source, u32 numFrames, float startLeft, float startRight, float endLeft, float endRight);
+			void MixStereoRamp(float* bus, const float* source, u32 numFrames, float startLeft, float startRight, float endLeft, float endRight);
+
+			//Scale in place, gain ramping as above. numChannels is 1 or 2.
+			void ScaleRamp(float* samples, u32 numFrames, u32 numChannels, float startGain, float endGain);
+
+			//Resampling positions and steps are 32.32 fixed point source frames
+			static const u32 s_resampleFractionBits = 32;
+			static const u64 s_resampleUnityStep = (1ull << s_resampleFractionBits);
+
+			//Input frames needed to resample numFrames from position, including one frame of history before it
+			u32 GetResampleInputFrames(u32 numFrames, u64 position, u64 step);
+
+			//Output frames available from numInputFrames, including the history frame
+			u32 GetResampleOutputFrames(u32 numInputFrames, u64 position, u64 step);
+
+			//Catmull-Rom cubic interpolation of interleaved frames. Position 0 is input frame 1, frame 0 is history.
+			//Output frame n is at position + (n * step).
+			void ResampleCubicMono(const float* input, float* output, u32 numFrames, u64 position, u64 step);
+			void ResampleCubicStereo(const float* input, float* output, u32 numFrames, u64 position, u64 step);
+		}
+	}
+}
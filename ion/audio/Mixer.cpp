@@ -0,0 +1,216 @@
+#include "Mixer.h"
+#include "MixerVoice.h"
+#include "MixKernels.h"
+
+#include <core/debug/Debug.h>
+#include <core/memory/Memory.h>
+#include <core/thread/Atomic.h>
+#include <core/thread/RealTime.h>
+#include <core/thread/Sleep.h>
+#include <core/thread/Thread.h>
+#include <core/utils/STL.h>
+#include <maths/Maths.h>
+
+namespace ion
+{
+	namespace audio
+	{
+		//Expected voice count, avoids growing the lists on every add
+		static const int s_reservedVoices = 64;
+
+		class Mixer::FeedThread : public thread::Thread
+		{
+		public:
+			FeedThread(Mixer& mixer)
+				: thread::Thread("AudioFeed")
+				, m_mixer(mixer)
+				, m_running(true)
+			{
+			}
+
+			void RequestStop()
+			{
+				m_running = false;
+			}
+
+		protected:
+			virtual void Entry()
+			{
+				while (m_running)
+				{
+					m_mixer.Feed();
+					thread::Sleep(s_feedIntervalMs);
+				}
+			}
+
+		private:
+			Mixer& m_mixer;
+			std::atomic<bool> m_running;
+		};
+
+		Mixer::Mixer(u32 sampleRate)
+		{
+			m_sampleRate = sampleRate;
+			m_starvationCount = 0;
+			m_activeVoiceList = 0;
+			m_mixing = 0;
+			m_mixCount = 0;
+			m_offlineFeed = false;
+			m_voiceLists[0].reserve(s_reservedVoices);
+			m_voiceLists[1].reserve(s_reservedVoices);
+			m_bus.resize(s_blockFrames * s_numChannels);
+			m_scratch.resize(s_blockFrames * MixerVoice::s_maxChannels);
+
+			m_feedThread = new FeedThread(*this);
+			m_feedThread->Run();
+		}
+
+		Mixer::~Mixer()
+		{
+			m_feedThread->RequestStop();
+			m_feedThread->Join();
+			delete m_feedThread;
+		}
+
+		u32 Mixer::GetSampleRate() const
+		{
+			return m_sampleRate;
+		}
+
+		u32 Mixer::GetStarvationCount() const
+		{
+			return m_starvationCount;
+		}
+
+		void Mixer::AddVoice(MixerVoice& voice)
+		{
+			m_voiceListCritSec.Begin();
+			u32 listIdx = 1 - m_activeVoiceList;
+			m_voiceLists[listIdx] = m_voiceLists[m_activeVoiceList];
+			m_voiceLists[listIdx].push_back(&voice);
+			PublishVoiceList(listIdx);
+			m_voiceListCritSec.End();
+		}
+
+		void Mixer::RemoveVoice(MixerVoice& voice)
+		{
+			m_voiceListCritSec.Begin();
+			u32 listIdx = 1 - m_activeVoiceList;
+			m_voiceLists[listIdx] = m_voiceLists[m_activeVoiceList];
+			ion::utils::stl::FindAndRemove(m_voiceLists[listIdx], &voice);
+			PublishVoiceList(listIdx);
+			m_voiceListCritSec.End();
+		}
+
+		void Mixer::PublishVoiceList(u32 listIdx)
+		{
+			m_activeVoiceList = listIdx;
+
+			//If the mixer thread is mid block it may have the old list, wait for that block to end.
+			//Both sides use sequentially consistent ops, so either it sees the new list or we see it mixing.
+			u32 mixCount = m_mixCount;
+			while (m_mixing && (m_mixCount == mixCount))
+			{
+				thread::Sleep(0);
+			}
+		}
+
+		void Mixer::Feed()
+		{
+			m_voiceListCritSec.Begin();
+
+			if (!m_offlineFeed)
+			{
+				FeedVoices(false);
+			}
+
+			m_voiceListCritSec.End();
+		}
+
+		void Mixer::BeginOfflineFeed()
+		{
+			m_voiceListCritSec.Begin();
+			m_offlineFeed = true;
+			m_voiceListCritSec.End();
+		}
+
+		void Mixer::FeedOffline()
+		{
+			m_voiceListCritSec.Begin();
+			debug::Assert(m_offlineFeed, "Mixer::FeedOffline() - Not between BeginOfflineFeed() and EndOfflineFeed()");
+			FeedVoices(true);
+			m_voiceListCritSec.End();
+		}
+
+		void Mixer::EndOfflineFeed()
+		{
+			m_voiceListCritSec.Begin();
+			m_offlineFeed = false;
+			m_voiceListCritSec.End();
+		}
+
+		void Mixer::FeedVoices(bool waitForSources)
+		{
+			const std::vector<MixerVoice*>& voices = m_voiceLists[m_activeVoiceList];
+			for (int i = 0; i < voices.size(); i++)
+			{
+				voices[i]->Feed(waitForSources);
+			}
+		}
+
+		const std::vector<MixerVoice*>& Mixer::BeginMix()
+		{
+			m_mixing = 1;
+			return m_voiceLists[m_activeVoiceList];
+		}
+
+		void Mixer::EndMix()
+		{
+			m_mixCount++;
+			m_mixing = 0;
+		}
+
+		void Mixer::Mix(float* output, u32 numFrames)
+		{
+			thread::realtime::Scope realTimeScope;
+			const std::vector<MixerVoice*>& voices = BeginMix();
+
+			for (u32 frame = 0; frame < numFrames; frame += s_blockFrames)
+			{
+				u32 blockFrames = maths::Min(s_blockFrames, numFrames - frame);
+				MixBlock(voices, output + (frame * s_numChannels), blockFrames);
+			}
+
+			EndMix();
+		}
+
+		void Mixer::Mix(s16* output, u32 numFrames)
+		{
+			thread::realtime::Scope realTimeScope;
+			const std::vector<MixerVoice*>& voices = BeginMix();
+
+			//Mix in float, convert to device format once per block
+			for (u32 frame = 0; frame < numFrames; frame += s_blockFrames)
+			{
+				u32 blockFrames = maths::Min(s_blockFrames, numFrames - frame);
+				MixBlock(voices, m_bus.data(), blockFrames);
+				mix::ConvertFloatToPCM16(m_bus.data(), output + (frame * s_numChannels), blockFrames * s_numChannels);
+			}
+
+			EndMix();
+		}
+
+		void Mixer::MixBlock(const std::vector<MixerVoice*>& voices, float* bus, u32 numFrames)
+		{
+			memory::MemSet(bus, 0, numFrames * s_numChannels * sizeof(float));
+
+			for (int i = 0; i < voices.size(); i++)
+			{
+				if (!voices[i]->Mix(bus, m_scratch.data(), numFrames))
+				{
+					thread::atomic::Increment(m_starvationCount);
+				}
+			}
+		}
+	}
+}
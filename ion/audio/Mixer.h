@@ -0,0 +1,86 @@
+#pragma once
+
+#include <core/Types.h>
+#include <core/thread/CriticalSection.h>
+
+#include <atomic>
+#include <vector>
+
+namespace ion
+{
+	namespace audio
+	{
+		class MixerVoice;
+
+		//Mixes all playing MixerVoices into one interleaved stereo output, for backends with a single output device.
+		//Mix() is real-time safe: it takes no locks, makes no allocations and never calls into sources.
+		class Mixer
+		{
+		public:
+			static const u32 s_numChannels = 2;
+			static const u32 s_blockFrames = 256;
+
+			//Feed thread wake interval, well inside MixerVoice::s_ringFrames
+			static const u32 s_feedIntervalMs = 5;
+
+			Mixer(u32 sampleRate);
+			~Mixer();
+
+			u32 GetSampleRate() const;
+
+			//Publishes the new voice list to the mixer thread, and returns once it has stopped using the old one
+			void AddVoice(MixerVoice& voice);
+			void RemoveVoice(MixerVoice& voice);
+
+			//Top up all voices' PCM rings from their sources. Runs on the feed thread, does nothing while offline feeding.
+			void Feed();
+
+			//Offline devices take over feeding from the feed thread, and call FeedOffline() between blocks.
+			//It waits for sources' queued reads first, so streaming voices never starve and neither the
+			//output nor the starvation counts depend on how the streaming thread was scheduled.
+			void BeginOfflineFeed();
+			void FeedOffline();
+			void EndOfflineFeed();
+
+			//Mix next numFrames of all playing voices, called from the output device's thread
+			void Mix(float* output, u32 numFrames);
+			void Mix(s16* output, u32 numFrames);
+
+			//Number of times a playing voice ran out of frames mid block
+			u32 GetStarvationCount() const;
+
+		private:
+			class FeedThread;
+
+			void FeedVoices(bool waitForSources);
+			void MixBlock(const std::vector<MixerVoice*>& voices, float* bus, u32 numFrames);
+
+			//Mixer thread brackets
+			const std::vector<MixerVoice*>& BeginMix();
+			void EndMix();
+
+			//Writer side, swap edited list in and wait for mixer thread to let go of the old one
+			void PublishVoiceList(u32 listIdx);
+
+			u32 m_sampleRate;
+			u32 m_starvationCount;
+
+			//Double buffered voice list. Writers edit the inactive list under m_voiceListCritSec,
+			//the mixer thread only reads the active one.
+			std::vector<MixerVoice*> m_voiceLists[2];
+			std::atomic<u32> m_activeVoiceList;
+			std::atomic<u32> m_mixing;
+			std::atomic<u32> m_mixCount;
+			ion::thread::CriticalSection m_voiceListCritSec;
+
+			//Feed thread stands down while set, under m_voiceListCritSec
+			bool m_offlineFeed;
+
+			//Float bus for device format conversion, and per voice source frames
+			std::vector<float> m_bus;
+			std::vector<float> m_scratch;
+
+			FeedThread* m_feedThread;
+		};
+	}
+}
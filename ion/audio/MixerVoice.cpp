@@ -0,0 +1,498 @@
+#include "MixerVoice.h"
+#include "Mixer.h"
+#include "MixKernels.h"
+#include "Buffer.h"
+#include "Effect.h"
+#include "Source.h"
+#include "StreamDesc.h"
+
+#include <core/debug/Debug.h>
+#include <core/memory/Memory.h>
+#include <core/thread/Atomic.h>
+#include <core/thread/Sleep.h>
+#include <maths/Maths.h>
+
+#include <cstring>
+
+namespace ion
+{
+	namespace audio
+	{
+		MixerVoice::MixerVoice(Source& source, bool loop, u32 outputSampleRate)
+			: Voice(source, loop)
+			, m_ring(s_ringFrames, source.GetStreamDesc()->GetNumChannels())
+		{
+			const StreamDesc* streamDesc = source.GetStreamDesc();
+
+			m_currentBuffer = nullptr;
+			m_bufferPos = 0;
+			m_bufferFrames = 0;
+			m_sourceFinished = false;
+			m_numChannels = streamDesc->GetNumChannels();
+			m_bytesPerSample = streamDesc->GetBitsPerSample() / 8;
+			m_sourceSampleRate = streamDesc->GetSampleRate();
+			m_outputSampleRate = outputSampleRate;
+			m_position = 0;
+			m_tailPadded = false;
+			m_paddingFrames = 0;
+			m_gainLeft = 0.0f;
+			m_gainRight = 0.0f;
+			m_gainsValid = false;
+			m_numEffects[0] = 0;
+			m_numEffects[1] = 0;
+			m_activeEffectChain = 0;
+			m_mixing = 0;
+			m_mixCount = 0;
+			m_buffersQueued = 0;
+			m_bytesBuffered = 0;
+			m_bytesConsumed = 0;
+			m_starvationCount = 0;
+			m_framesPlayed = 0;
+
+			debug::Assert(m_numChannels > 0 && m_numChannels <= s_maxChannels, "MixerVoice::MixerVoice() - Unsupported channel count");
+			debug::Assert(m_bytesPerSample == 1 || m_bytesPerSample == 2, "MixerVoice::MixerVoice() - Unsupported bits per sample");
+
+			//A single buffer source resubmits its one buffer when looping
+			m_maxQueuedBuffers = (source.GetFeedType() == Source::FeedType::SingleBuffer) ? 1 : s_numStreamingBuffers;
+
+			//Resampler input for a whole block at the highest step, plus filter taps and an unconsumed whole frame.
+			//Starts with one silent history frame.
+			m_inputCapacity = (Mixer::s_blockFrames * s_maxStep) + s_maxStep + 4;
+			m_input.resize(m_inputCapacity * m_numChannels, 0.0f);
+			m_inputFrames = 1;
+
+			//Set default properties
+			SetVolume(1.0f);
+			SetPitch(1.0f);
+			SetPan(0.0f);
+
+			//Fill ring before first mix
+			Feed(false);
+		}
+
+		MixerVoice::~MixerVoice()
+		{
+			//Return held buffers
+			if (m_currentBuffer)
+			{
+				m_currentBuffer->ReadUnlock();
+				m_source.ReleaseBuffer(*m_currentBuffer);
+			}
+
+			Buffer* buffer = nullptr;
+			while (m_bufferQueue.TryPop(buffer))
+			{
+				buffer->ReadUnlock();
+				m_source.ReleaseBuffer(*buffer);
+			}
+		}
+
+		void MixerVoice::SubmitBuffer(Buffer& buffer)
+		{
+			//Lock buffer until finished with
+			buffer.ReadLock();
+
+			if (m_bufferQueue.TryPush(&buffer))
+			{
+				thread::atomic::Add(m_bytesBuffered, buffer.GetDataSize());
+				thread::atomic::Increment(m_buffersQueued);
+			}
+			else
+			{
+				buffer.ReadUnlock();
+				m_source.ReleaseBuffer(buffer);
+				debug::error << "MixerVoice::SubmitBuffer() - Buffer queue full, buffer dropped" << debug::end;
+			}
+		}
+
+		void MixerVoice::Play()
+		{
+			m_state = State::Playing;
+		}
+
+		void MixerVoice::Stop()
+		{
+			m_state = State::Stopped;
+		}
+
+		void MixerVoice::Pause()
+		{
+			m_state = State::Paused;
+		}
+
+		void MixerVoice::Resume()
+		{
+			m_state = State::Playing;
+		}
+
+		u32 MixerVoice::GetQueuedBuffers()
+		{
+			return m_buffersQueued;
+		}
+
+		u32 MixerVoice::GetBufferedBytes()
+		{
+			return m_bytesBuffered;
+		}
+
+		u32 MixerVoice::GetConsumedBytes()
+		{
+			return m_bytesConsumed;
+		}
+
+		u64 MixerVoice::GetPositionSamples()
+		{
+			return m_framesPlayed;
+		}
+
+		double MixerVoice::GetPositionSeconds()
+		{
+			return (double)m_framesPlayed / (double)m_sourceSampleRate;
+		}
+
+		u32 MixerVoice::GetStarvationCount() const
+		{
+			return m_starvationCount;
+		}
+
+		void MixerVoice::SetVolume(float volume)
+		{
+			Voice::SetVolume(volume);
+			m_targetVolume.store(volume, std::memory_order_relaxed);
+		}
+
+		void MixerVoice::SetPitch(float pitch)
+		{
+			Voice::SetPitch(pitch);
+			m_targetPitch.store(pitch, std::memory_order_relaxed);
+		}
+
+		void MixerVoice::SetPan(float pan)
+		{
+			Voice::SetPan(pan);
+			m_targetPan.store(pan, std::memory_order_relaxed);
+		}
+
+		void MixerVoice::OnEffectsChanged()
+		{
+			//Build the chain the mixer thread isn't reading
+			u32 chainIdx = 1 - m_activeEffectChain;
+			int numEffects = (int)m_effects.size();
+
+			if (numEffects > s_maxEffects)
+			{
+				debug::error << "MixerVoice::OnEffectsChanged() - Too many effects, only the first " << (int)s_maxEffects << " are processed" << debug::end;
+				numEffects = s_maxEffects;
+			}
+
+			for (int i = 0; i < numEffects; i++)
+			{
+				m_effectChains[chainIdx][i] = m_effects[i];
+			}
+
+			m_numEffects[chainIdx] = numEffects;
+			m_activeEffectChain = chainIdx;
+
+			//As Mixer::PublishVoiceList(), wait for a block that may have the old chain to end.
+			//The caller deletes a destroyed effect once this returns.
+			u32 mixCount = m_mixCount;
+			while (m_mixing && (m_mixCount == mixCount))
+			{
+				thread::Sleep(0);
+			}
+		}
+
+		void MixerVoice::Feed(bool waitForSource)
+		{
+			while (m_ring.GetWritableFrames() > 0)
+			{
+				if (waitForSource)
+				{
+					//Offline, let refills of released buffers land so what's ready doesn't depend on thread timing
+					m_source.WaitForPendingReads();
+				}
+
+				RequestBuffers();
+
+				if (!m_currentBuffer && !NextBuffer())
+				{
+					if (m_source.IsEndOfStream())
+					{
+						//Streamed to the end, last frames are in the ring, mixer stops the voice once it's drained
+						m_sourceFinished.store(true, std::memory_order_release);
+					}
+
+					//Source has nothing ready, try again next feed
+					break;
+				}
+
+				u32 numFramesRegion = 0;
+				float* region = m_ring.GetWriteRegion(numFramesRegion);
+
+				u32 numFramesRun = maths::Min(numFramesRegion, m_bufferFrames - m_bufferPos);
+				ConvertFrames(m_bufferPos, numFramesRun, region);
+				m_ring.CommitWrite(numFramesRun);
+				m_bufferPos += numFramesRun;
+
+				if (m_bufferPos >= m_bufferFrames)
+				{
+					FinishBuffer();
+				}
+			}
+		}
+
+		void MixerVoice::RequestBuffers()
+		{
+			//Keep source buffers queued behind the one being converted
+			for (int i = m_buffersQueued; i < m_maxQueuedBuffers && !m_sourceFinished; i++)
+			{
+				m_source.RequestBuffer(*this);
+			}
+		}
+
+		bool MixerVoice::NextBuffer()
+		{
+			if (m_bufferQueue.TryPop(m_currentBuffer))
+			{
+				m_bufferPos = 0;
+				m_bufferFrames = m_currentBuffer->GetDataSize() / (m_numChannels * m_bytesPerSample);
+				return true;
+			}
+
+			m_currentBuffer = nullptr;
+			return false;
+		}
+
+		void MixerVoice::FinishBuffer()
+		{
+			thread::atomic::Add(m_bytesConsumed, m_currentBuffer->GetDataSize());
+			thread::atomic::Decrement(m_buffersQueued);
+
+			//Hand back for reuse
+			m_currentBuffer->ReadUnlock();
+			m_source.ReleaseBuffer(*m_currentBuffer);
+			m_currentBuffer = nullptr;
+
+			if (m_source.GetFeedType() == Source::FeedType::SingleBuffer && !m_loop)
+			{
+				//Last frames are in the ring, mixer stops the voice once it's drained
+				m_sourceFinished.store(true, std::memory_order_release);
+			}
+		}
+
+		void MixerVoice::ConvertFrames(u32 frame, u32 numFrames, float* dest)
+		{
+			const char* data = m_currentBuffer->Get(frame * m_numChannels * m_bytesPerSample);
+
+			if (m_bytesPerSample == 2)
+				mix::ConvertPCM16ToFloat((const s16*)data, dest, numFrames * m_numChannels);
+			else
+				mix::ConvertPCM8ToFloat((const u8*)data, dest, numFrames * m_numChannels);
+		}
+
+		bool MixerVoice::Mix(float* bus, float* scratch, u32 numFrames)
+		{
+			if (m_state != State::Playing)
+				return true;
+
+			//Read before checking the ring, all of the source's frames are visible once it's set
+			bool sourceFinished = m_sourceFinished.load(std::memory_order_acquire);
+
+			u32 framesRead = ReadFrames(scratch, numFrames, sourceFinished);
+
+			if (framesRead > 0)
+			{
+				ProcessEffects(scratch, framesRead);
+				MixGain(bus, scratch, framesRead);
+			}
+
+			if (framesRead < numFrames)
+			{
+				if (sourceFinished && m_ring.GetReadableFrames() == 0)
+				{
+					//Played to the end
+					StopIfPlaying();
+				}
+				else
+				{
+					//Feed thread didn't keep up, rest of block is silent
+					thread::atomic::Increment(m_starvationCount);
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		u32 MixerVoice::ReadFrames(float* dest, u32 numFrames, bool sourceFinished)
+		{
+			//Source frames per output frame
+			double ratio = ((double)m_sourceSampleRate / (double)m_outputSampleRate) * (double)m_targetPitch.load(std::memory_order_relaxed);
+			double maxRatio = (double)s_maxStep;
+			u64 step = (u64)(maths::Clamp(ratio, 0.0, maxRatio) * (double)mix::s_resampleUnityStep);
+			step = maths::Max(step, (u64)1);
+
+			if (step == mix::s_resampleUnityStep && m_position == 0)
+			{
+				//Same rate as output and on a whole frame, no filtering needed
+				return CopyFrames(dest, numFrames);
+			}
+
+			return ResampleFrames(dest, numFrames, step, sourceFinished);
+		}
+
+		u32 MixerVoice::CopyFrames(float* dest, u32 numFrames)
+		{
+			u32 framesRead = 0;
+
+			//Frames already read ahead by the resampler come first
+			if (m_inputFrames > 1)
+			{
+				framesRead = maths::Min(numFrames, m_inputFrames - 1);
+				memory::MemCopy(dest, m_input.data() + m_numChannels, framesRead * m_numChannels * sizeof(float));
+				ConsumeInput(framesRead);
+			}
+
+			u32 framesCopied = 0;
+
+			while (framesRead < numFrames)
+			{
+				u32 numFramesRegion = 0;
+				const float* region = m_ring.GetReadRegion(numFramesRegion);
+
+				if (numFramesRegion == 0)
+					break;
+
+				u32 numFramesRun = maths::Min(numFrames - framesRead, numFramesRegion);
+				memory::MemCopy(dest + (framesRead * m_numChannels), region, numFramesRun * m_numChannels * sizeof(float));
+				m_ring.CommitRead(numFramesRun);
+				framesRead += numFramesRun;
+				framesCopied += numFramesRun;
+			}
+
+			if (framesCopied > 0)
+			{
+				//Last frame played is the resampler's history if the pitch changes
+				memory::MemCopy(m_input.data(), dest + ((framesRead - 1) * m_numChannels), m_numChannels * sizeof(float));
+				m_inputFrames = 1;
+				thread::atomic::Add(m_framesPlayed, (u64)framesCopied);
+			}
+
+			return framesRead;
+		}
+
+		u32 MixerVoice::ResampleFrames(float* dest, u32 numFrames, u64 step, bool sourceFinished)
+		{
+			//Top up the input to cover the whole block
+			u32 inputFramesNeeded = maths::Min(mix::GetResampleInputFrames(numFrames, m_position, step), m_inputCapacity);
+
+			while (m_inputFrames < inputFramesNeeded && !m_tailPadded)
+			{
+				u32 numFramesRegion = 0;
+				const float* region = m_ring.GetReadRegion(numFramesRegion);
+
+				if (numFramesRegion == 0)
+					break;
+
+				u32 numFramesRun = maths::Min(inputFramesNeeded - m_inputFrames, numFramesRegion);
+				memory::MemCopy(m_input.data() + (m_inputFrames * m_numChannels), region, numFramesRun * m_numChannels * sizeof(float));
+				m_ring.CommitRead(numFramesRun);
+				m_inputFrames += numFramesRun;
+			}
+
+			if (m_inputFrames < inputFramesNeeded && !m_tailPadded && sourceFinished && m_ring.GetReadableFrames() == 0)
+			{
+				//Silence after the last frame lets the filter play up to it
+				m_paddingFrames = maths::Min((u32)2, m_inputCapacity - m_inputFrames);
+				memory::MemSet(m_input.data() + (m_inputFrames * m_numChannels), 0, m_paddingFrames * m_numChannels * sizeof(float));
+				m_inputFrames += m_paddingFrames;
+				m_tailPadded = true;
+			}
+
+			u32 framesRead = maths::Min(numFrames, mix::GetResampleOutputFrames(m_inputFrames, m_position, step));
+
+			if (framesRead > 0)
+			{
+				if (m_numChannels == 1)
+					mix::ResampleCubicMono(m_input.data(), dest, framesRead, m_position, step);
+				else
+					mix::ResampleCubicStereo(m_input.data(), dest, framesRead, m_position, step);
+
+				//Drop whole frames passed, keep the fraction
+				m_position += (u64)framesRead * step;
+				u32 framesPassed = maths::Min((u32)(m_position >> mix::s_resampleFractionBits), m_inputFrames - 1);
+				ConsumeInput(framesPassed);
+				m_position -= ((u64)framesPassed << mix::s_resampleFractionBits);
+			}
+
+			return framesRead;
+		}
+
+		void MixerVoice::ConsumeInput(u32 numFrames)
+		{
+			if (numFrames == 0)
+				return;
+
+			//Padding is always at the end, only count source frames as played
+			u32 sourceFrames = m_inputFrames - 1 - m_paddingFrames;
+			u32 framesPlayed = maths::Min(numFrames, sourceFrames);
+			m_paddingFrames -= (numFrames - framesPlayed);
+			thread::atomic::Add(m_framesPlayed, (u64)framesPlayed);
+
+			//Last frame passed becomes the history frame
+			m_inputFrames -= numFrames;
+			std::memmove(m_input.data(), m_input.data() + (numFrames * m_numChannels), m_inputFrames * m_numChannels * sizeof(float));
+		}
+
+		void MixerVoice::ProcessEffects(float* samples, u32 numFrames)
+		{
+			//Publishing a new chain waits for this to end
+			m_mixing = 1;
+
+			u32 chainIdx = m_activeEffectChain;
+			for (int i = 0; i < m_numEffects[chainIdx]; i++)
+			{
+				m_effectChains[chainIdx][i]->Process(samples, numFrames, m_numChannels, m_outputSampleRate);
+			}
+
+			m_mixCount++;
+			m_mixing = 0;
+		}
+
+		void MixerVoice::MixGain(float* bus, const float* samples, u32 numFrames)
+		{
+			//Linear pan, centre is full volume on both sides
+			float volume = m_targetVolume.load(std::memory_order_relaxed);
+			float pan = m_targetPan.load(std::memory_order_relaxed);
+			float gainLeft = volume * maths::Min(1.0f, 1.0f - pan);
+			float gainRight = volume * maths::Min(1.0f, 1.0f + pan);
+
+			if (!m_gainsValid)
+			{
+				//First block starts at the set gain
+				m_gainLeft = gainLeft;
+				m_gainRight = gainRight;
+				m_gainsValid = true;
+			}
+
+			if (gainLeft == m_gainLeft && gainRight == m_gainRight)
+			{
+				if (m_numChannels == 1)
+					mix::MixMonoToStereo(bus, samples, numFrames, gainLeft, gainRight);
+				else
+					mix::MixStereo(bus, samples, numFrames, gainLeft, gainRight);
+			}
+			else
+			{
+				//Ramp from last block's gain over this block, avoids zipper noise
+				if (m_numChannels == 1)
+					mix::MixMonoToStereoRamp(bus, samples, numFrames, m_gainLeft, m_gainRight, gainLeft, gainRight);
+				else
+					mix::MixStereoRamp(bus, samples, numFrames, m_gainLeft, m_gainRight, gainLeft, gainRight);
+
+				m_gainLeft = gainLeft;
+				m_gainRight = gainRight;
+			}
+		}
+	}
+}
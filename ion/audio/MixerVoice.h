@@ -0,0 +1,137 @@
+#pragma once
+
+#include <audio/Voice.h>
+#include <audio/PCMRing.h>
+#include <core/containers/Queue.h>
+
+#include <atomic>
+#include <vector>
+
+namespace ion
+{
+	namespace audio
+	{
+		class Buffer;
+		class Effect;
+
+		//Voice played by the engine's software Mixer instead of an OS voice.
+		//The Mixer's feed thread converts source buffers into a PCM ring, the mixer thread only reads the ring,
+		//so mixing never locks, allocates, or calls back into the source.
+		//Per block the mixer thread resamples the ring for pitch and sample rate, runs the effects chain,
+		//then mixes with gain and pan ramped from the previous block's.
+		class MixerVoice : public Voice
+		{
+			friend class Engine;
+			friend class Mixer;
+
+		public:
+			static const u32 s_maxChannels = 2;
+
+			//Decoded frames held ahead of the mixer
+			static const u32 s_ringFrames = 8192;
+
+			//Most source frames per output frame, pitch times source/output rate is clamped to it
+			static const u32 s_maxStep = 16;
+
+			static const int s_maxEffects = 8;
+
+			//Transport
+			virtual void Play();
+			virtual void Stop();
+			virtual void Pause();
+			virtual void Resume();
+
+			virtual u32 GetQueuedBuffers();
+			virtual u32 GetBufferedBytes();
+			virtual u32 GetConsumedBytes();
+			virtual u64 GetPositionSamples();
+			virtual double GetPositionSeconds();
+
+			//Number of mixed blocks the PCM ring ran dry during
+			u32 GetStarvationCount() const;
+
+			//Properties, read by the mixer thread at the start of each block
+			virtual void SetVolume(float volume);
+			virtual void SetPitch(float pitch);
+			virtual void SetPan(float pan);
+
+			//Submit buffer
+			virtual void SubmitBuffer(Buffer& buffer);
+
+		protected:
+			MixerVoice(Source& source, bool loop, u32 outputSampleRate);
+			virtual ~MixerVoice();
+
+			virtual void OnEffectsChanged();
+
+		private:
+			static const int s_numStreamingBuffers = 2;
+			static const int s_bufferQueueSize = 4;
+
+			//Feed thread only
+			void Feed(bool waitForSource);
+			void RequestBuffers();
+			bool NextBuffer();
+			void FinishBuffer();
+			void ConvertFrames(u32 frame, u32 numFrames, float* dest);
+
+			//Mixer thread only. Returns false if voice starved while playing.
+			bool Mix(float* bus, float* scratch, u32 numFrames);
+			u32 ReadFrames(float* dest, u32 numFrames, bool sourceFinished);
+			u32 CopyFrames(float* dest, u32 numFrames);
+			u32 ResampleFrames(float* dest, u32 numFrames, u64 step, bool sourceFinished);
+			void ConsumeInput(u32 numFrames);
+			void ProcessEffects(float* samples, u32 numFrames);
+			void MixGain(float* bus, const float* samples, u32 numFrames);
+
+			Queue<Buffer*, s_bufferQueueSize> m_bufferQueue;
+			Buffer* m_currentBuffer;
+			u32 m_bufferPos;
+			u32 m_bufferFrames;
+			int m_maxQueuedBuffers;
+
+			//Set by feed thread after the last frames are in the ring
+			std::atomic<bool> m_sourceFinished;
+
+			PCMRing m_ring;
+
+			u32 m_numChannels;
+			u32 m_bytesPerSample;
+			u32 m_sourceSampleRate;
+			u32 m_outputSampleRate;
+
+			//Resampler input, frame 0 is the last frame before m_position. Frames beyond it are read ahead for the filter taps.
+			std::vector<float> m_input;
+			u32 m_inputFrames;
+			u32 m_inputCapacity;
+			u64 m_position;
+
+			//Silence appended after the source's last frame, so the filter taps can reach it
+			bool m_tailPadded;
+			u32 m_paddingFrames;
+
+			//Set by game thread
+			std::atomic<float> m_targetVolume;
+			std::atomic<float> m_targetPitch;
+			std::atomic<float> m_targetPan;
+
+			//Gains reached at the end of the last block
+			float m_gainLeft;
+			float m_gainRight;
+			bool m_gainsValid;
+
+			//Double buffered effects chain, as the Mixer's voice list
+			Effect* m_effectChains[2][s_maxEffects];
+			int m_numEffects[2];
+			std::atomic<u32> m_activeEffectChain;
+			std::atomic<u32> m_mixing;
+			std::atomic<u32> m_mixCount;
+
+			u32 m_buffersQueued;
+			u32 m_bytesBuffered;
+			u32 m_bytesConsumed;
+			u32 m_starvationCount;
+			u64 m_framesPlayed;
+		};
+	}
+}
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <audio/Device.h>
 
 namespace ion
@@ -0,0 +1,69 @@
+#include "PCMRing.h"
+
+#include <core/debug/Debug.h>
+#include <maths/Maths.h>
+
+namespace ion
+{
+	namespace audio
+	{
+		PCMRing::PCMRing(u32 numFrames, u32 numChannels)
+		{
+			debug::Assert(numFrames > 0 && (numFrames & (numFrames - 1)) == 0, "PCMRing::PCMRing() - Size must be a power of two");
+
+			m_numFrames = numFrames;
+			m_numChannels = numChannels;
+			m_samples.resize(numFrames * numChannels);
+			m_writeIdx.store(0, std::memory_order_relaxed);
+			m_readIdx.store(0, std::memory_order_relaxed);
+		}
+
+		u32 PCMRing::GetNumFrames() const
+		{
+			return m_numFrames;
+		}
+
+		u32 PCMRing::GetNumChannels() const
+		{
+			return m_numChannels;
+		}
+
+		u32 PCMRing::GetReadableFrames() const
+		{
+			return m_writeIdx.load(std::memory_order_acquire) - m_readIdx.load(std::memory_order_relaxed);
+		}
+
+		u32 PCMRing::GetWritableFrames() const
+		{
+			return m_numFrames - (m_writeIdx.load(std::memory_order_relaxed) - m_readIdx.load(std::memory_order_acquire));
+		}
+
+		float* PCMRing::GetWriteRegion(u32& numFrames)
+		{
+			u32 writeIdx = m_writeIdx.load(std::memory_order_relaxed);
+			u32 offset = writeIdx & (m_numFrames - 1);
+			numFrames = maths::Min(GetWritableFrames(), m_numFrames - offset);
+			return m_samples.data() + (offset * m_numChannels);
+		}
+
+		void PCMRing::CommitWrite(u32 numFrames)
+		{
+			debug::Assert(numFrames <= GetWritableFrames(), "PCMRing::CommitWrite() - Overflow");
+			m_writeIdx.store(m_writeIdx.load(std::memory_order_relaxed) + numFrames, std::memory_order_release);
+		}
+
+		const float* PCMRing::GetReadRegion(u32& numFrames) const
+		{
+			u32 readIdx = m_readIdx.load(std::memory_order_relaxed);
+			u32 offset = readIdx & (m_numFrames - 1);
+			numFrames = maths::Min(GetReadableFrames(), m_numFrames - offset);
+			return m_samples.data() + (offset * m_numChannels);
+		}
+
+		void PCMRing::CommitRead(u32 numFrames)
+		{
+			debug::Assert(numFrames <= GetReadableFrames(), "PCMRing::CommitRead() - Underflow");
+			m_readIdx.store(m_readIdx.load(std::memory_order_relaxed) + numFrames, std::memory_order_release);
+		}
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <core/Types.h>
+
+#include <atomic>
+#include <vector>
+
+namespace ion
+{
+	namespace audio
+	{
+		//Wait-free single producer, single consumer ring of interleaved float frames.
+		//Producer and consumer each own one index, and publish it with a release store.
+		class PCMRing
+		{
+		public:
+			//numFrames must be a power of two
+			PCMRing(u32 numFrames, u32 numChannels);
+
+			u32 GetNumFrames() const;
+			u32 GetNumChannels() const;
+
+			//Snapshots, exact for the calling side's own end of the ring
+			u32 GetReadableFrames() const;
+			u32 GetWritableFrames() const;
+
+			//Producer. Contiguous free region up to the end of the ring, fill then commit.
+			float* GetWriteRegion(u32& numFrames);
+			void CommitWrite(u32 numFrames);
+
+			//Consumer. Contiguous filled region up to the end of the ring, read then commit.
+			const float* GetReadRegion(u32& numFrames) const;
+			void CommitRead(u32 numFrames);
+
+		private:
+			static const int s_cacheLineSize = 64;
+
+			std::vector<float> m_samples;
+			u32 m_numFrames;
+			u32 m_numChannels;
+
+			//Free running frame counts, wrap at 2^32
+			alignas(s_cacheLineSize) std::atomic<u32> m_writeIdx;
+			alignas(s_cacheLineSize) std::atomic<u32> m_readIdx;
+		};
+	}
+}
@@ -1,4 +1,5 @@
 #include <core/debug/Debug.h>
+#include <core/thread/Atomic.h>
 
 #include "Source.h"
 
@@ -41,6 +41,15 @@ namespace ion
 
 			virtual void RequestBuffer(SourceCallback& callback) = 0;
 
+			//Callback has finished with a buffer from RequestBuffer(), source may refill it
+			virtual void ReleaseBuffer(Buffer& buffer) {}
+
+			//Streaming reached the end and every buffer has been handed to RequestBuffer(), no more will follow
+			virtual bool IsEndOfStream() const { return false; }
+
+			//Block until reads already queued for this source have finished, for offline rendering
+			virtual void WaitForPendingReads() {}
+
 		protected:
 			const StreamDesc* m_streamDesc;
 			FeedType m_feedType;
@@ -14,6 +14,7 @@ namespace ion
 			m_state = State::Stopped;
 			m_volume = 0.0f;
 			m_pitch = 0.0f;
+			m_pan = 0.0f;
 
 			//If a streaming feed, it's up to the feed to handle looping, not the voice
 			if (source.GetFeedType() == Source::FeedType::Streaming)
@@ -35,6 +36,19 @@ namespace ion
 		}
 
 		void Voice::Update(float deltaTime)
+		{
+			//Effects process audio on the mixer thread (or in ApplyEffects()), this only delivers their notifications
+			m_effectsListCritSec.Begin();
+
+			for (int i = 0; i < m_effects.size(); i++)
+			{
+				m_effects[i]->Update();
+			}
+
+			m_effectsListCritSec.End();
+		}
+
+		void Voice::ApplyEffects(float deltaTime)
 		{
 			if (m_state == State::Playing)
 			{
@@ -42,14 +56,20 @@ namespace ion
 
 				for (int i = 0; i < m_effects.size(); i++)
 				{
-					m_effects[i]->Update(deltaTime);
-					m_effects[i]->Apply(this);
+					m_effects[i]->Apply(*this, deltaTime);
 				}
 
 				m_effectsListCritSec.End();
 			}
 		}
 
+		bool Voice::StopIfPlaying()
+		{
+			//Leaves a concurrent Pause() or Stop() from the game thread in place
+			State expected = State::Playing;
+			return m_state.compare_exchange_strong(expected, State::Stopped);
+		}
+
 		Voice::State Voice::GetState() const
 		{
 			return m_state;
@@ -65,6 +85,11 @@ namespace ion
 			m_pitch = pitch;
 		}
 
+		void Voice::SetPan(float pan)
+		{
+			m_pan = pan;
+		}
+
 		float Voice::GetVolume() const
 		{
 			return m_volume;
@@ -75,10 +100,16 @@ namespace ion
 			return m_pitch;
 		}
 
+		float Voice::GetPan() const
+		{
+			return m_pan;
+		}
+
 		void Voice::DestroyEffect(Effect& effect)
 		{
 			m_effectsListCritSec.Begin();
 			ion::utils::stl::FindAndRemove(m_effects, &effect);
+			OnEffectsChanged();
 			m_effectsListCritSec.End();
 			delete &effect;
 		}
@@ -1,7 +1,10 @@
+#pragma once
+
 #include <core/Types.h>
 #include <core/thread/CriticalSection.h>
 #include <audio/Callback.h>
 
+#include <atomic>
 #include <vector>
 
 namespace ion
@@ -42,10 +45,14 @@ namespace ion
 			virtual void SetVolume(float volume);
 			virtual void SetPitch(float pitch);
 
+			//-1 full left, 1 full right
+			virtual void SetPan(float pan);
+
 			float GetVolume() const;
 			float GetPitch() const;
+			float GetPan() const;
 
-			//Effects
+			//Effects, processed in creation order
 			template <typename T> T* CreateEffect();
 			void DestroyEffect(Effect& effect);
 
@@ -55,12 +62,24 @@ namespace ion
 
 			virtual void Update(float deltaTime);
 
+			//Calls Effect::Apply() while playing, for voices not processed by the Mixer. Call before Voice::Update().
+			void ApplyEffects(float deltaTime);
+
+			//Effects list edited, called with m_effectsListCritSec held. The effect is deleted after this returns.
+			virtual void OnEffectsChanged() {}
+
+			//Stops from end of playback are raised on the mixer or device thread, use StopIfPlaying() for those
+			bool StopIfPlaying();
+
 			Source& m_source;
-			State m_state;
+
+			//Written by game thread transport calls and by the mixer or device thread at the end of playback
+			std::atomic<State> m_state;
 			bool m_loop;
 
 			float m_volume;
 			float m_pitch;
+			float m_pan;
 
 			ion::thread::CriticalSection m_effectsListCritSec;
 
@@ -72,6 +91,7 @@ namespace ion
 			T* effect = new T();
 			m_effectsListCritSec.Begin();
 			m_effects.push_back(effect);
+			OnEffectsChanged();
 			m_effectsListCritSec.End();
 			return effect;
 		}
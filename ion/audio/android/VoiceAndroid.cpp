@@ -59,8 +59,11 @@ namespace ion
 			return 0.0;
 		}
 
-		void VoiceAndroid::Update()
+		void VoiceAndroid::Update(float deltaTime)
 		{
+			//Not mixed by the Mixer, effects drive the voice from here
+			ApplyEffects(deltaTime);
+			Voice::Update(deltaTime);
 		}
 
 		void VoiceAndroid::SetVolume(float volume)
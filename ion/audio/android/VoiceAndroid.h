@@ -29,7 +29,7 @@ namespace ion
 			VoiceAndroid(Source& source, bool loop);
 			virtual ~VoiceAndroid();
 
-			virtual void Update();
+			virtual void Update(float deltaTime);
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "EngineNull.h"
+#include "OutputDeviceNull.h"
+
+#include <audio/Mixer.h>
+
+namespace ion
+{
+	namespace audio
+	{
+		EngineNull::EngineNull(u32 sampleRate)
+		{
+			CreateMixer(sampleRate);
+			m_outputDevice = new OutputDeviceNull(*m_mixer);
+		}
+
+		EngineNull::~EngineNull()
+		{
+			delete m_outputDevice;
+		}
+
+		int EngineNull::EnumerateDevices(std::vector<Device*>& devices)
+		{
+			devices.push_back(m_outputDevice);
+			return (int)devices.size();
+		}
+
+		Voice* EngineNull::CreateVoice(Source& source, bool loop)
+		{
+			return CreateMixerVoice(source, loop);
+		}
+
+		void EngineNull::ReleaseVoice(Voice& voice)
+		{
+			ReleaseMixerVoice(voice);
+		}
+
+		OutputDeviceNull& EngineNull::GetOutputDevice()
+		{
+			return *m_outputDevice;
+		}
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <audio/Engine.h>
+
+namespace ion
+{
+	namespace audio
+	{
+		class OutputDeviceNull;
+
+		//Engine with no hardware, mixes into an OutputDeviceNull. Can be created alongside
+		//the platform engine, for tools, tests and benchmarks on machines without audio devices.
+		class EngineNull : public Engine
+		{
+		public:
+			static const u32 s_defaultSampleRate = 48000;
+
+			EngineNull(u32 sampleRate = s_defaultSampleRate);
+			virtual ~EngineNull();
+
+			virtual int EnumerateDevices(std::vector<Device*>& devices);
+
+			virtual Voice* CreateVoice(Source& source, bool loop);
+			virtual void ReleaseVoice(Voice& voice);
+
+			OutputDeviceNull& GetOutputDevice();
+
+		private:
+			OutputDeviceNull* m_outputDevice;
+		};
+	}
+}
@@ -0,0 +1,220 @@
+#include "OutputDeviceNull.h"
+
+#include <audio/Mixer.h>
+#include <core/debug/Debug.h>
+#include <core/memory/Memory.h>
+#include <core/thread/Thread.h>
+#include <core/thread/Sleep.h>
+#include <core/time/Time.h>
+
+#include <atomic>
+
+namespace ion
+{
+	namespace audio
+	{
+		//Canonical 44 byte PCM WAV header
+		struct WAVFileHeader
+		{
+			char riffId[4];
+			u32 riffSize;
+			char waveId[4];
+			char fmtId[4];
+			u32 fmtSize;
+			u16 format;
+			u16 numChannels;
+			u32 sampleRate;
+			u32 bytesPerSec;
+			u16 blockSize;
+			u16 bitsPerSample;
+			char dataId[4];
+			u32 dataSize;
+		};
+
+		class OutputDeviceNull::DeviceThread : public thread::Thread
+		{
+		public:
+			DeviceThread(OutputDeviceNull& device, Pacing pacing)
+				: thread::Thread("AudioDeviceNull")
+				, m_device(device)
+				, m_pacing(pacing)
+				, m_running(true)
+			{
+			}
+
+			void RequestStop()
+			{
+				m_running = false;
+			}
+
+		protected:
+			virtual void Entry()
+			{
+				const double sampleRate = (double)m_device.m_mixer.GetSampleRate();
+				const u64 startTicks = time::GetSystemTicks();
+				const u64 startFrames = m_device.m_framesRendered;
+
+				if (m_pacing == Pacing::Offline)
+				{
+					//Faster than the feed thread runs, top up voices inline
+					m_device.m_mixer.BeginOfflineFeed();
+				}
+
+				while (m_running)
+				{
+					if (m_pacing == Pacing::Offline)
+					{
+						m_device.m_mixer.FeedOffline();
+					}
+
+					m_device.RenderBlock();
+
+					if (m_pacing == Pacing::RealTime)
+					{
+						//Wait until wall clock catches up with rendered audio
+						double aheadSeconds = ((double)(m_device.m_framesRendered - startFrames) / sampleRate) - time::TicksToSeconds(time::GetSystemTicks() - startTicks);
+						if (aheadSeconds > 0.0)
+						{
+							thread::Sleep((u32)(aheadSeconds * 1000.0));
+						}
+					}
+				}
+
+				if (m_pacing == Pacing::Offline)
+				{
+					m_device.m_mixer.EndOfflineFeed();
+				}
+			}
+
+		private:
+			OutputDeviceNull& m_device;
+			Pacing m_pacing;
+			std::atomic<bool> m_running;
+		};
+
+		OutputDeviceNull::OutputDeviceNull(Mixer& mixer, u32 blockFrames)
+			: m_mixer(mixer)
+		{
+			m_blockFrames = blockFrames;
+			m_block.resize(blockFrames * Mixer::s_numChannels);
+			m_framesRendered = 0;
+			m_mixTicks = 0;
+			m_wavDataSize = 0;
+			m_thread = nullptr;
+		}
+
+		OutputDeviceNull::~OutputDeviceNull()
+		{
+			Stop();
+			CloseWAV();
+		}
+
+		bool OutputDeviceNull::OpenWAV(const std::string& filename)
+		{
+			CloseWAV();
+
+			if (m_wavFile.Open(filename, io::File::OpenMode::Write))
+			{
+				//Sizes written on close
+				WAVFileHeader header = { 0 };
+				m_wavFile.Write(&header, sizeof(WAVFileHeader));
+				m_wavDataSize = 0;
+				return true;
+			}
+
+			debug::log << "OutputDeviceNull::OpenWAV() - Could not open " << filename << debug::end;
+			return false;
+		}
+
+		void OutputDeviceNull::CloseWAV()
+		{
+			if (m_wavFile.IsOpen())
+			{
+				WAVFileHeader header;
+				memory::MemCopy(header.riffId, "RIFF", 4);
+				memory::MemCopy(header.waveId, "WAVE", 4);
+				memory::MemCopy(header.fmtId, "fmt ", 4);
+				memory::MemCopy(header.dataId, "data", 4);
+				header.riffSize = (sizeof(WAVFileHeader) - 8) + m_wavDataSize;
+				header.fmtSize = 16;
+				header.format = 1;
+				header.numChannels = Mixer::s_numChannels;
+				header.sampleRate = m_mixer.GetSampleRate();
+				header.blockSize = Mixer::s_numChannels * sizeof(s16);
+				header.bytesPerSec = header.sampleRate * header.blockSize;
+				header.bitsPerSample = 16;
+				header.dataSize = m_wavDataSize;
+
+				m_wavFile.Seek(0, io::SeekMode::Start);
+				m_wavFile.Write(&header, sizeof(WAVFileHeader));
+				m_wavFile.Close();
+			}
+		}
+
+		void OutputDeviceNull::Render(u32 numFrames)
+		{
+			debug::Assert(!m_thread, "OutputDeviceNull::Render() - Device thread is running");
+
+			m_mixer.BeginOfflineFeed();
+
+			for (u32 frame = 0; frame < numFrames; frame += m_blockFrames)
+			{
+				m_mixer.FeedOffline();
+				RenderBlock();
+			}
+
+			m_mixer.EndOfflineFeed();
+		}
+
+		void OutputDeviceNull::Start(Pacing pacing)
+		{
+			if (!m_thread)
+			{
+				m_thread = new DeviceThread(*this, pacing);
+				m_thread->Run();
+			}
+		}
+
+		void OutputDeviceNull::Stop()
+		{
+			if (m_thread)
+			{
+				m_thread->RequestStop();
+				m_thread->Join();
+				delete m_thread;
+				m_thread = nullptr;
+			}
+		}
+
+		u64 OutputDeviceNull::GetFramesRendered() const
+		{
+			return m_framesRendered;
+		}
+
+		double OutputDeviceNull::GetVirtualTime() const
+		{
+			return (double)m_framesRendered / (double)m_mixer.GetSampleRate();
+		}
+
+		double OutputDeviceNull::GetMixTime() const
+		{
+			return time::TicksToSeconds(m_mixTicks);
+		}
+
+		void OutputDeviceNull::RenderBlock()
+		{
+			u64 startTicks = time::GetSystemTicks();
+			m_mixer.Mix(m_block.data(), m_blockFrames);
+			m_mixTicks += time::GetSystemTicks() - startTicks;
+
+			if (m_wavFile.IsOpen())
+			{
+				u32 size = m_blockFrames * Mixer::s_numChannels * sizeof(s16);
+				m_wavFile.Write(m_block.data(), size);
+				m_wavDataSize += size;
+			}
+
+			m_framesRendered += m_blockFrames;
+		}
+	}
+}
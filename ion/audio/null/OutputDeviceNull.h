@@ -0,0 +1,69 @@
+#pragma once
+
+#include <audio/OutputDevice.h>
+#include <core/io/File.h>
+
+#include <string>
+#include <vector>
+
+namespace ion
+{
+	namespace audio
+	{
+		class Mixer;
+
+		//Output device with no hardware behind it. Pulls mixed audio on a virtual clock, either on the
+		//calling thread or on its own thread at real-time pace, and can record what it pulled to a WAV file.
+		class OutputDeviceNull : public OutputDevice
+		{
+		public:
+			enum class Pacing
+			{
+				Offline,	//As fast as the mixer can go
+				RealTime	//One block per block duration, like a hardware device
+			};
+
+			static const u32 s_defaultBlockFrames = 1024;
+
+			OutputDeviceNull(Mixer& mixer, u32 blockFrames = s_defaultBlockFrames);
+			virtual ~OutputDeviceNull();
+
+			//Record all rendered audio as 16 bit stereo
+			bool OpenWAV(const std::string& filename);
+			void CloseWAV();
+
+			//Render at least numFrames on calling thread, in whole blocks. Feeds voices before each block.
+			void Render(u32 numFrames);
+
+			//Render on device thread until stopped. Offline pacing feeds voices before each block,
+			//real-time pacing leaves it to the mixer's feed thread like a hardware device.
+			void Start(Pacing pacing);
+			void Stop();
+
+			u64 GetFramesRendered() const;
+
+			//Seconds of audio rendered
+			double GetVirtualTime() const;
+
+			//Wall clock seconds spent mixing
+			double GetMixTime() const;
+
+		private:
+			class DeviceThread;
+
+			void RenderBlock();
+
+			Mixer& m_mixer;
+			u32 m_blockFrames;
+			std::vector<s16> m_block;
+
+			u64 m_framesRendered;
+			u64 m_mixTicks;
+
+			io::File m_wavFile;
+			u32 m_wavDataSize;
+
+			DeviceThread* m_thread;
+		};
+	}
+}
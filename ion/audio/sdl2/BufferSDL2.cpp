@@ -0,0 +1,64 @@
+#include "BufferSDL2.h"
+
+#include <core/memory/Memory.h>
+#include <core/debug/Debug.h>
+#include <maths/Maths.h>
+
+namespace ion
+{
+	namespace audio
+	{
+		Buffer* Buffer::Create(u32 size)
+		{
+			return new BufferSDL2(size);
+		}
+
+		Buffer* Buffer::Create(Buffer& rhs)
+		{
+			return new BufferSDL2(rhs);
+		}
+
+		BufferSDL2::BufferSDL2(u32 size)
+			: Buffer(size)
+		{
+			m_data = new char[size];
+			memory::MemSet(m_data, 0, size);
+		}
+
+		BufferSDL2::BufferSDL2(Buffer& rhs)
+			: BufferSDL2(rhs.GetReservedSize())
+		{
+			//Copy data from other buffer
+			rhs.ReadLock();
+			WriteLock();
+			Reset();
+			Add(rhs.Get(0), rhs.GetDataSize());
+			WriteUnlock();
+			rhs.ReadUnlock();
+		}
+
+		BufferSDL2::~BufferSDL2()
+		{
+			debug::Assert(m_lockCountRead == 0, "BufferSDL2::~BufferSDL2() - Buffer still locked for reading");
+			debug::Assert(m_lockCountWrite == 0, "BufferSDL2::~BufferSDL2() - Buffer still locked for writing");
+			delete [] m_data;
+		}
+
+		void BufferSDL2::Add(const char* data, u32 size)
+		{
+			debug::Assert(m_lockCountWrite > 0, "Buffer::Add() - Buffer not locked for writing");
+			debug::Assert((size + m_dataSize) <= m_reservedSize, "Buffer::Add() - Not enough space");
+
+			memory::MemCopy(m_data + m_dataSize, (void*)data, size);
+			m_dataSize += size;
+		}
+
+		void BufferSDL2::Put(const char* data, u32 size, u32 Position)
+		{
+			debug::Assert(m_lockCountWrite > 0, "Buffer::Put() - Buffer not locked for writing");
+			debug::Assert((size + Position) <= m_reservedSize, "Buffer::Put() - Not enough space");
+
+			memory::MemCopy(m_data + Position, (void*)data, size);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <core/Types.h>
+
+#include "audio/Buffer.h"
+
+namespace ion
+{
+	namespace audio
+	{
+		class BufferSDL2 : public Buffer
+		{
+		public:
+			BufferSDL2(u32 size);
+			BufferSDL2(Buffer& rhs);
+			virtual ~BufferSDL2();
+
+			virtual void Add(const char* data, u32 size);
+			virtual void Put(const char* data, u32 size, u32 Position);
+
+		private:
+		};
+	}
+}
\ No newline at end of file
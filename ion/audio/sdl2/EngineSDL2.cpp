@@ -3,7 +3,8 @@
 
 #include "EngineSDL2.h"
 #include "OutputDeviceSDL2.h"
-#include "VoiceSDL2.h"
+#include <audio/Mixer.h>
+#include <audio/null/OutputDeviceNull.h>
 
 namespace ion
 {
@@ -32,10 +33,47 @@ namespace ion
 
 			std::vector<Device*> devices;
 			EnumerateDevices(devices);
+
+			//Open one output device for all voices, mixed in software
+			SDL_AudioSpec desiredSpec = { 0 };
+			desiredSpec.freq = s_outputSampleRate;
+			desiredSpec.format = AUDIO_S16SYS;
+			desiredSpec.channels = Mixer::s_numChannels;
+			desiredSpec.samples = s_outputBufferFrames;
+			desiredSpec.callback = SDLMixCallback;
+			desiredSpec.userdata = this;
+
+			SDL_AudioSpec obtainedSpec;
+
+			m_nullDevice = NULL;
+			m_sdlDeviceId = SDL_OpenAudioDevice(NULL, 0, &desiredSpec, &obtainedSpec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+			if (m_sdlDeviceId <= 0)
+			{
+				debug::error << "EngineSDL2::EngineSDL2() - SDL_OpenAudioDevice() failed with error: " << SDL_GetError() << ", falling back to null output" << debug::end;
+
+				//No device, obtained spec is undefined. Mix silently at real-time pace so voices still play out and finish.
+				m_sdlDeviceId = 0;
+				CreateMixer(s_outputSampleRate);
+				m_nullDevice = new OutputDeviceNull(*m_mixer, s_outputBufferFrames);
+				m_nullDevice->Start(OutputDeviceNull::Pacing::RealTime);
+				return;
+			}
+
+			//Device opens paused, start once mixer exists
+			CreateMixer(obtainedSpec.freq);
+			SDL_PauseAudioDevice(m_sdlDeviceId, 0);
 		}
 
 		EngineSDL2::~EngineSDL2()
 		{
+			if (m_nullDevice)
+			{
+				delete m_nullDevice;
+			}
+			else
+			{
+				SDL_CloseAudioDevice(m_sdlDeviceId);
+			}
 		}
 
 		int EngineSDL2::EnumerateDevices(std::vector<Device*>& devices)
@@ -48,15 +86,18 @@ namespace ion
 
 		Voice* EngineSDL2::CreateVoice(Source& source, bool loop)
 		{
-			Voice* voice = new VoiceSDL2(source, loop);
-			AddVoice(voice);
-			return voice;
+			return CreateMixerVoice(source, loop);
 		}
 
 		void EngineSDL2::ReleaseVoice(Voice& voice)
 		{
-			RemoveVoice(&voice);
-			delete &(VoiceSDL2&)voice;
+			ReleaseMixerVoice(voice);
+		}
+
+		void EngineSDL2::SDLMixCallback(void* userdata, Uint8* stream, int len)
+		{
+			EngineSDL2* engine = (EngineSDL2*)userdata;
+			engine->m_mixer->Mix((s16*)stream, len / (sizeof(s16) * Mixer::s_numChannels));
 		}
 	}
 }
\ No newline at end of file
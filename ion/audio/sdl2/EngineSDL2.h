@@ -6,6 +6,8 @@ namespace ion
 {
 	namespace audio
 	{
+		class OutputDeviceNull;
+
 		class EngineSDL2 : public Engine
 		{
 			friend class Engine;
@@ -18,6 +20,18 @@ namespace ion
 		protected:
 			EngineSDL2();
 			virtual ~EngineSDL2();
+
+		private:
+			//Requested output format, device may change the rate
+			static const int s_outputSampleRate = 48000;
+			static const int s_outputBufferFrames = 1024;
+
+			static void SDLMixCallback(void* userdata, Uint8* stream, int len);
+
+			SDL_AudioDeviceID m_sdlDeviceId;
+
+			//Used in place of the SDL device if it failed to open
+			OutputDeviceNull* m_nullDevice;
 		};
 	}
-}
\ No newline at end of file
+}
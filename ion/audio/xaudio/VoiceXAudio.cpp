@@ -61,7 +61,8 @@ namespace ion
 			xaudioBuffer.PlayLength = buffer.GetDataSize() / (streamDesc->GetBitsPerSample() / 8) / streamDesc->GetNumChannels();
 			xaudioBuffer.pContext = &buffer;
 			xaudioBuffer.LoopCount = ((m_source.GetFeedType() == Source::FeedType::SingleBuffer) && m_loop) ? XAUDIO2_LOOP_INFINITE : 0;
-			xaudioBuffer.Flags = (m_source.GetFeedType() == Source::FeedType::SingleBuffer) ? XAUDIO2_END_OF_STREAM : 0;
+			//Streams end on the last buffer the source hands out
+			xaudioBuffer.Flags = ((m_source.GetFeedType() == Source::FeedType::SingleBuffer) || m_source.IsEndOfStream()) ? XAUDIO2_END_OF_STREAM : 0;
 
 			m_XAudioVoice->SubmitSourceBuffer(&xaudioBuffer);
 
@@ -120,6 +121,8 @@ namespace ion
 
 		void VoiceXAudio::Update(float deltaTime)
 		{
+			//Not mixed by the Mixer, effects drive the XAudio voice from here
+			ApplyEffects(deltaTime);
 			Voice::Update(deltaTime);
 		}
 
@@ -157,9 +160,9 @@ namespace ion
 
 		void VoiceXAudio::OnStreamEnd()
 		{
-			if (m_source.GetFeedType() == Source::FeedType::SingleBuffer)
+			if (m_source.GetFeedType() == Source::FeedType::SingleBuffer || m_source.IsEndOfStream())
 			{
-				m_state = State::Stopped;
+				StopIfPlaying();
 			}
 			else
 			{
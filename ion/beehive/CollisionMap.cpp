@@ -16,6 +16,7 @@
 #include <ion/core/memory/Memory.h>
 #include <ion/core/memory/Endian.h>
 #include <ion/maths/Geometry.h>
+#include <ion/core/io/AsmEmitter.h>
 
 CollisionMap::CollisionMap()
 {
@@ -467,6 +468,8 @@ std::vector<CollisionMap::Block>& CollisionMap::GetBlocks()
 
 void CollisionMap::Export(const Project& project, std::stringstream& stream) const
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	//Use default tile if there is one, else use first tile
 	u32 defaultTileId = project.GetDefaultTerrainTile();
 	if(defaultTileId == InvalidTerrainTileId)
@@ -475,11 +478,10 @@ void CollisionMap::Export(const Project& project, std::stringstream& stream) con
 	}
 
 	//Output to stream
-	stream << std::hex << std::setfill('0') << std::uppercase;
 
 	for(int y = 0; y < m_height; y++)
 	{
-		stream << "\tdc.w\t";
+		emitter.BeginDcW();
 
 		for(int x = 0; x < m_width; x++)
 		{
@@ -490,16 +492,15 @@ void CollisionMap::Export(const Project& project, std::stringstream& stream) con
 			u32 tileIndex = (tileId == InvalidTerrainTileId) ? defaultTileId : tileId;
 
 			u16 word = (u16)tileIndex | tileFlags;
-			stream << "0x" << std::setw(4) << (u32)word;
+			emitter.HexLiteral(word, 4);
 
 			if(x < (m_width - 1))
-				stream << ",";
+				emitter.Char(',');
 		}
 
-		stream << std::endl;
+		emitter.NewLine();
 	}
 
-	stream << std::dec;
 }
 
 void CollisionMap::Export(const Project& project, ion::io::File& file) const
@@ -530,6 +531,8 @@ void CollisionMap::Export(const Project& project, ion::io::File& file) const
 
 void CollisionMap::ExportBlockMap(const Project& project, std::stringstream& stream, int blockWidth, int blockHeight) const
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	int tileWidth = project.GetPlatformConfig().tileWidth;
 	int tileHeight = project.GetPlatformConfig().tileHeight;
 
@@ -540,27 +543,27 @@ void CollisionMap::ExportBlockMap(const Project& project, std::stringstream& str
 	int widthBlocks = GetWidthBlocks(blockWidth);
 
 	//Export block map
-	stream << std::endl;
-	stream << "Terrain_Block_Map:" << std::endl;
+	emitter.NewLine();
+	emitter.Text("Terrain_Block_Map:").NewLine();
 
 	for(int blockY = topLeft.y; blockY < (topLeft.y + size.y); blockY++)
 	{
-		stream << "\tdc.w\t";
+		emitter.BeginDcW();
 
 		for(int blockX = topLeft.x; blockX < (topLeft.x + size.x); blockX++)
 		{
 			int blockId = (blockY * widthBlocks) + blockX;
 			const Block& block = m_blocks[blockId];
 
-			stream << "0x" << std::hex << std::setfill('0') << std::setw(4) << block.uniqueIndex;
+			emitter.HexLiteral((u32)block.uniqueIndex, 4);
 
 			if(blockX < (size.x - 1))
 			{
-				stream << ",";
+				emitter.Char(',');
 			}
 		}
 
-		stream << std::endl;
+		emitter.NewLine();
 	}
 }
 
@@ -611,12 +614,13 @@ bool CollisionMap::Block::operator ==(const Block& rhs) const
 
 void CollisionMap::Block::Export(const Project& project, std::stringstream& stream, int blockWidth, int blockHeight)
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	//Output to stream
-	stream << std::hex << std::setfill('0') << std::uppercase;
 
 	for(int y = 0; y < blockHeight; y++)
 	{
-		stream << "\tdc.w\t";
+		emitter.BeginDcW();
 
 		for(int x = 0; x < blockWidth; x++)
 		{
@@ -626,15 +630,15 @@ void CollisionMap::Block::Export(const Project& project, std::stringstream& stre
 			u16 word = tileDesc;
 
 			//Write
-			stream << "0x" << std::hex << std::setfill('0') << std::setw(4) << (u32)word;
+			emitter.HexLiteral(word, 4);
 
 			if(x < (blockWidth - 1))
 			{
-				stream << ",";
+				emitter.Char(',');
 			}
 		}
 
-		stream << std::endl;
+		emitter.NewLine();
 	}
 }
 
@@ -22,11 +22,7 @@
 #include <ion/dependencies/slz/tool/compress.h>
 #include <ion/dependencies/slz/tool/decompress.h>
 #include <ion/resource/compression/CompressionRLE.h>
-
-#define HEX1(val) std::hex << std::setfill('0') << std::setw(1) << std::uppercase << (int)val
-#define HEX2(val) std::hex << std::setfill('0') << std::setw(2) << std::uppercase << (int)val
-#define HEX4(val) std::hex << std::setfill('0') << std::setw(4) << std::uppercase << (int)val
-#define HEX8(val) std::hex << std::setfill('0') << std::setw(8) << std::uppercase << (int)val
+#include <ion/core/io/AsmEmitter.h>
 
 Map::Map()
 {
@@ -712,6 +708,8 @@ void Map::Export(const Project& project, std::vector<TileDesc>& tileMap) const
 
 void Map::Export(const Project& project, std::stringstream& stream) const
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	//Copy tiles
 	std::vector<TileDesc> tiles = m_tiles;
 
@@ -735,11 +733,10 @@ void Map::Export(const Project& project, std::stringstream& stream) const
 	//if(project.GetPlatformConfig().platform == ePlatformMegaDrive)
 	{
 		//Output to stream
-		stream << std::hex << std::setfill('0') << std::uppercase;
 
 		for(int y = 0; y < m_height; y++)
 		{
-			stream << "\tdc.w\t";
+			emitter.BeginDcW();
 
 			for(int x = 0; x < m_width; x++)
 			{
@@ -772,18 +769,17 @@ void Map::Export(const Project& project, std::stringstream& stream) const
 				//Generate word
 				u16 word = tileIndex | flipV | flipH | palette;
 
-				stream << "0x" << std::setw(4) << (u32)word;
+				emitter.HexLiteral(word, 4);
 
 				if(x < (m_width - 1))
 				{
-					stream << ",";
+					emitter.Char(',');
 				}
 			}
 
-			stream << std::endl;
+			emitter.NewLine();
 		}
 
-		stream << std::dec;
 	}
 	//else if(project.GetPlatformConfig().platform == ePlatformSNES)
 	{
@@ -956,31 +952,33 @@ const std::vector<Map::Block>& Map::GetBlocks() const
 
 void Map::ExportBlockMap(const Project& project, std::stringstream& stream, int blockWidth, int blockHeight) const
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	int widthBlocks = GetWidthBlocks(blockWidth);
 	int heightBlocks = GetHeightBlocks(blockHeight);
 
 	//Export block map
-	stream << std::endl;
-	stream << "Block_Map:" << std::endl;
+	emitter.NewLine();
+	emitter.Text("Block_Map:").NewLine();
 
 	for(int blockY = 0; blockY < heightBlocks; blockY++)
 	{
-		stream << "\tdc.w\t";
+		emitter.BeginDcW();
 
 		for(int blockX = 0; blockX < widthBlocks; blockX++)
 		{
 			int blockId = (blockY * widthBlocks) + blockX;
 			const Block& block = m_blocks[blockId];
 			
-			stream << "0x" << std::hex << std::setfill('0') << std::setw(4) << block.uniqueIndex;
+			emitter.HexLiteral((u32)block.uniqueIndex, 4);
 
 			if(blockX < (widthBlocks - 1))
 			{
-				stream << ",";
+				emitter.Char(',');
 			}
 		}
 
-		stream << std::endl;
+		emitter.NewLine();
 	}
 }
 
@@ -1040,6 +1038,19 @@ void Map::ExportBlockMap(const Project& project, ion::io::File& file, int blockW
 	}
 }
 
+static void ExportStampMapEntry(ion::io::AsmEmitter& emitter, const std::string& name, const char* axis, int index, const StampMapEntry& entry, u32 stampIndex)
+{
+	//Entry index is written in hex, as the stream was left in hex mode by the original exporter
+	const char* fields[] = { "_xpos:", "_ypos:", "_idx:", "_flags:" };
+	const u32 values[] = { (u32)entry.m_position.x, (u32)entry.m_position.y, stampIndex, entry.m_flags };
+
+	for(int i = 0; i < 4; i++)
+	{
+		emitter.Text("stampentry_").Text(axis).Char('_').Text(name).Char('_').Hex(index, 1).Text(fields[i]);
+		emitter.Text("\tdc.w ").HexLiteral(values[i], 4).NewLine();
+	}
+}
+
 void Map::ExportStampMap(const Project& project, std::stringstream& stream) const
 {
 	//Assign indices to stampIds
@@ -1073,33 +1084,30 @@ void Map::ExportStampMap(const Project& project, std::stringstream& stream) cons
 	std::sort(sortedX.begin(), sortedX.end(), [](const std::pair<const StampMapEntry*, s32>& lhs, const std::pair<const StampMapEntry*, s32>& rhs) { return lhs.second < rhs.second; });
 	std::sort(sortedY.begin(), sortedY.end(), [](const std::pair<const StampMapEntry*, s32>& lhs, const std::pair<const StampMapEntry*, s32>& rhs) { return lhs.second < rhs.second; });
 
+	ion::io::AsmEmitter emitter(stream);
+	const std::string& name = project.GetName();
+
 	//Export count
-	stream << "stampmap_" << project.GetName() << "_count equ 0x" << HEX4((int)sortedX.size()) << std::endl;
+	emitter.Text("stampmap_").Text(name).Text("_count equ ").HexLiteral((u32)sortedX.size(), 4).NewLine();
 
-	stream << std::endl;
+	emitter.NewLine();
 	
 	//Export X-sorted table
-	stream << "stampmap_" << project.GetName() << "_x_table:" << std::endl;
+	emitter.Text("stampmap_").Text(name).Text("_x_table:").NewLine();
 
 	for(int i = 0; i < sortedX.size(); i++)
 	{
-		stream << "stampentry_x_" << project.GetName() << "_" << i << "_xpos:\tdc.w 0x" << HEX4((int)sortedX[i].first->m_position.x) << std::endl;
-		stream << "stampentry_x_" << project.GetName() << "_" << i << "_ypos:\tdc.w 0x" << HEX4((int)sortedX[i].first->m_position.y) << std::endl;
-		stream << "stampentry_x_" << project.GetName() << "_" << i << "_idx:\tdc.w 0x" << HEX4((int)indexMap[sortedX[i].first->m_id]) << std::endl;
-		stream << "stampentry_x_" << project.GetName() << "_" << i << "_flags:\tdc.w 0x" << HEX4((int)sortedX[i].first->m_flags) << std::endl;
+		ExportStampMapEntry(emitter, name, "x", i, *sortedX[i].first, indexMap[sortedX[i].first->m_id]);
 	}
 
-	stream << std::endl;
+	emitter.NewLine();
 
 	//Export Y-sorted table
-	stream << "stampmap_" << project.GetName() << "_y_table:" << std::endl;
+	emitter.Text("stampmap_").Text(name).Text("_y_table:").NewLine();
 
 	for(int i = 0; i < sortedY.size(); i++)
 	{
-		stream << "stampentry_y_" << project.GetName() << "_" << i << "_xpos:\tdc.w 0x" << HEX4((int)sortedY[i].first->m_position.x) << std::endl;
-		stream << "stampentry_y_" << project.GetName() << "_" << i << "_ypos:\tdc.w 0x" << HEX4((int)sortedY[i].first->m_position.y) << std::endl;
-		stream << "stampentry_y_" << project.GetName() << "_" << i << "_idx:\tdc.w 0x" << HEX4((int)indexMap[sortedY[i].first->m_id]) << std::endl;
-		stream << "stampentry_y_" << project.GetName() << "_" << i << "_flags:\tdc.w 0x" << HEX4((int)sortedY[i].first->m_flags) << std::endl;
+		ExportStampMapEntry(emitter, name, "y", i, *sortedY[i].first, indexMap[sortedY[i].first->m_id]);
 	}
 }
 
@@ -1115,12 +1123,13 @@ bool Map::Block::operator ==(const Block& rhs) const
 
 void Map::Block::Export(const Project& project, std::stringstream& stream, int blockWidth, int blockHeight)
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	//Output to stream
-	stream << std::hex << std::setfill('0') << std::uppercase;
 
 	for(int y = 0; y < blockHeight; y++)
 	{
-		stream << "\tdc.w\t";
+		emitter.BeginDcW();
 
 		for(int x = 0; x < blockWidth; x++)
 		{
@@ -1151,15 +1160,15 @@ void Map::Block::Export(const Project& project, std::stringstream& stream, int b
 			u16 word = tileIndex | flipV | flipH | palette | plane;
 
 			//Write
-			stream << "0x" << std::hex << std::setfill('0') << std::setw(4) << (u32)word;
+			emitter.HexLiteral(word, 4);
 
 			if(x < (blockWidth - 1))
 			{
-				stream << ",";
+				emitter.Char(',');
 			}
 		}
 
-		stream << std::endl;
+		emitter.NewLine();
 	}
 }
 
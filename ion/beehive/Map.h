@@ -87,6 +87,8 @@ public:
 
 	struct TileDesc
 	{
+		ION_SERIALISE_POD(u32)
+
 		TileDesc() { m_id = InvalidTileId; m_flags = 0; }
 		TileDesc(TileId id, u32 flags) { m_id = id; m_flags = flags; }
 
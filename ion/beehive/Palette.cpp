@@ -13,6 +13,8 @@
 
 #include <core/debug/Debug.h>
 #include <core/memory/Memory.h>
+#include <maths/Maths.h>
+#include <ion/core/io/AsmEmitter.h>
 
 Colour::Colour()
 {
@@ -95,6 +97,8 @@ void Palette::Clear()
 	{
 		m_colours[i] = Colour();
 	}
+
+	InvalidateLookupTables();
 }
 
 bool Palette::IsColourUsed(int colourIdx) const
@@ -144,6 +148,7 @@ void Palette::SetColour(int colourIdx, const Colour& colour)
 	ion::debug::Assert(colourIdx < coloursPerPalette, "Palette::SetColour() - Out of range");
 	MarkUsed(colourIdx);
 	m_colours[colourIdx] = colour;
+	InvalidateLookupTables();
 }
 
 void Palette::InvalidateColour(int colourIdx)
@@ -151,6 +156,7 @@ void Palette::InvalidateColour(int colourIdx)
 	ion::debug::Assert(colourIdx < coloursPerPalette, "Palette::InvalidateColour() - Out of range");
 	MarkUnused(colourIdx);
 	m_colours[colourIdx] = Colour(0, 0, 0);
+	InvalidateLookupTables();
 }
 
 const Colour& Palette::GetColour(int colourIdx) const
@@ -161,39 +167,138 @@ const Colour& Palette::GetColour(int colourIdx) const
 
 bool Palette::GetNearestColourIdx(const Colour& colour, NearestColourAlgo algorithm, int& colourIdx) const
 {
-	//if(algorithm == eExact)
+	//Exact colours always map to themselves
+	for(int i = 0; i < coloursPerPalette; i++)
 	{
-		for(int i = 0; i < coloursPerPalette; i++)
+		if(m_colours[i] == colour && IsColourUsed(i))
 		{
-			if(m_colours[i] == colour && IsColourUsed(i))
-			{
-				colourIdx = i;
-				return true;
-			}
+			colourIdx = i;
+			return true;
 		}
 	}
+
+	if(algorithm != eExact && m_usedColours != 0)
+	{
+		colourIdx = GetLookupTable(algorithm)[GetLookupTableIndex(colour)];
+		return true;
+	}
 	
 	return false;
 }
 
+bool Palette::GetNearestColourIdxDithered(const Colour& colour, NearestColourAlgo algorithm, int x, int y, int& colourIdx) const
+{
+	//4x4 Bayer matrix
+	static const int s_ditherMatrix[4][4] =
+	{
+		{ 0,  8,  2, 10 },
+		{ 12, 4, 14,  6 },
+		{ 3, 11,  1,  9 },
+		{ 15, 7, 13,  5 }
+	};
+
+	if(algorithm == eExact)
+	{
+		return GetNearestColourIdx(colour, algorithm, colourIdx);
+	}
+
+	//Centred offset of +/- 30, about one Mega Drive colour step
+	int offset = ((s_ditherMatrix[y & 3][x & 3] * 2) - 15) * 2;
+
+	Colour dithered(
+		(u8)ion::maths::Clamp(colour.GetRed() + offset, 0, 255),
+		(u8)ion::maths::Clamp(colour.GetGreen() + offset, 0, 255),
+		(u8)ion::maths::Clamp(colour.GetBlue() + offset, 0, 255));
+
+	return GetNearestColourIdx(dithered, algorithm, colourIdx);
+}
+
+int Palette::GetColourDistance(const Colour& colourA, const Colour& colourB, NearestColourAlgo algorithm)
+{
+	int deltaR = (int)colourA.GetRed() - (int)colourB.GetRed();
+	int deltaG = (int)colourA.GetGreen() - (int)colourB.GetGreen();
+	int deltaB = (int)colourA.GetBlue() - (int)colourB.GetBlue();
+
+	if(algorithm == ePerceptual)
+	{
+		//Red-mean weighting, approximates perceived difference without a colour space conversion
+		int redMean = ((int)colourA.GetRed() + (int)colourB.GetRed()) / 2;
+		return (((512 + redMean) * deltaR * deltaR) >> 8) + (4 * deltaG * deltaG) + (((767 - redMean) * deltaB * deltaB) >> 8);
+	}
+
+	return (deltaR * deltaR) + (deltaG * deltaG) + (deltaB * deltaB);
+}
+
+int Palette::GetLookupTableIndex(const Colour& colour)
+{
+	return ((colour.GetRed() >> 3) << 10) | ((colour.GetGreen() >> 3) << 5) | (colour.GetBlue() >> 3);
+}
+
+const std::vector<u8>& Palette::GetLookupTable(NearestColourAlgo algorithm) const
+{
+	std::vector<u8>& lookupTable = m_lookupTables[algorithm];
+
+	if(lookupTable.empty())
+	{
+		lookupTable.resize(s_lookupTableSize);
+
+		for(int i = 0; i < s_lookupTableSize; i++)
+		{
+			//Expand cell's 5-bit channels to 8 bits
+			u8 red = ((i >> 10) & 0x1F) << 3;
+			u8 green = ((i >> 5) & 0x1F) << 3;
+			u8 blue = (i & 0x1F) << 3;
+			Colour cellColour(red | (red >> 5), green | (green >> 5), blue | (blue >> 5));
+
+			int nearestIdx = 0;
+			int nearestDistance = -1;
+
+			for(int colourIdx = 0; colourIdx < coloursPerPalette; colourIdx++)
+			{
+				if(IsColourUsed(colourIdx))
+				{
+					int distance = GetColourDistance(cellColour, m_colours[colourIdx], algorithm);
+					if(nearestDistance < 0 || distance < nearestDistance)
+					{
+						nearestIdx = colourIdx;
+						nearestDistance = distance;
+					}
+				}
+			}
+
+			lookupTable[i] = (u8)nearestIdx;
+		}
+	}
+
+	return lookupTable;
+}
+
+void Palette::InvalidateLookupTables()
+{
+	for(int i = 0; i < eNumNearestColourAlgos; i++)
+	{
+		m_lookupTables[i].clear();
+	}
+}
+
 void Palette::Serialise(ion::io::Archive& archive)
 {
 	archive.Serialise(m_colours, "colours");
 	archive.Serialise(m_usedColours, "usedColours");
+
+	if(archive.GetDirection() == ion::io::Archive::Direction::In)
+	{
+		InvalidateLookupTables();
+	}
 }
 
 void Palette::Export(std::stringstream& stream) const
 {
-	stream << std::hex << std::setfill('0') << std::uppercase;
+	ion::io::AsmEmitter emitter(stream);
 
 	for(int i = 0; i < coloursPerPalette; i++)
 	{
-		stream << "\tdc.w\t0x";
-
-		u32 value = m_colours[i].ToVDPFormat();
-
-		stream << std::setw(4) << (u32)m_colours[i].ToVDPFormat() << std::endl;
+		u16 value = m_colours[i].ToVDPFormat();
+		emitter.DcW(&value, 1);
 	}
-
-	stream << std::dec;
 }
\ No newline at end of file
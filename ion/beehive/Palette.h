@@ -54,7 +54,11 @@ public:
 
 	enum NearestColourAlgo
 	{
-		eExact = 0
+		eExact = 0,		//Exact colour only
+		eEuclidean,		//Nearest by RGB distance
+		ePerceptual,	//Nearest by red-mean weighted RGB distance
+
+		eNumNearestColourAlgos
 	};
 
 	Palette();
@@ -70,6 +74,12 @@ public:
 	const Colour& GetColour(int colourIdx) const;
 	bool GetNearestColourIdx(const Colour& colour, NearestColourAlgo algorithm, int& colourIdx) const;
 
+	//Nearest colour after a 4x4 ordered dither offset, x/y are the pixel's position in the source image
+	bool GetNearestColourIdxDithered(const Colour& colour, NearestColourAlgo algorithm, int x, int y, int& colourIdx) const;
+
+	//Squared distance between colours, using the non-exact algorithm's metric
+	static int GetColourDistance(const Colour& colourA, const Colour& colourB, NearestColourAlgo algorithm);
+
 	void Serialise(ion::io::Archive& archive);
 	void Export(std::stringstream& stream) const;
 
@@ -77,6 +87,15 @@ private:
 	void MarkUsed(int colourIdx);
 	void MarkUnused(int colourIdx);
 
+	//Nearest colour lookup tables, indexed by 15-bit RGB (5 bits per channel).
+	//Built on first non-exact lookup, cleared when colours change.
+	static const int s_lookupTableSize = 1 << 15;
+	static int GetLookupTableIndex(const Colour& colour);
+	const std::vector<u8>& GetLookupTable(NearestColourAlgo algorithm) const;
+	void InvalidateLookupTables();
+
 	std::vector<Colour> m_colours;
 	u16 m_usedColours;
+
+	mutable std::vector<u8> m_lookupTables[eNumNearestColourAlgos];
 };
@@ -12,11 +12,16 @@
 #include <ion/core/string/String.h>
 #include <ion/core/utils/STL.h>
 #include <ion/core/io/Archive.h>
+#include <ion/core/io/MappedFileStream.h>
+#include <ion/core/cryptography/Hash.h>
+#include <ion/core/thread/ParallelFor.h>
+#include <ion/core/thread/TaskGraph.h>
 #include <ion/gamekit/Bezier.h>
 #include <ion/maths/Fixed.h>
 
 #include <set>
 #include <vector>
+#include <unordered_map>
 #include <algorithm>
 #include <cctype>
 
@@ -89,6 +94,8 @@ void Project::Clear()
 	m_collisionMaps[m_editingCollisionMapId].Clear();
 	m_tileset.Clear();
 	m_stamps.clear();
+	m_stampHashIndex.Clear();
+	m_terrainStampHashIndex.Clear();
 	m_nextFreeStampId = 1;
 	m_nextFreeTerrainStampId = 1;
 	m_nextFreeGameObjectTypeId = 1;
@@ -96,7 +103,7 @@ void Project::Clear()
 
 bool Project::Load(const std::string& filename)
 {
-	ion::io::File file(filename, ion::io::File::OpenMode::Read);
+	ion::io::MappedFileStream file(filename);
 	if(file.IsOpen())
 	{
 		ion::io::Archive archive(file, ion::io::Archive::Direction::In);
@@ -148,6 +155,7 @@ bool Project::Save(const std::string& filename)
 	if(file.IsOpen())
 	{
 		ion::io::Archive archive(file, ion::io::Archive::Direction::Out);
+		archive.SetWriteMode(ion::io::Archive::WriteMode::Streaming);
 		Serialise(archive);
 		m_filename = filename;
 
@@ -184,6 +192,8 @@ void Project::Serialise(ion::io::Archive& archive)
 		m_collisionMaps.clear();
 		m_editingMapId = InvalidMapId;
 		m_editingCollisionMapId = InvalidCollisionMapId;
+		m_stampHashIndex.Clear();
+		m_terrainStampHashIndex.Clear();
 	}
 
 	archive.Serialise(m_settings, "settings");
@@ -651,6 +661,98 @@ void Project::DeleteTile(TileId tileId)
 	SetEraseTile(InvalidTileId);
 }
 
+void Project::DeleteTiles(const std::vector<TileId>& tileIds, const std::vector<TileReplacement>& replacements)
+{
+	const TileId numTiles = (TileId)m_tileset.GetCount();
+
+	std::vector<bool> deletedTiles(numTiles, false);
+
+	for(int i = 0; i < tileIds.size(); i++)
+	{
+		ion::debug::Assert(tileIds[i] < numTiles, "Project::DeleteTiles() - Invalid tile");
+		deletedTiles[tileIds[i]] = true;
+	}
+
+	for(int i = 0; i < replacements.size(); i++)
+	{
+		ion::debug::Assert(replacements[i].tileId < numTiles && replacements[i].replacementId < numTiles, "Project::DeleteTiles() - Invalid tile");
+		deletedTiles[replacements[i].tileId] = true;
+	}
+
+	//Compact tileset
+	std::vector<TileId> compactedIds;
+	m_tileset.RemoveTiles(deletedTiles, compactedIds);
+
+	//Build old to new id table
+	std::vector<Map::TileDesc> remap(numTiles);
+
+	for(TileId i = 0; i < numTiles; i++)
+	{
+		remap[i] = Map::TileDesc(compactedIds[i], 0);
+	}
+
+	for(int i = 0; i < replacements.size(); i++)
+	{
+		ion::debug::Assert(!deletedTiles[replacements[i].replacementId], "Project::DeleteTiles() - Replacement tile was deleted");
+		remap[replacements[i].tileId] = Map::TileDesc(compactedIds[replacements[i].replacementId], replacements[i].flipFlags);
+	}
+
+	//Remap all uses of tiles on all maps
+	for(TMapMap::iterator it = m_maps.begin(), end = m_maps.end(); it != end; ++it)
+	{
+		Map& map = it->second;
+		int mapWidth = map.GetWidth();
+		int mapHeight = map.GetHeight();
+
+		for(int x = 0; x < mapWidth; x++)
+		{
+			for(int y = 0; y < mapHeight; y++)
+			{
+				TileId currTileId = map.GetTile(x, y);
+				if(currTileId < numTiles && (remap[currTileId].m_id != currTileId || remap[currTileId].m_flags != 0))
+				{
+					//Deleted tiles are left with no flags
+					u32 flags = map.GetTileFlags(x, y);
+					map.SetTile(x, y, remap[currTileId].m_id);
+
+					if(remap[currTileId].m_id != InvalidTileId)
+					{
+						map.SetTileFlags(x, y, flags ^ remap[currTileId].m_flags);
+					}
+				}
+			}
+		}
+	}
+
+	//Remap all uses of tiles in stamps
+	for(TStampMap::iterator it = m_stamps.begin(), end = m_stamps.end(); it != end; ++it)
+	{
+		for(int x = 0; x < it->second.GetWidth(); x++)
+		{
+			for(int y = 0; y < it->second.GetHeight(); y++)
+			{
+				TileId currTileId = it->second.GetTile(x, y);
+				if(currTileId < numTiles && (remap[currTileId].m_id != currTileId || remap[currTileId].m_flags != 0))
+				{
+					u32 flags = it->second.GetTileFlags(x, y);
+					it->second.SetTile(x, y, remap[currTileId].m_id);
+
+					if(remap[currTileId].m_id != InvalidTileId)
+					{
+						it->second.SetTileFlags(x, y, flags ^ remap[currTileId].m_flags);
+					}
+				}
+			}
+		}
+	}
+
+	//Clear paint tile
+	SetPaintTile(InvalidTileId);
+
+	//Clear erase tile
+	SetEraseTile(InvalidTileId);
+}
+
 void Project::SwapTiles(TileId tileId1, TileId tileId2)
 {
 	//Swap in tileset
@@ -780,7 +882,9 @@ int Project::CleanupTiles()
 {
 	m_tileset.RebuildHashMap();
 
-	std::set<TileId> usedTiles;
+	const TileId numTiles = (TileId)m_tileset.GetCount();
+
+	std::vector<bool> usedTiles(numTiles, false);
 
 	//Collect all used tile ids from all maps
 	for(TMapMap::iterator it = m_maps.begin(), end = m_maps.end(); it != end; ++it)
@@ -796,9 +900,9 @@ int Project::CleanupTiles()
 				TileId tileId = map.GetTile(x, y);
 
 				//Ignore background tile
-				if(tileId != m_backgroundTile)
+				if(tileId != m_backgroundTile && tileId < numTiles)
 				{
-					usedTiles.insert(tileId);
+					usedTiles[tileId] = true;
 				}
 			}
 		}
@@ -814,51 +918,37 @@ int Project::CleanupTiles()
 			for(int y = 0; y < stamp.GetHeight(); y++)
 			{
 				TileId tileId = stamp.GetTile(x, y);
-				usedTiles.insert(tileId);
+
+				if(tileId < numTiles)
+				{
+					usedTiles[tileId] = true;
+				}
 			}
 		}
 	}
 
-	std::set<TileId> unusedTiles;
-
-	for(TileId i = 0; i < m_tileset.GetCount(); i++)
-	{
-		if(usedTiles.find(i) == usedTiles.end())
-		{
-			unusedTiles.insert(i);
-		}
-	}
+	std::vector<TileId> unusedTiles;
 
-	if(unusedTiles.size() > 0)
+	for(TileId i = 0; i < numTiles; i++)
 	{
-		std::stringstream message;
-		message << "Found " << unusedTiles.size() << " unused tiles, delete?";
-
-		//TODO: wx message handler in ion::debug
-		//if(wxMessageBox(message.str().c_str(), "Delete unused tiles", wxOK | wxCANCEL | wxICON_WARNING) == wxOK)
+		if(!usedTiles[i])
 		{
-			//Delete in reverse, popping from back
-			for(std::set<TileId>::const_reverse_iterator it = unusedTiles.rbegin(), end = unusedTiles.rend(); it != end; ++it)
-			{
-				DeleteTile(*it);
-			}
+			unusedTiles.push_back(i);
 		}
 	}
 
-	//Calculate hashes for all tiles
-	struct Duplicate
-	{
-		TileId original;
-		TileId duplicate;
-		Tileset::HashOrientation duplicateOrientation;
-	};
-
+	//Calculate hashes for all remaining tiles
 	std::map<u64, TileId> tileMaps[Tileset::eNumHashOrientations];
-	std::vector<Duplicate> duplicates;
+	std::vector<TileReplacement> duplicates;
 	u64 hashes[Tileset::eNumHashOrientations];
 
-	for(int i = 0; i < m_tileset.GetCount(); i++)
+	for(TileId i = 0; i < numTiles; i++)
 	{
+		if(!usedTiles[i])
+		{
+			continue;
+		}
+
 		const Tile* tile = m_tileset.GetTile(i);
 		m_tileset.CalculateHashes(*tile, hashes);
 		bool duplicateFound = false;
@@ -868,10 +958,11 @@ int Project::CleanupTiles()
 			std::map<u64, TileId>::iterator it = tileMaps[j].find(tile->GetHash());
 			if(it != tileMaps[j].end())
 			{
-				Duplicate duplicate;
-				duplicate.original = it->second;
-				duplicate.duplicate = i;
-				duplicate.duplicateOrientation = (Tileset::HashOrientation)j;
+				//Replace duplicate with original, orientated to match duplicate
+				TileReplacement duplicate;
+				duplicate.tileId = i;
+				duplicate.replacementId = it->second;
+				duplicate.flipFlags = Tileset::s_orientationFlags[j];
 				duplicates.push_back(duplicate);
 				duplicateFound = true;
 			}
@@ -886,73 +977,19 @@ int Project::CleanupTiles()
 		}
 	}
 
-	if(duplicates.size() > 0)
+	if(unusedTiles.size() > 0 || duplicates.size() > 0)
 	{
 		std::stringstream message;
-		message << "Found " << duplicates.size() << " duplicate tiles, delete?";
+		message << "Found " << unusedTiles.size() << " unused tiles and " << duplicates.size() << " duplicate tiles, delete?";
 
 		//TODO: wx message handler in ion::debug
-		//if(wxMessageBox(message.str().c_str(), "Delete duplicate tiles", wxOK | wxCANCEL | wxICON_WARNING) == wxOK)
+		//if(wxMessageBox(message.str().c_str(), "Delete unused tiles", wxOK | wxCANCEL | wxICON_WARNING) == wxOK)
 		{
-			for(int i = 0; i < duplicates.size(); i++)
-			{
-				//Find use of duplicate id in all maps
-				for(TMapMap::iterator it = m_maps.begin(), end = m_maps.end(); it != end; ++it)
-				{
-					Map& map = it->second;
-					int mapWidth = map.GetWidth();
-					int mapHeight = map.GetHeight();
-
-					for(int x = 0; x < mapWidth; x++)
-					{
-						for(int y = 0; y < mapHeight; y++)
-						{
-							if(map.GetTile(x, y) == duplicates[i].duplicate)
-							{
-								u32 originalFlags = map.GetTileFlags(x, y);
-
-								//Replace duplicate with original
-								map.SetTile(x, y, duplicates[i].original);
-
-								//Orientate to match duplicate
-								map.SetTileFlags(x, y, originalFlags ^ Tileset::s_orientationFlags[duplicates[i].duplicateOrientation]);
-							}
-						}
-					}
-				}
-
-				//Find uses of duplicate id in stamps
-				for(TStampMap::iterator it = m_stamps.begin(), end = m_stamps.end(); it != end; ++it)
-				{
-					for(int x = 0; x < it->second.GetWidth(); x++)
-					{
-						for(int y = 0; y < it->second.GetHeight(); y++)
-						{
-							if(it->second.GetTile(x, y) == duplicates[i].duplicate)
-							{
-								u32 originalFlags = it->second.GetTileFlags(x, y);
-
-								//Replace duplicate with original
-								it->second.SetTile(x, y, duplicates[i].original);
-
-								//Orientate to match duplicate
-								it->second.SetTileFlags(x, y, originalFlags ^ Tileset::s_orientationFlags[duplicates[i].duplicateOrientation]);
-							}
-						}
-					}
-				}
-			}
-
-			//Delete duplicates (in reverse, popping from back)
-			for(int i = duplicates.size() - 1; i >= 0; --i)
-			{
-				DeleteTile(duplicates[i].duplicate);
-			}
+			//Delete all in one pass, remapping all references
+			DeleteTiles(unusedTiles, duplicates);
 		}
 	}
 
-	m_tileset.RebuildHashMap();
-
 	return unusedTiles.size() + duplicates.size();
 }
 
@@ -1176,17 +1213,149 @@ bool Project::ImportAnimations(const std::string& filename, bool clearExisting)
 	return false;
 }
 
+template <typename TStampId> void Project::StampHashIndex<TStampId>::Clear()
+{
+	buckets.clear();
+	entries.clear();
+}
+
+template <typename TStampId> void Project::StampHashIndex<TStampId>::Insert(TStampId stampId, u64 hash, u32 version)
+{
+	Entry entry;
+	entry.hash = hash;
+	entry.version = version;
+	entries[stampId] = entry;
+	buckets[hash].push_back(stampId);
+}
+
+template <typename TStampId> void Project::StampHashIndex<TStampId>::Remove(TStampId stampId)
+{
+	typename std::map<TStampId, Entry>::iterator entryIt = entries.find(stampId);
+	if(entryIt != entries.end())
+	{
+		typename std::unordered_map<u64, std::vector<TStampId>>::iterator bucketIt = buckets.find(entryIt->second.hash);
+		if(bucketIt != buckets.end())
+		{
+			bucketIt->second.erase(std::remove(bucketIt->second.begin(), bucketIt->second.end(), stampId), bucketIt->second.end());
+
+			if(bucketIt->second.empty())
+			{
+				buckets.erase(bucketIt);
+			}
+		}
+
+		entries.erase(entryIt);
+	}
+}
+
+template <typename TStamp> u64 Project::HashStamp(const TStamp& stamp) const
+{
+	//Same fields as CompareStamps(), so equal stamps always hash equal
+	ion::HashStream64 hash;
+
+	u32 size[2] = { (u32)stamp.GetWidth(), (u32)stamp.GetHeight() };
+	hash.Update(size, sizeof(size));
+
+	for(int y = 0; y < stamp.GetHeight(); y++)
+	{
+		for(int x = 0; x < stamp.GetWidth(); x++)
+		{
+			const Tile* tile = GetTileset().GetTile(stamp.GetTile(x, y));
+			u64 cell[2] = { tile ? tile->GetHash() : 0, ((u64)(tile != NULL) << 32) | stamp.GetTileFlags(x, y) };
+			hash.Update(cell, sizeof(cell));
+		}
+	}
+
+	return hash.Finalise();
+}
+
+template <typename TStamp> bool Project::CompareStamps(const TStamp& stampA, const TStamp& stampB) const
+{
+	if(stampA.GetWidth() != stampB.GetWidth() || stampA.GetHeight() != stampB.GetHeight())
+	{
+		return false;
+	}
+
+	for(int x = 0; x < stampA.GetWidth(); x++)
+	{
+		for(int y = 0; y < stampA.GetHeight(); y++)
+		{
+			const Tile* tileA = GetTileset().GetTile(stampA.GetTile(x, y));
+			const Tile* tileB = GetTileset().GetTile(stampB.GetTile(x, y));
+			const u64 hashA = tileA ? tileA->GetHash() : 0;
+			const u64 hashB = tileB ? tileB->GetHash() : 0;
+			const u32 flagsA = stampA.GetTileFlags(x, y);
+			const u32 flagsB = stampB.GetTileFlags(x, y);
+
+			if(((tileA != NULL) != (tileB != NULL)) || (hashA != hashB) || (flagsA != flagsB))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+template <typename TStampMap, typename TStampId> void Project::RefreshStampHashIndex(const TStampMap& stamps, StampHashIndex<TStampId>& index) const
+{
+	//Tile hashes or ids changed, every stamp hash is stale
+	if(index.tilesetGeneration != GetTileset().GetHashGeneration())
+	{
+		index.Clear();
+		index.tilesetGeneration = GetTileset().GetHashGeneration();
+	}
+
+	//Stamps and index entries are both sorted by id, walk them together
+	typename std::map<TStampId, typename StampHashIndex<TStampId>::Entry>::iterator entryIt = index.entries.begin();
+
+	for(typename TStampMap::const_iterator it = stamps.begin(), end = stamps.end(); it != end; ++it)
+	{
+		//Drop entries for stamps no longer in the map
+		while(entryIt != index.entries.end() && entryIt->first < it->first)
+		{
+			TStampId staleId = entryIt->first;
+			++entryIt;
+			index.Remove(staleId);
+		}
+
+		bool upToDate = false;
+
+		if(entryIt != index.entries.end() && entryIt->first == it->first)
+		{
+			upToDate = (entryIt->second.version == it->second.GetContentVersion());
+			++entryIt;
+		}
+
+		//New or modified since last hashed
+		if(!upToDate)
+		{
+			index.Remove(it->first);
+			index.Insert(it->first, HashStamp(it->second), it->second.GetContentVersion());
+		}
+	}
+
+	while(entryIt != index.entries.end())
+	{
+		TStampId staleId = entryIt->first;
+		++entryIt;
+		index.Remove(staleId);
+	}
+}
+
 StampId Project::AddStamp(int width, int height)
 {
 	StampId id = m_nextFreeStampId++;
-	m_stamps.insert(std::make_pair(id, Stamp(id, width, height)));
+	TStampMap::iterator it = m_stamps.insert(std::make_pair(id, Stamp(id, width, height))).first;
+	m_stampHashIndex.Insert(id, HashStamp(it->second), it->second.GetContentVersion());
 	return id;
 }
 
 StampId Project::AddStamp(Stamp* stamp)
 {
 	StampId id = m_nextFreeStampId++;
-	m_stamps.insert(std::make_pair(id, Stamp(id, *stamp)));
+	TStampMap::iterator it = m_stamps.insert(std::make_pair(id, Stamp(id, *stamp))).first;
+	m_stampHashIndex.Insert(id, HashStamp(it->second), it->second.GetContentVersion());
 	return id;
 }
 
@@ -1221,6 +1390,8 @@ void Project::DeleteStamp(StampId stampId)
 	{
 		m_stamps.erase(it);
 	}
+
+	m_stampHashIndex.Remove(stampId);
 }
 
 Stamp* Project::GetStamp(StampId stampId)
@@ -1266,32 +1437,20 @@ StampId Project::FindDuplicateStamp(Stamp* stamp) const
 {
 	StampId foundStampId = InvalidStampId;
 
-	for(TStampMap::const_iterator it = m_stamps.begin(), end = m_stamps.end(); it != end && foundStampId == InvalidStampId; ++it)
+	RefreshStampHashIndex(m_stamps, m_stampHashIndex);
+
+	std::unordered_map<u64, std::vector<StampId>>::const_iterator bucketIt = m_stampHashIndex.buckets.find(HashStamp(*stamp));
+	if(bucketIt != m_stampHashIndex.buckets.end())
 	{
-		if(it->second.GetWidth() == stamp->GetWidth() && it->second.GetHeight() == stamp->GetHeight())
+		//Lowest matching id wins
+		for(int i = 0; i < bucketIt->second.size(); i++)
 		{
-			bool tilesMatch = true;
+			StampId stampId = bucketIt->second[i];
 
-			for(int x = 0; x < it->second.GetWidth() && tilesMatch; x++)
+			if((foundStampId == InvalidStampId || stampId < foundStampId) && CompareStamps(*stamp, m_stamps.find(stampId)->second))
 			{
-				for(int y = 0; y < it->second.GetHeight() && tilesMatch; y++)
-				{
-					const Tile* tileA = GetTileset().GetTile(stamp->GetTile(x, y));
-					const Tile* tileB = GetTileset().GetTile(it->second.GetTile(x, y));
-					const u64 hashA = tileA ? tileA->GetHash() : 0;
-					const u64 hashB = tileB ? tileB->GetHash() : 0;
-					const u32 flagsA = stamp->GetTileFlags(x, y);
-					const u32 flagsB = it->second.GetTileFlags(x, y);
-
-					if(((tileA != NULL) != (tileB != NULL)) || (hashA != hashB) || (flagsA != flagsB))
-					{
-						tilesMatch = false;
-					}
-				}
+				foundStampId = stampId;
 			}
-
-			if(tilesMatch)
-				foundStampId = it->first;
 		}
 	}
 
@@ -1448,20 +1607,25 @@ int Project::CompactStampIds()
 		}
 	}
 
+	//Ids reassigned, rebuild on next lookup
+	m_stampHashIndex.Clear();
+
 	return m_stamps.size();
 }
 
 TerrainStampId Project::AddTerrainStamp(int width, int height)
 {
 	TerrainStampId id = m_nextFreeTerrainStampId++;
-	m_terrainStamps.insert(std::make_pair(id, TerrainStamp(id, width, height)));
+	TTerrainStampMap::iterator it = m_terrainStamps.insert(std::make_pair(id, TerrainStamp(id, width, height))).first;
+	m_terrainStampHashIndex.Insert(id, HashStamp(it->second), it->second.GetContentVersion());
 	return id;
 }
 
 TerrainStampId Project::AddTerrainStamp(TerrainStamp* terrainStamp)
 {
 	TerrainStampId id = m_nextFreeTerrainStampId++;
-	m_terrainStamps.insert(std::make_pair(id, TerrainStamp(id, *terrainStamp)));
+	TTerrainStampMap::iterator it = m_terrainStamps.insert(std::make_pair(id, TerrainStamp(id, *terrainStamp))).first;
+	m_terrainStampHashIndex.Insert(id, HashStamp(it->second), it->second.GetContentVersion());
 	return id;
 }
 
@@ -1476,6 +1640,8 @@ void Project::DeleteTerrainStamp(TerrainStampId terrainStampId)
 	{
 		m_terrainStamps.erase(it);
 	}
+
+	m_terrainStampHashIndex.Remove(terrainStampId);
 }
 
 TerrainStamp* Project::GetTerrainStamp(TerrainStampId terrainStampId)
@@ -1508,32 +1674,20 @@ TerrainStampId Project::FindDuplicateTerrainStamp(TerrainStamp* terrainStamp) co
 {
 	TerrainStampId foundTerrainStampId = InvalidTerrainStampId;
 
-	for (TTerrainStampMap::const_iterator it = m_terrainStamps.begin(), end = m_terrainStamps.end(); it != end && foundTerrainStampId == InvalidTerrainStampId; ++it)
+	RefreshStampHashIndex(m_terrainStamps, m_terrainStampHashIndex);
+
+	std::unordered_map<u64, std::vector<TerrainStampId>>::const_iterator bucketIt = m_terrainStampHashIndex.buckets.find(HashStamp(*terrainStamp));
+	if (bucketIt != m_terrainStampHashIndex.buckets.end())
 	{
-		if (it->second.GetWidth() == terrainStamp->GetWidth() && it->second.GetHeight() == terrainStamp->GetHeight())
+		//Lowest matching id wins
+		for (int i = 0; i < bucketIt->second.size(); i++)
 		{
-			bool tilesMatch = true;
+			TerrainStampId terrainStampId = bucketIt->second[i];
 
-			for (int x = 0; x < it->second.GetWidth() && tilesMatch; x++)
+			if ((foundTerrainStampId == InvalidTerrainStampId || terrainStampId < foundTerrainStampId) && CompareStamps(*terrainStamp, m_terrainStamps.find(terrainStampId)->second))
 			{
-				for (int y = 0; y < it->second.GetHeight() && tilesMatch; y++)
-				{
-					const Tile* tileA = GetTileset().GetTile(terrainStamp->GetTile(x, y));
-					const Tile* tileB = GetTileset().GetTile(it->second.GetTile(x, y));
-					const u64 hashA = tileA ? tileA->GetHash() : 0;
-					const u64 hashB = tileB ? tileB->GetHash() : 0;
-					const u32 flagsA = terrainStamp->GetTileFlags(x, y);
-					const u32 flagsB = it->second.GetTileFlags(x, y);
-
-					if (((tileA != NULL) != (tileB != NULL)) || (hashA != hashB) || (flagsA != flagsB))
-					{
-						tilesMatch = false;
-					}
-				}
+				foundTerrainStampId = terrainStampId;
 			}
-
-			if (tilesMatch)
-				foundTerrainStampId = it->first;
 		}
 	}
 
@@ -2078,6 +2232,184 @@ bool Project::GenerateTerrainFromBeziers_HeightsOnly(int granularity)
 	return true;
 }
 
+namespace
+{
+	//Terrain bezier and the settings it generates with
+	struct TerrainBezierDesc
+	{
+		ion::gamekit::BezierPath* bezier;
+		u16 flags;
+		u8 layer;
+		bool generateWidth;
+	};
+
+	//A height or width drawn into a terrain tile
+	struct TerrainSample
+	{
+		enum Type
+		{
+			eHeight,
+			eWidth
+		};
+
+		int tileIdx;
+		int pixel;
+		s8 value;
+		u8 type;
+		u8 layer;
+		bool newTile;
+		u16 flags;
+		ion::Vector2 normal;
+	};
+
+	//Tiles per side of a terrain generation grid cell
+	const int s_terrainCellSize = 16;
+
+	//Follow bezier path, collect heights and widths in drawing order
+	void GenerateTerrainSamples(const TerrainBezierDesc& desc, int tileWidth, int tileHeight, int mapWidth, int mapHeight, std::vector<TerrainSample>& samples)
+	{
+		ion::gamekit::BezierPath* bezier = desc.bezier;
+		const int mapHeightPixels = (mapHeight * tileHeight);
+
+		//Recompute length
+		bezier->CalculateLength();
+
+		//Get all spline points
+		const float granularity = 1.0f;
+		const int numPoints = ion::maths::Ceil(bezier->GetLength() * granularity);
+		std::vector<ion::Vector2> points;
+		std::vector<ion::Vector2> normals;
+		points.reserve(numPoints);
+		normals.reserve(numPoints);
+		bezier->GetDistributedPositions(points, numPoints);
+		bezier->GetDistributedNormals(normals, numPoints);
+
+		ion::Vector2 prevPosHeight(ion::maths::Floor(points[0].x), (float)mapHeightPixels - ion::maths::Round(points[0].y));
+		ion::Vector2 prevPosWidth = prevPosHeight;
+		if (normals[0].y < 0.0f)
+			prevPosHeight.y -= 1.0f;
+		if (normals[0].x < 0.0f)
+			prevPosWidth.x -= 1.0f;
+
+		TerrainSample sample;
+		sample.layer = desc.layer;
+		sample.flags = desc.flags;
+		sample.newTile = false;
+
+		//Draw all tiles in spline
+		for(int posIdx = 0; posIdx < points.size(); posIdx++)
+		{
+			//Get position
+			ion::Vector2 nextPosHeight(ion::maths::Floor(points[posIdx].x), (float)mapHeightPixels - ion::maths::Round(points[posIdx].y));
+			ion::Vector2 nextPosWidth = nextPosHeight;
+
+			//Get normal
+			ion::Vector2 normal = normals[posIdx];
+			sample.normal = normal;
+
+			//Normal y<0 is a ceiling
+			if (normal.y < 0.0f)
+				nextPosHeight.y -= 1.0f;
+
+			//Normal x<0 is right wall
+			if (normals[0].x < 0.0f)
+				nextPosWidth.x -= 1.0f;
+
+			//Interpolate between positions
+			ion::Vector2 directionHeight = (nextPosHeight - prevPosHeight).Normalise();
+			ion::Vector2 directionWidth = (nextPosWidth - prevPosWidth).Normalise();
+			float distanceHeight = (nextPosHeight - prevPosHeight).GetLength();
+			float distanceWidth = (nextPosWidth - prevPosWidth).GetLength();
+			float maxDistance = ion::maths::Max(distanceWidth, distanceHeight);
+			int numSteps = (maxDistance > 0.0f) ? ion::maths::Ceil(maxDistance) + 1 : 1;
+			float stepLength = maxDistance / numSteps;
+
+			for (int step = 0; step < numSteps; step++)
+			{
+				ion::Vector2 pixelPosHeight = prevPosHeight + (directionHeight * (stepLength * step));
+				ion::Vector2 pixelPosWidth = prevPosWidth + (directionWidth * (stepLength * step));
+
+				//If ceiling, offset Y 1 px
+				if (normal.y < 0.0f)
+					pixelPosHeight.y += 1.0f;
+
+				//If right-hand side wall, offset X 1 px
+				if (normal.x < 0.0f)
+					pixelPosWidth.x += 1.0f;
+
+				const ion::Vector2i tilePosHeight(ion::maths::Floor(pixelPosHeight.x / (float)tileWidth), ion::maths::Floor(pixelPosHeight.y / (float)tileHeight));
+				const ion::Vector2i tilePosWidth(ion::maths::Floor(pixelPosWidth.x / (float)tileHeight), ion::maths::Floor(pixelPosWidth.y / (float)tileWidth));
+
+				//Height at X
+				if (tilePosHeight.x >= 0 && tilePosHeight.x < mapWidth && tilePosHeight.y >= 0 && tilePosHeight.y < mapHeight)
+				{
+					int pixelX = pixelPosHeight.x - (tilePosHeight.x * tileWidth);
+					int pixelY = pixelPosHeight.y - (tilePosHeight.y * tileHeight);
+
+					sample.tileIdx = (tilePosHeight.y * mapWidth) + tilePosHeight.x;
+					sample.type = TerrainSample::eHeight;
+					sample.pixel = pixelX;
+
+					if (normal.y < 0.0f)
+						sample.value = -ion::maths::Clamp(pixelY, 1, tileHeight);
+					else
+						sample.value = ion::maths::Clamp(tileHeight - pixelY, 1, tileHeight);
+
+					samples.push_back(sample);
+				}
+
+				//Width at Y
+				if (desc.generateWidth && tilePosWidth.x >= 0 && tilePosWidth.x < mapWidth && tilePosWidth.y >= 0 && tilePosWidth.y < mapHeight)
+				{
+					int pixelX = pixelPosWidth.x - (tilePosWidth.x * tileWidth);
+					int pixelY = pixelPosWidth.y - (tilePosWidth.y * tileHeight);
+
+					sample.tileIdx = (tilePosWidth.y * mapWidth) + tilePosWidth.x;
+					sample.type = TerrainSample::eWidth;
+					sample.pixel = tileHeight - 1 - pixelY;
+
+					if (normal.x < 0.0f)
+						sample.value = -ion::maths::Clamp(tileWidth - pixelX, 1, tileWidth);
+					else
+						sample.value = ion::maths::Clamp(pixelX, 1, tileWidth);
+
+					samples.push_back(sample);
+				}
+			}
+
+			prevPosHeight = nextPosHeight;
+			prevPosWidth = nextPosWidth;
+		}
+	}
+
+	//Draw one grid cell's samples, in the order the beziers drew them
+	void DrawTerrainSamples(const std::vector<const TerrainSample*>& samples, std::vector<std::vector<std::pair<TerrainTile, u16>>>& terrainTiles, std::vector<std::vector<std::pair<int, ion::Vector2>>>& foundNormals)
+	{
+		for (int i = 0; i < samples.size(); i++)
+		{
+			const TerrainSample& sample = *samples[i];
+			TerrainTile& currentTile = terrainTiles[sample.layer][sample.tileIdx].first;
+			u16& currentFlags = terrainTiles[sample.layer][sample.tileIdx].second;
+
+			if (sample.type == TerrainSample::eHeight)
+				currentTile.SetHeight(sample.pixel, sample.value);
+			else
+				currentTile.SetWidth(sample.pixel, sample.value);
+
+			//Set flags and angle
+			if (sample.newTile)
+			{
+				currentFlags |= sample.flags | eCollisionTileFlagTerrain;
+				currentTile.SetNormal(sample.normal);
+			}
+
+			//Add normal
+			foundNormals[sample.layer][sample.tileIdx].first++;
+			foundNormals[sample.layer][sample.tileIdx].second += sample.normal;
+		}
+	}
+}
+
 bool Project::GenerateTerrainFromBeziers()
 {
 	//Clear all terrain tiles
@@ -2129,22 +2461,38 @@ bool Project::GenerateTerrainFromBeziers()
 		Stamp& stamp = it->second;
 		int mapWidth = stamp.GetWidth();
 		int mapHeight = stamp.GetHeight();
-#else
+
+		std::vector<TerrainBezierDesc> beziers;
+		for (int i = 0; i < stamp.GetNumTerrainBeziers(); i++)
+		{
+			TerrainBezierDesc desc;
+			desc.bezier = stamp.GetTerrainBezier(i);
+			desc.flags = stamp.GetTerrainBezierFlags(i);
+			desc.layer = stamp.GetTerrainBezierLayer(i);
+			desc.generateWidth = stamp.GetTerrainBezierGenerateWidth(i);
+			beziers.push_back(desc);
+		}
+#else
 	for(TCollisionMapMap::iterator it = m_collisionMaps.begin(), end = m_collisionMaps.end(); it != end; ++it)
 	{
 		CollisionMap& collisionMap = it->second;
 		int mapWidth = collisionMap.GetWidth();
 		int mapHeight = collisionMap.GetHeight();
 
+		std::vector<TerrainBezierDesc> beziers;
+		for(int i = 0; i < collisionMap.GetNumTerrainBeziers(); i++)
+		{
+			TerrainBezierDesc desc;
+			desc.bezier = collisionMap.GetTerrainBezier(i);
+			desc.flags = collisionMap.GetTerrainBezierFlags(i);
+			desc.layer = collisionMap.GetTerrainBezierLayer(i);
+			desc.generateWidth = true;
+			beziers.push_back(desc);
+		}
 #endif
 		const int tileWidth = GetPlatformConfig().tileWidth;
 		const int tileHeight = GetPlatformConfig().tileHeight;
 
-		const int mapWidthPixels = (mapWidth * tileWidth);
-		const int mapHeightPixels = (mapHeight * tileHeight);
-
-		ion::Vector2i prevTilePosHeight;
-		ion::Vector2i prevTilePosWidth;
 		TerrainTileId tileId = InvalidTileId;
 
 		//Reserve tiles
@@ -2179,167 +2527,60 @@ bool Project::GenerateTerrainFromBeziers()
 			foundNormals[i].resize(numTiles);
 		}
 
-		//Follow paths, generate terrain height tiles
-#if BEEHIVE_FIXED_STAMP_MODE //No tile/collision editing in fixed mode
-		for (int i = 0; i < stamp.GetNumTerrainBeziers(); i++)
-		{
-			ion::gamekit::BezierPath* bezier = stamp.GetTerrainBezier(i);
-			u16 terrainFlags = stamp.GetTerrainBezierFlags(i);
-			u8 terrainLayer = stamp.GetTerrainBezierLayer(i);
-			bool generateWidthData = stamp.GetTerrainBezierGenerateWidth(i);
-#else
-		for(int i = 0; i < collisionMap.GetNumTerrainBeziers(); i++)
-		{
-			ion::gamekit::BezierPath* bezier = collisionMap.GetTerrainBezier(i);
-			u16 terrainFlags = collisionMap.GetTerrainBezierFlags(i);
-			u8 terrainLayer = collisionMap.GetTerrainBezierLayer(i);
-#endif
+		//Follow paths, one bezier per job
+		std::vector<std::vector<TerrainSample>> bezierSamples(beziers.size());
 
-			if(bezier->GetNumCurves() > 0)
+		ion::thread::ParallelFor(beziers.size(), 1, [&](u32 begin, u32 end)
+		{
+			for (u32 i = begin; i < end; i++)
 			{
-				//Recompute length
-				bezier->CalculateLength();
-
-				//Get all spline points
-				const float granularity = 1.0f;
-				const int numPoints = ion::maths::Ceil(bezier->GetLength() * granularity);
-				std::vector<ion::Vector2> points;
-				std::vector<ion::Vector2> normals;
-				points.reserve(numPoints);
-				normals.reserve(numPoints);
-				bezier->GetDistributedPositions(points, numPoints);
-				bezier->GetDistributedNormals(normals, numPoints);
-
-				const float rightAngle = ion::maths::Atan2(1.0f, 0.0f);
-
-				ion::Vector2 prevPosHeight(ion::maths::Floor(points[0].x), (float)mapHeightPixels - ion::maths::Round(points[0].y));
-				ion::Vector2 prevPosWidth = prevPosHeight;
-				if (normals[0].y < 0.0f)
-					prevPosHeight.y -= 1.0f;
-				if (normals[0].x < 0.0f)
-					prevPosWidth.x -= 1.0f;
-
-				//Draw all tiles in spline
-				for(int posIdx = 0; posIdx < points.size(); posIdx++)
+				if (beziers[i].bezier->GetNumCurves() > 0)
 				{
-					//Get position
-					ion::Vector2 nextPosHeight(ion::maths::Floor(points[posIdx].x), (float)mapHeightPixels - ion::maths::Round(points[posIdx].y));
-					ion::Vector2 nextPosWidth = nextPosHeight;
-
-					//Get normal
-					ion::Vector2 normal = normals[posIdx];
-
-					//Normal y<0 is a ceiling
-					if (normal.y < 0.0f)
-						nextPosHeight.y -= 1.0f;
-
-					//Normal x<0 is right wall
-					if (normals[0].x < 0.0f)
-						nextPosWidth.x -= 1.0f;
-
-					//Interpolate between positions
-					ion::Vector2 directionHeight = (nextPosHeight - prevPosHeight).Normalise();
-					ion::Vector2 directionWidth = (nextPosWidth - prevPosWidth).Normalise();
-					float distanceHeight = (nextPosHeight - prevPosHeight).GetLength();
-					float distanceWidth = (nextPosWidth - prevPosWidth).GetLength();
-					float maxDistance = ion::maths::Max(distanceWidth, distanceHeight);
-					int numSteps = (maxDistance > 0.0f) ? ion::maths::Ceil(maxDistance) + 1 : 1;
-					float stepLength = maxDistance / numSteps;
-
-					for (int step = 0; step < numSteps; step++)
-					{
-						ion::Vector2 pixelPosHeight = prevPosHeight + (directionHeight * (stepLength * step));
-						ion::Vector2 pixelPosWidth = prevPosWidth + (directionWidth * (stepLength * step));
-
-						//If ceiling, offset Y 1 px
-						if (normal.y < 0.0f)
-							pixelPosHeight.y += 1.0f;
-
-						//If right-hand side wall, offset X 1 px
-						if (normal.x < 0.0f)
-							pixelPosWidth.x += 1.0f;
-
-						const ion::Vector2i tilePosHeight(ion::maths::Floor(pixelPosHeight.x / (float)tileWidth), ion::maths::Floor(pixelPosHeight.y / (float)tileHeight));
-						const ion::Vector2i tilePosWidth(ion::maths::Floor(pixelPosWidth.x / (float)tileHeight), ion::maths::Floor(pixelPosWidth.y / (float)tileWidth));
-
-						//Draw heightmap
-						if (tilePosHeight.x >= 0 && tilePosHeight.x < mapWidth && tilePosHeight.y >= 0 && tilePosHeight.y < mapHeight)
-						{
-							//Get tile
-							int tileIdx = (tilePosHeight.y * mapWidth) + tilePosHeight.x;
-							TerrainTile& currentTile = terrainTiles[terrainLayer][tileIdx].first;
-							u16& currentFlags = terrainTiles[terrainLayer][tileIdx].second;
-
-							//Draw height at X
-							int pixelX = pixelPosHeight.x - (tilePosHeight.x * tileWidth);
-							int pixelY = pixelPosHeight.y - (tilePosHeight.y * tileHeight);
-							int height = 0;
-
-							if (normal.y < 0.0f)
-								height = -ion::maths::Clamp(pixelY, 1, tileHeight);
-							else
-								height = ion::maths::Clamp(tileHeight - pixelY, 1, tileHeight);
-
-							currentTile.SetHeight(pixelX, height);
-
-							//Set flags
-							if (tilePosHeight.x != prevTilePosHeight.x || tilePosHeight.y != prevTilePosHeight.y)
-							{
-								currentFlags |= terrainFlags | eCollisionTileFlagTerrain;
-								prevTilePosHeight = tilePosHeight;
-								currentTile.SetNormal(normal);
-							}
-
-							//Add normal
-							foundNormals[terrainLayer][tileIdx].first++;
-							foundNormals[terrainLayer][tileIdx].second += normal;
-						}
+					GenerateTerrainSamples(beziers[i], tileWidth, tileHeight, mapWidth, mapHeight, bezierSamples[i]);
+				}
+			}
+		});
 
-#if BEEHIVE_FIXED_STAMP_MODE
-						if (generateWidthData)
-#endif
-						{
-							//Draw widthmap
-							if (tilePosWidth.x >= 0 && tilePosWidth.x < mapWidth && tilePosWidth.y >= 0 && tilePosWidth.y < mapHeight)
-							{
-								//Get tile
-								int tileIdx = (tilePosWidth.y * mapWidth) + tilePosWidth.x;
-								TerrainTile& currentTile = terrainTiles[terrainLayer][tileIdx].first;
-								u16& currentFlags = terrainTiles[terrainLayer][tileIdx].second;
+		//Bucket samples into a grid of cells, keeping drawing order within each cell.
+		//Flags and angle are taken from the first sample after the drawn tile changes, which
+		//carries across beziers, so is resolved here in bezier order.
+		const int cellsWide = (mapWidth + s_terrainCellSize - 1) / s_terrainCellSize;
+		const int cellsHigh = (mapHeight + s_terrainCellSize - 1) / s_terrainCellSize;
+		std::vector<std::vector<const TerrainSample*>> cellSamples(cellsWide * cellsHigh);
+		std::vector<int> activeCells;
 
-								//Draw width at Y
-								int pixelX = pixelPosWidth.x - (tilePosWidth.x * tileWidth);
-								int pixelY = pixelPosWidth.y - (tilePosWidth.y * tileHeight);
-								int width = 0;
+		int prevTileIdxHeight = 0;
+		int prevTileIdxWidth = 0;
 
-								if (normal.x < 0.0f)
-									width = -ion::maths::Clamp(tileWidth - pixelX, 1, tileWidth);
-								else
-									width = ion::maths::Clamp(pixelX, 1, tileWidth);
+		for (int i = 0; i < bezierSamples.size(); i++)
+		{
+			for (int j = 0; j < bezierSamples[i].size(); j++)
+			{
+				TerrainSample& sample = bezierSamples[i][j];
+				int& prevTileIdx = (sample.type == TerrainSample::eHeight) ? prevTileIdxHeight : prevTileIdxWidth;
+				sample.newTile = (sample.tileIdx != prevTileIdx);
+				prevTileIdx = sample.tileIdx;
 
-								currentTile.SetWidth(tileHeight - 1 - pixelY, width);
+				int cellX = (sample.tileIdx % mapWidth) / s_terrainCellSize;
+				int cellY = (sample.tileIdx / mapWidth) / s_terrainCellSize;
+				int cellIdx = (cellY * cellsWide) + cellX;
 
-								//Set flags and angle
-								if (tilePosWidth.x != prevTilePosWidth.x || tilePosWidth.y != prevTilePosWidth.y)
-								{
-									currentFlags |= terrainFlags | eCollisionTileFlagTerrain;
-									prevTilePosWidth = tilePosWidth;
-									currentTile.SetNormal(normal);
-								}
+				if (cellSamples[cellIdx].empty())
+					activeCells.push_back(cellIdx);
 
-								//Add normal
-								foundNormals[terrainLayer][tileIdx].first++;
-								foundNormals[terrainLayer][tileIdx].second += normal;
-							}
-						}
-					}
-
-					prevPosHeight = nextPosHeight;
-					prevPosWidth = nextPosWidth;
-				}
+				cellSamples[cellIdx].push_back(&sample);
 			}
 		}
 
+		//Draw cells, they share no tiles
+		ion::thread::ParallelFor(activeCells.size(), 1, [&](u32 begin, u32 end)
+		{
+			for (u32 i = begin; i < end; i++)
+			{
+				DrawTerrainSamples(cellSamples[activeCells[i]], terrainTiles, foundNormals);
+			}
+		});
+
 		//Average all normals
 		for (int terrainLayer = 0; terrainLayer < maxLayers; terrainLayer++)
 		{
@@ -2453,10 +2694,15 @@ bool Project::GenerateTerrainFromBeziers()
 		//Recompute hashes
 		for (int terrainLayer = 0; terrainLayer < maxLayers; terrainLayer++)
 		{
-			for (int i = 0; i < terrainTiles[terrainLayer].size(); i++)
+			std::vector<std::pair<TerrainTile, u16>>& layerTiles = terrainTiles[terrainLayer];
+
+			ion::thread::ParallelFor(layerTiles.size(), s_importBatchSize, [&](u32 begin, u32 end)
 			{
-				terrainTiles[terrainLayer][i].first.CalculateHash();
-			}
+				for (u32 i = begin; i < end; i++)
+				{
+					layerTiles[i].first.CalculateHash();
+				}
+			});
 		}
 
 		//Find duplicates/draw to map
@@ -2876,11 +3122,23 @@ GameObjectArchetypeId Project::GetPaintGameObjectArchetype() const
 	return m_paintGameObjectArchetype;
 }
 
-bool Project::FindPalette(Colour* pixels, u32 useablePalettes, PaletteId& paletteId, PaletteId& closestPalette, int& closestColourCount) const
+void Project::PackPalettes(PackedPalette packedPalettes[s_maxPalettes]) const
 {
-	//Set of found colour idxs
-	std::set<int> colourMatches;
+	for(int paletteIdx = 0; paletteIdx < s_maxPalettes; paletteIdx++)
+	{
+		const Palette& palette = m_palettes[paletteIdx];
 
+		for(int i = 0; i < Palette::coloursPerPalette; i++)
+		{
+			packedPalettes[paletteIdx].colours[i] = palette.IsColourUsed(i) ? palette.GetColour(i).rgb : 0;
+		}
+
+		packedPalettes[paletteIdx].usedColours = palette.GetUsedColourMask();
+	}
+}
+
+bool Project::FindPalette(const Colour* pixels, u32 useablePalettes, const PackedPalette packedPalettes[s_maxPalettes], PaletteId& paletteId, PaletteId& closestPalette, int& closestColourCount) const
+{
 	const int tileWidth = GetPlatformConfig().tileWidth;
 	const int tileHeight = GetPlatformConfig().tileHeight;
 
@@ -2889,20 +3147,22 @@ bool Project::FindPalette(Colour* pixels, u32 useablePalettes, PaletteId& palett
 	{
 		if(useablePalettes & (1 << paletteIdx))
 		{
-			const Palette& palette = m_palettes[paletteIdx];
+			const PackedPalette& palette = packedPalettes[paletteIdx];
 
 			bool match = true;
-			colourMatches.clear();
+
+			//Mask of found colour idxs
+			u16 colourMatches = 0;
 
 			//For each pixel
 			for(int i = 0; i < tileWidth * tileHeight; i++)
 			{
-				int colourIdx = 0;
+				//Check if this pixel colour is contained in the palette, first matching entry wins
+				u16 colourMask = palette.FindColour(pixels[i].rgb);
 
-				//Check if this pixel colour is contained in the palette
-				if(palette.GetNearestColourIdx(pixels[i], Palette::eExact, colourIdx))
+				if(colourMask)
 				{
-					colourMatches.insert(colourIdx);
+					colourMatches |= colourMask & (~colourMask + 1);
 				}
 				else
 				{
@@ -2916,10 +3176,16 @@ bool Project::FindPalette(Colour* pixels, u32 useablePalettes, PaletteId& palett
 				return true;
 			}
 
-			if(colourMatches.size() > closestColourCount)
+			int numColourMatches = 0;
+			for(; colourMatches; colourMatches &= colourMatches - 1)
+			{
+				numColourMatches++;
+			}
+
+			if(numColourMatches > closestColourCount)
 			{
 				//Found a closer match
-				closestColourCount = colourMatches.size();
+				closestColourCount = numColourMatches;
 				closestPalette = paletteIdx;
 			}
 		}
@@ -2928,7 +3194,122 @@ bool Project::FindPalette(Colour* pixels, u32 useablePalettes, PaletteId& palett
 	return false;
 }
 
-bool Project::ImportPalette(Colour* pixels, Palette& palette)
+void Project::MatchImportTile(const Colour* pixels, u32 useablePalettes, const PackedPalette packedPalettes[s_maxPalettes], ImportTile& importTile) const
+{
+	importTile.paletteId = 0;
+	importTile.closestPaletteId = 0;
+	importTile.closestColourCount = 0;
+	importTile.paletteFound = FindPalette(pixels, useablePalettes, packedPalettes, importTile.paletteId, importTile.closestPaletteId, importTile.closestColourCount);
+
+	if(importTile.paletteFound)
+	{
+		MapImportTileColours(pixels, packedPalettes[importTile.paletteId], importTile);
+	}
+}
+
+bool Project::MapImportTileColours(const Colour* pixels, const PackedPalette& palette, ImportTile& importTile) const
+{
+	const int tileWidth = GetPlatformConfig().tileWidth;
+	const int tileHeight = GetPlatformConfig().tileHeight;
+
+	//Find pixel colours from palette
+	for(int pixelX = 0; pixelX < tileWidth; pixelX++)
+	{
+		for(int pixelY = 0; pixelY < tileHeight; pixelY++)
+		{
+			u16 colourMask = palette.FindColour(pixels[(pixelY * tileWidth) + pixelX].rgb);
+			if(!colourMask)
+			{
+				return false;
+			}
+
+			int colourIdx = 0;
+			while(!(colourMask & (1 << colourIdx)))
+			{
+				colourIdx++;
+			}
+
+			importTile.tile.SetPixelColour(pixelX, pixelY, colourIdx);
+		}
+	}
+
+	//Hash invalidated
+	importTile.tile.CalculateHash();
+	m_tileset.CalculateHashes(importTile.tile, importTile.hashes);
+
+	return true;
+}
+
+bool Project::QuantiseImportTile(const Colour* pixels, int tileSrcX, int tileSrcY, u32 useablePalettes, bool dither, ImportTile& importTile) const
+{
+	const int tileWidth = GetPlatformConfig().tileWidth;
+	const int tileHeight = GetPlatformConfig().tileHeight;
+
+	//Find useable palette with least error
+	int closestPaletteIdx = -1;
+	int closestPaletteError = 0;
+
+	for(int paletteIdx = 0; paletteIdx < s_maxPalettes; paletteIdx++)
+	{
+		const Palette& palette = m_palettes[paletteIdx];
+
+		if((useablePalettes & (1 << paletteIdx)) && palette.GetUsedColourMask() != 0)
+		{
+			int error = 0;
+
+			for(int i = 0; i < tileWidth * tileHeight; i++)
+			{
+				int colourIdx = 0;
+				palette.GetNearestColourIdx(pixels[i], Palette::ePerceptual, colourIdx);
+				error += Palette::GetColourDistance(pixels[i], palette.GetColour(colourIdx), Palette::ePerceptual);
+			}
+
+			if(closestPaletteIdx == -1 || error < closestPaletteError)
+			{
+				closestPaletteIdx = paletteIdx;
+				closestPaletteError = error;
+			}
+		}
+	}
+
+	if(closestPaletteIdx == -1)
+	{
+		return false;
+	}
+
+	const Palette& palette = m_palettes[closestPaletteIdx];
+
+	//Map pixels to nearest colours
+	for(int pixelX = 0; pixelX < tileWidth; pixelX++)
+	{
+		for(int pixelY = 0; pixelY < tileHeight; pixelY++)
+		{
+			const Colour& colour = pixels[(pixelY * tileWidth) + pixelX];
+			int colourIdx = 0;
+
+			if(dither)
+			{
+				palette.GetNearestColourIdxDithered(colour, Palette::ePerceptual, (tileSrcX * tileWidth) + pixelX, (tileSrcY * tileHeight) + pixelY, colourIdx);
+			}
+			else
+			{
+				palette.GetNearestColourIdx(colour, Palette::ePerceptual, colourIdx);
+			}
+
+			importTile.tile.SetPixelColour(pixelX, pixelY, colourIdx);
+		}
+	}
+
+	//Hash invalidated
+	importTile.tile.CalculateHash();
+	m_tileset.CalculateHashes(importTile.tile, importTile.hashes);
+
+	importTile.paletteId = closestPaletteIdx;
+
+	return true;
+}
+
+bool Project::ImportPalette(const Colour* pixels, Palette& palette)
 {
 	//Add first colour
 	palette.AddColour(pixels[0]);
@@ -3157,6 +3538,79 @@ bool Project::ImportBitmap(const std::string& filename, u32 importFlags, u32 pal
 			tilesHeight = stampHeight;
 		}
 
+		const bool wholePalette = (importFlags & eTileImportWholePalette) != 0;
+		const int pixelsPerTile = tileWidth * tileHeight;
+		const int tilesPerStamp = tilesWidth * tilesHeight;
+		const int numTiles = stampsWidth * stampsHeight * tilesPerStamp;
+
+		//Cut all tiles into one contiguous pixel array, in import order
+		std::vector<Colour> tilePixels(wholePalette ? 0 : (numTiles * pixelsPerTile));
+		std::vector<ImportTile> importTiles(numTiles, ImportTile(tileWidth, tileHeight));
+
+		ion::thread::ParallelFor(numTiles, s_importBatchSize, [&](u32 begin, u32 end)
+		{
+			for (u32 tileIdx = begin; tileIdx < end; tileIdx++)
+			{
+				//Stamps in column order, tiles within stamps in row order
+				int stampIdx = tileIdx / tilesPerStamp;
+				int stampTileIdx = tileIdx % tilesPerStamp;
+				int tileSrcX = (stampTileIdx % tilesWidth) + ((stampIdx / stampsHeight) * stampWidth);
+				int tileSrcY = (stampTileIdx / tilesWidth) + ((stampIdx % stampsHeight) * stampHeight);
+
+				if (wholePalette)
+				{
+					ImportTile& importTile = importTiles[tileIdx];
+
+					//Copy colour indices directly
+					for (int pixelX = 0; pixelX < tileWidth; pixelX++)
+					{
+						for (int pixelY = 0; pixelY < tileHeight; pixelY++)
+						{
+							int sourcePixelX = (tileSrcX * tileWidth) + pixelX;
+							int sourcePixelY = (tileSrcY * tileHeight) + pixelY;
+							importTile.tile.SetPixelColour(pixelX, pixelY, reader->GetColourIndex(sourcePixelX, sourcePixelY));
+						}
+					}
+
+					importTile.tile.CalculateHash();
+					m_tileset.CalculateHashes(importTile.tile, importTile.hashes);
+				}
+				else
+				{
+					Colour* pixels = &tilePixels[tileIdx * pixelsPerTile];
+
+					//Read pixel colours from bitmap
+					for (int pixelX = 0; pixelX < tileWidth; pixelX++)
+					{
+						for (int pixelY = 0; pixelY < tileHeight; pixelY++)
+						{
+							int sourcePixelX = (tileSrcX * tileWidth) + pixelX;
+							int sourcePixelY = (tileSrcY * tileHeight) + pixelY;
+
+							if (sourcePixelX < reader->GetWidth() && sourcePixelY < reader->GetHeight())
+							{
+								ion::ImageFormat::Colour bmpColour = reader->GetPixel(sourcePixelX, sourcePixelY);
+								pixels[(pixelY * tileWidth) + pixelX] = Colour(bmpColour.r, bmpColour.g, bmpColour.b);
+							}
+							else
+							{
+								ion::ImageFormat::Colour bmpColour = reader->GetPaletteEntry(0);
+								pixels[(pixelY * tileWidth) + pixelX] = Colour(bmpColour.r, bmpColour.g, bmpColour.b);
+							}
+						}
+					}
+				}
+			}
+		});
+
+		//Palettes are matched a batch at a time on worker threads, against the palettes as they were at the start of the batch.
+		//Tiles are then added serially in import order. Once a tile changes the palettes, the rest of the batch is matched again.
+		PackedPalette packedPalettes[s_maxPalettes];
+		PackPalettes(packedPalettes);
+		u32 paletteGeneration = 0;
+		u32 batchPaletteGeneration = 0;
+		int tileIdx = 0;
+
 		//For all NxN stamps
 		for (int stampX = 0; stampX < stampsWidth; stampX++)
 		{
@@ -3172,61 +3626,53 @@ bool Project::ImportBitmap(const std::string& filename, u32 importFlags, u32 pal
 				//For all 8x8 tiles, in row-at-a-time order
 				for (int tileDstY = 0; tileDstY < tilesHeight; tileDstY++)
 				{
-					for (int tileDstX = 0; tileDstX < tilesWidth; tileDstX++)
+					for (int tileDstX = 0; tileDstX < tilesWidth; tileDstX++, tileIdx++)
 					{
-						int tileSrcX = tileDstX + (stampX * stampWidth);
-						int tileSrcY = tileDstY + (stampY * stampHeight);
-
-						Tile tile(m_platformConfig.tileWidth, m_platformConfig.tileHeight);
-						PaletteId paletteId = (importFlags & eTileImportWholePalette) ? paletteIndex : 0;
+						ImportTile& importTile = importTiles[tileIdx];
+						PaletteId paletteId = wholePalette ? paletteIndex : 0;
 
-						if (importFlags & eTileImportWholePalette)
+						if (!wholePalette)
 						{
-							//Copy colour indices directly
-							for (int pixelX = 0; pixelX < tileWidth; pixelX++)
+							const Colour* pixels = &tilePixels[tileIdx * pixelsPerTile];
+
+							if ((tileIdx % s_importBatchSize) == 0)
 							{
-								for (int pixelY = 0; pixelY < tileHeight; pixelY++)
+								//Match next batch
+								int batchStart = tileIdx;
+								int batchSize = ion::maths::Min(s_importBatchSize, numTiles - batchStart);
+								batchPaletteGeneration = paletteGeneration;
+
+								ion::thread::ParallelFor(batchSize, 16, [&](u32 begin, u32 end)
 								{
-									int sourcePixelX = (tileSrcX * tileWidth) + pixelX;
-									int sourcePixelY = (tileSrcY * tileHeight) + pixelY;
-									tile.SetPixelColour(pixelX, pixelY, reader->GetColourIndex(sourcePixelX, sourcePixelY));
-								}
+									for (u32 i = begin; i < end; i++)
+									{
+										MatchImportTile(&tilePixels[(batchStart + i) * pixelsPerTile], paletteBits, packedPalettes, importTiles[batchStart + i]);
+									}
+								});
 							}
-						}
-						else
-						{
-							//Search for colours
-							std::vector<Colour> pixels(tileWidth * tileHeight);
 
-							//Read pixel colours from bitmap
-							for (int pixelX = 0; pixelX < tileWidth; pixelX++)
+							if (batchPaletteGeneration != paletteGeneration)
 							{
-								for (int pixelY = 0; pixelY < tileHeight; pixelY++)
-								{
-									int sourcePixelX = (tileSrcX * tileWidth) + pixelX;
-									int sourcePixelY = (tileSrcY * tileHeight) + pixelY;
+								//Palettes changed since batch was matched
+								MatchImportTile(pixels, paletteBits, packedPalettes, importTile);
+							}
 
-									if (sourcePixelX < reader->GetWidth() && sourcePixelY < reader->GetHeight())
-									{
-										ion::ImageFormat::Colour bmpColour = reader->GetPixel(sourcePixelX, sourcePixelY);
-										pixels[(pixelY * tileWidth) + pixelX] = Colour(bmpColour.r, bmpColour.g, bmpColour.b);
-									}
-									else
-									{
-										ion::ImageFormat::Colour bmpColour = reader->GetPaletteEntry(0);
-										pixels[(pixelY * tileWidth) + pixelX] = Colour(bmpColour.r, bmpColour.g, bmpColour.b);
-									}
-								}
+							if (!importTile.paletteFound && (importFlags & eTileImportQuantise))
+							{
+								//Quantise to closest existing palette, rather than creating one
+								int tileSrcX = tileDstX + (stampX * stampWidth);
+								int tileSrcY = tileDstY + (stampY * stampHeight);
+								importTile.paletteFound = QuantiseImportTile(pixels, tileSrcX, tileSrcY, paletteBits, (importFlags & eTileImportDither) != 0, importTile);
 							}
 
+							paletteId = importTile.paletteId;
+
 							//Find or create palette
-							PaletteId closestPaletteId = 0;
-							int closestPaletteColourMatches = 0;
-							if (!FindPalette(pixels.data(), paletteBits, paletteId, closestPaletteId, closestPaletteColourMatches))
+							if (!importTile.paletteFound)
 							{
 								//Import palette
 								Palette importedPalette;
-								if (!ImportPalette(pixels.data(), importedPalette))
+								if (!ImportPalette(pixels, importedPalette))
 								{
 									//TODO: wx message handler in ion::debug
 									//wxMessageBox("Too many colours in tile, bailing out", "Error", wxOK | wxICON_ERROR);
@@ -3242,7 +3688,7 @@ bool Project::ImportBitmap(const std::string& filename, u32 importFlags, u32 pal
 
 								for (int i = 0; i < Palette::coloursPerPalette; i++)
 								{
-									if (m_palettes[closestPaletteId].IsColourUsed(i))
+									if (m_palettes[importTile.closestPaletteId].IsColourUsed(i))
 									{
 										closestPaletteUsedColours++;
 									}
@@ -3257,14 +3703,14 @@ bool Project::ImportBitmap(const std::string& filename, u32 importFlags, u32 pal
 								}
 
 								int spareColours = Palette::coloursPerPalette - closestPaletteUsedColours;
-								int requiredNewColours = importedPaletteUsedColours - closestPaletteColourMatches;
+								int requiredNewColours = importedPaletteUsedColours - importTile.closestColourCount;
 
 								if (spareColours >= requiredNewColours)
 								{
 									//Merge palettes
-									if (MergePalettes(m_palettes[closestPaletteId], importedPalette))
+									if (MergePalettes(m_palettes[importTile.closestPaletteId], importedPalette))
 									{
-										paletteId = closestPaletteId;
+										paletteId = importTile.closestPaletteId;
 										merged = true;
 									}
 								}
@@ -3293,33 +3739,23 @@ bool Project::ImportBitmap(const std::string& filename, u32 importFlags, u32 pal
 									//Use imported palette
 									m_palettes[paletteId] = importedPalette;
 								}
-							}
 
-							//Get palette
-							Palette& palette = m_palettes[paletteId];
+								//Palettes changed
+								PackPalettes(packedPalettes);
+								paletteGeneration++;
 
-							//Find pixel colours from palette
-							for (int pixelX = 0; pixelX < tileWidth; pixelX++)
-							{
-								for (int pixelY = 0; pixelY < tileHeight; pixelY++)
+								if (!MapImportTileColours(pixels, packedPalettes[paletteId], importTile))
 								{
-									int colourIdx = 0;
-									if (!palette.GetNearestColourIdx(pixels[(pixelY * tileWidth) + pixelX], Palette::eExact, colourIdx))
-									{
-										//Shouldn't reach here - palette should have been validated
-										//TODO: wx message handler in ion::debug
-										//wxMessageBox("Error mapping colour indices", "Error", wxOK | wxICON_ERROR);
-										ion::debug::log << "Error mapping colour indices, bailing out: " << filename << ion::debug::end;
-										return false;
-									}
-
-									tile.SetPixelColour(pixelX, pixelY, colourIdx);
+									//Shouldn't reach here - palette should have been validated
+									//TODO: wx message handler in ion::debug
+									//wxMessageBox("Error mapping colour indices", "Error", wxOK | wxICON_ERROR);
+									ion::debug::log << "Error mapping colour indices, bailing out: " << filename << ion::debug::end;
+									return false;
 								}
 							}
 						}
 
-						//Hash invalidated
-						tile.CalculateHash();
+						const Tile& tile = importTile.tile;
 
 						//Find duplicate or create new
 						TileId tileId = 0;
@@ -3328,7 +3764,7 @@ bool Project::ImportBitmap(const std::string& filename, u32 importFlags, u32 pal
 
 						if (!(importFlags & eTileImportNoDuplicateTileCheck))
 						{
-							duplicateId = m_tileset.FindDuplicate(tile, tileFlags);
+							duplicateId = m_tileset.FindDuplicate(tile, importTile.hashes, tileFlags);
 						}
 
 						if (duplicateId != InvalidTileId)
@@ -3338,14 +3774,9 @@ bool Project::ImportBitmap(const std::string& filename, u32 importFlags, u32 pal
 						}
 						else
 						{
-							//Create new tile and copy
-							tileId = m_tileset.AddTile();
-							Tile* newTile = m_tileset.GetTile(tileId);
-							newTile->CopyPixels(tile);
-							newTile->SetPaletteId(paletteId);
-
-							//Re-add to hash map
-							m_tileset.HashChanged(tileId);
+							//Create new tile and copy, hashed on add. Stamp hashes stay valid, no stamp can use the new id yet.
+							tileId = m_tileset.AddTile(tile);
+							m_tileset.GetTile(tileId)->SetPaletteId(paletteId);
 						}
 
 						if (importFlags & eTileImportDrawToMap)
@@ -3381,6 +3812,291 @@ bool Project::ImportBitmap(const std::string& filename, u32 importFlags, u32 pal
 	return true;
 }
 
+namespace
+{
+	//Fingerprint of an object's serialised content
+	template <typename T> u64 ExportFingerprint(const T& object)
+	{
+		ion::io::MemoryStream stream;
+
+		{
+			ion::io::Archive archive(stream, ion::io::Archive::Direction::Out);
+			archive.Serialise(const_cast<T&>(object));
+		}
+
+		return ion::HashFast64(stream.Raw().data(), stream.Raw().size());
+	}
+
+	u64 CombineFingerprints(std::initializer_list<u64> fingerprints)
+	{
+		return ion::HashFast64(fingerprints.begin(), fingerprints.size() * sizeof(u64));
+	}
+}
+
+bool Project::LoadExportManifest(const std::string& filename, TExportManifest& manifest) const
+{
+	manifest.clear();
+
+	if(ion::io::FileExists(filename))
+	{
+		ion::io::File file(filename, ion::io::File::OpenMode::Read);
+		if(file.IsOpen())
+		{
+			ion::io::Archive archive(file, ion::io::Archive::Direction::In);
+			archive.Serialise(manifest, "stages");
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Project::SaveExportManifest(const std::string& filename, const TExportManifest& manifest) const
+{
+	ion::io::File file(filename, ion::io::File::OpenMode::Write);
+	if(file.IsOpen())
+	{
+		ion::io::Archive archive(file, ion::io::Archive::Direction::Out);
+		archive.Serialise(const_cast<TExportManifest&>(manifest), "stages");
+		return true;
+	}
+
+	return false;
+}
+
+bool Project::ExportAll(std::vector<ExportStageTiming>& timings, const std::string& manifestFilename, u32 maxThreads)
+{
+	//Stages only write their own files and read project data, except block stages which
+	//regenerate map/collision map blocks, so block maps must wait for them.
+	const ExportFormat format = m_exportFilenames.exportFormat;
+	const int blockWidth = m_platformConfig.blockWidth;
+	const int blockHeight = m_platformConfig.blockHeight;
+	const int terrainBlockWidth = m_platformConfig.terrainBlockWidth;
+	const int terrainBlockHeight = m_platformConfig.terrainBlockHeight;
+
+	const ExportFilenames& filenames = m_exportFilenames;
+
+	struct ExportStage
+	{
+		std::string key;
+		std::string name;
+		std::string filename;
+		ion::thread::TaskGraph::Task task;
+		int dependency;
+		u64 fingerprint;
+		bool dirty;
+		ion::thread::TaskGraph::TaskId taskId;
+	};
+
+	std::vector<ExportStage> stages;
+
+	//Fingerprint each input once, stages combine the ones they read
+	const u64 commonInputs = CombineFingerprints({ ExportFingerprint(m_name), ExportFingerprint(m_platformConfig), (u64)format });
+	const u64 paletteInputs = CombineFingerprints({ ExportFingerprint(m_palettes), ExportFingerprint(m_paletteSlots) });
+	const u64 tilesetInputs = ExportFingerprint(m_tileset);
+	const u64 stampInputs = ExportFingerprint(m_stamps);
+	const u64 terrainTilesetInputs = ExportFingerprint(m_terrainTileset);
+	//Blank collision cells export as the default terrain tile
+	const u64 defaultTerrainTileInput = (u64)m_defaultTerrainTile;
+	const u64 gameObjectTypeInputs = ExportFingerprint(m_gameObjectTypes);
+	const u64 actorInputs = ExportFingerprint(m_actors);
+	const u64 animationInputs = ExportFingerprint(m_animations);
+	const u64 backgroundInputs = CombineFingerprints({ (u64)m_backgroundTile, (u64)m_backgroundStamp });
+
+	std::map<MapId, u64> mapInputs;
+	std::map<MapId, u64> collisionMapInputs;
+	u64 allMapInputs = 0;
+	u64 allCollisionMapInputs = 0;
+
+	for(TMapMap::const_iterator it = m_maps.begin(), end = m_maps.end(); it != end; ++it)
+	{
+		mapInputs[it->first] = ExportFingerprint(it->second);
+		allMapInputs = CombineFingerprints({ allMapInputs, it->first, mapInputs[it->first] });
+	}
+
+	for(TCollisionMapMap::const_iterator it = m_collisionMaps.begin(), end = m_collisionMaps.end(); it != end; ++it)
+	{
+		collisionMapInputs[it->first] = ExportFingerprint(it->second);
+		allCollisionMapInputs = CombineFingerprints({ allCollisionMapInputs, it->first, collisionMapInputs[it->first] });
+	}
+
+	//Directory stages pass an empty filename, they aren't checked for missing output
+	auto addStage = [&](const std::string& key, const std::string& name, const std::string& filename, u64 inputs, const ion::thread::TaskGraph::Task& task) -> int
+	{
+		ExportStage stage;
+		stage.key = key;
+		stage.name = name;
+		stage.filename = filename;
+		stage.task = task;
+		stage.dependency = -1;
+		stage.fingerprint = CombineFingerprints({ commonInputs, ion::HashFast64(key.data(), key.size()), ion::HashFast64(filename.data(), filename.size()), inputs });
+		stage.dirty = true;
+		stage.taskId = ion::thread::TaskGraph::InvalidTaskId;
+		stages.push_back(stage);
+		return stages.size() - 1;
+	};
+
+	int blocksStage = -1;
+	int terrainBlocksStage = -1;
+
+	if(filenames.palettesExportEnabled)
+		addStage("palettes", "Palettes", filenames.palettes, paletteInputs, [&]() { return ExportPalettes(filenames.palettes, format); });
+
+	if(filenames.tilesetExportEnabled)
+		addStage("tiles", "Tiles", filenames.tileset, tilesetInputs, [&]() { return ExportTiles(filenames.tileset, format); });
+
+	if(filenames.blockExportEnabled)
+		blocksStage = addStage("blocks", "Blocks", filenames.blocks, CombineFingerprints({ allMapInputs, stampInputs, tilesetInputs, backgroundInputs }), [&]() { return ExportBlocks(filenames.blocks, format, blockWidth, blockHeight); });
+
+	if(filenames.stampsExportEnabled)
+		addStage("stamps", "Stamps", filenames.stamps, CombineFingerprints({ stampInputs, tilesetInputs }), [&]() { return ExportStamps(filenames.stamps, format); });
+
+	if(filenames.stampAnimsExportEnabled)
+		addStage("stampAnims", "Stamp anims", filenames.stampAnims, stampInputs, [&]() { return ExportStampAnims(filenames.stampAnims, format); });
+
+	if(filenames.terrainTilesExportEnabled)
+		addStage("terrainTiles", "Terrain tiles", filenames.terrainTiles, terrainTilesetInputs, [&]() { return ExportTerrainTiles(filenames.terrainTiles, format); });
+
+	if(filenames.terrainBlockExportEnabled)
+		terrainBlocksStage = addStage("terrainBlocks", "Terrain blocks", filenames.terrainBlocks, CombineFingerprints({ allCollisionMapInputs, terrainTilesetInputs, defaultTerrainTileInput }), [&]() { return ExportTerrainBlocks(filenames.terrainBlocks, format, terrainBlockWidth, terrainBlockHeight); });
+
+	if(filenames.terrainAngleExportEnabled)
+		addStage("terrainAngles", "Terrain angles", filenames.terrainAngles, terrainTilesetInputs, [&]() { return ExportTerrainAngles(filenames.terrainAngles, format); });
+
+	if(filenames.gameObjTypesExportEnabled)
+		addStage("gameObjTypes", "Game object types", filenames.gameObjTypes, gameObjectTypeInputs, [&]() { return ExportGameObjectTypes(filenames.gameObjTypes, format, true); });
+
+	if(filenames.spriteSheetsExportEnabled)
+		addStage("spriteSheets", "Sprite sheets", "", CombineFingerprints({ actorInputs, ExportFingerprint(filenames.spriteSheets) }), [&]() { return ExportSpriteSheets(filenames.spriteSheets, format); });
+
+	if(filenames.spriteAnimsExportEnabled)
+		addStage("spriteAnims", "Sprite anims", "", CombineFingerprints({ actorInputs, ExportFingerprint(filenames.spriteAnims) }), [&]() { return ExportSpriteAnims(filenames.spriteAnims, format); });
+
+	if(filenames.spritePalettesExportEnabled)
+		addStage("spritePalettes", "Sprite palettes", "", CombineFingerprints({ actorInputs, ExportFingerprint(filenames.spritePalettes) }), [&]() { return ExportSpritePalettes(filenames.spritePalettes); });
+
+	for(TMapMap::const_iterator it = m_maps.begin(), end = m_maps.end(); it != end; ++it)
+	{
+		const MapId mapId = it->first;
+		const Map::ExportFilenames& mapFilenames = it->second.m_exportFilenames;
+		const std::string& mapName = it->second.GetName();
+		const bool hasCollisionMap = m_collisionMaps.find(mapId) != m_collisionMaps.end();
+		const u64 mapInput = mapInputs[mapId];
+
+		std::stringstream mapKey;
+		mapKey << "map" << mapId << "_";
+
+		if(mapFilenames.mapExportEnabled)
+			addStage(mapKey.str() + "map", mapName + " map", mapFilenames.map, CombineFingerprints({ mapInput, stampInputs, tilesetInputs, backgroundInputs }), [&, mapId]() { return ExportMap(mapId, mapFilenames.map, format); });
+
+		if(mapFilenames.stampMapExportEnabled)
+			addStage(mapKey.str() + "stampMap", mapName + " stamp map", mapFilenames.stampMap, CombineFingerprints({ mapInput, stampInputs, tilesetInputs }), [&, mapId]() { return ExportStampMap(mapId, mapFilenames.stampMap, format); });
+
+		if(mapFilenames.sceneAnimExportEnabled)
+			addStage(mapKey.str() + "sceneAnims", mapName + " scene anims", mapFilenames.sceneAnims, CombineFingerprints({ mapInput, animationInputs, gameObjectTypeInputs }), [&, mapId]() { return ExportSceneAnimations(mapId, mapFilenames.sceneAnims, format); });
+
+		if(mapFilenames.gameObjectsExportEnabled)
+			addStage(mapKey.str() + "gameObjects", mapName + " game objects", mapFilenames.gameObjects, CombineFingerprints({ mapInput, gameObjectTypeInputs, actorInputs }), [&, mapId]() { return ExportGameObjects(mapId, mapFilenames.gameObjects, format); });
+
+		//Block indices are shared by all maps, so block maps read every map through the block stage
+		if(mapFilenames.blockMapExportEnabled)
+		{
+			int stage = addStage(mapKey.str() + "blockMap", mapName + " block map", mapFilenames.blockMap, CombineFingerprints({ mapInput, allMapInputs, stampInputs, tilesetInputs, backgroundInputs }), [&, mapId]() { return ExportBlockMap(mapId, mapFilenames.blockMap, format, blockWidth, blockHeight); });
+			stages[stage].dependency = blocksStage;
+		}
+
+		if(hasCollisionMap)
+		{
+			const u64 collisionMapInput = collisionMapInputs[mapId];
+
+			if(mapFilenames.collisionMapExportEnabled)
+				addStage(mapKey.str() + "collisionMap", mapName + " collision map", mapFilenames.collisionMap, CombineFingerprints({ mapInput, collisionMapInput, terrainTilesetInputs, defaultTerrainTileInput }), [&, mapId]() { return ExportCollisionMap(mapId, mapFilenames.collisionMap, format); });
+
+			if(mapFilenames.terrainBlockMapExportEnabled)
+			{
+				int stage = addStage(mapKey.str() + "terrainBlockMap", mapName + " terrain block map", mapFilenames.terrainBlockMap, CombineFingerprints({ mapInput, allCollisionMapInputs, terrainTilesetInputs, defaultTerrainTileInput }), [&, mapId]() { return ExportTerrainBlockMap(mapId, mapFilenames.terrainBlockMap, format, terrainBlockWidth, terrainBlockHeight); });
+				stages[stage].dependency = terrainBlocksStage;
+			}
+		}
+	}
+
+	//Skip stages whose inputs match the manifest and whose output is still there
+	TExportManifest manifest;
+	if(manifestFilename.size() > 0)
+	{
+		LoadExportManifest(manifestFilename, manifest);
+
+		for(int i = 0; i < stages.size(); i++)
+		{
+			TExportManifest::const_iterator it = manifest.find(stages[i].key);
+			bool outputExists = stages[i].filename.empty() || ion::io::FileExists(stages[i].filename);
+			stages[i].dirty = (it == manifest.end()) || (it->second != stages[i].fingerprint) || !outputExists;
+		}
+
+		//Block maps need blocks generated in memory, rerun the block stage too
+		for(int i = 0; i < stages.size(); i++)
+		{
+			if(stages[i].dirty && stages[i].dependency >= 0)
+			{
+				stages[stages[i].dependency].dirty = true;
+			}
+		}
+	}
+
+	ion::thread::TaskGraph graph;
+
+	for(int i = 0; i < stages.size(); i++)
+	{
+		if(stages[i].dirty)
+		{
+			stages[i].taskId = graph.AddTask(stages[i].name, stages[i].task);
+		}
+	}
+
+	for(int i = 0; i < stages.size(); i++)
+	{
+		if(stages[i].dirty && stages[i].dependency >= 0)
+		{
+			graph.AddDependency(stages[i].taskId, stages[stages[i].dependency].taskId);
+		}
+	}
+
+	bool result = graph.Run(maxThreads);
+
+	timings.resize(stages.size());
+
+	for(int i = 0; i < stages.size(); i++)
+	{
+		ExportStageTiming& timing = timings[i];
+		timing.name = stages[i].name;
+		timing.upToDate = !stages[i].dirty;
+		timing.seconds = stages[i].dirty ? graph.GetTaskTime(stages[i].taskId) : 0.0;
+		timing.result = stages[i].dirty ? graph.GetTaskResult(stages[i].taskId) : true;
+		timing.skipped = stages[i].dirty ? graph.GetTaskSkipped(stages[i].taskId) : false;
+
+		//Record successful stages, failed stages are retried next time
+		if(timing.result)
+		{
+			manifest[stages[i].key] = stages[i].fingerprint;
+		}
+		else
+		{
+			manifest.erase(stages[i].key);
+		}
+
+		ion::debug::log << "Export " << timing.name << ": " << (timing.upToDate ? "up to date" : (timing.skipped ? "skipped" : (timing.result ? "ok" : "FAILED"))) << ", " << (float)timing.seconds << "s" << ion::debug::end;
+	}
+
+	ion::debug::log << "Export complete in " << (float)graph.GetTotalTime() << "s, " << graph.GetNumTasks() << " of " << (int)stages.size() << " stages run" << ion::debug::end;
+
+	if(manifestFilename.size() > 0)
+	{
+		SaveExportManifest(manifestFilename, manifest);
+	}
+
+	return result;
+}
+
 void Project::WriteIncludeFile(const std::string& projectDir, const std::string& exportDir, const std::string& includeFilename, const std::vector<IncludeFile>& filenames, bool generateLabel) const
 {
 	if (filenames.size() > 0 && projectDir.size() > 0)
@@ -3766,6 +4482,114 @@ bool Project::ExportMap(MapId mapId, const std::string& filename, ExportFormat f
 	return false;
 }
 
+bool Project::IsSolidColourTile(const Tile& tile) const
+{
+	u8 firstColourIdx = tile.GetPixelColour(0, 0);
+
+	for(int tileX = 0; tileX < m_platformConfig.tileWidth; tileX++)
+	{
+		for(int tileY = 0; tileY < m_platformConfig.tileHeight; tileY++)
+		{
+			if(tile.GetPixelColour(tileX, tileY) != firstColourIdx)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+u64 Project::HashBlock(const Map::Block& block, TBlockTileKeyCache& tileKeyCache) const
+{
+	std::vector<u64> tileKeys(block.m_tiles.size() * 2);
+	std::vector<u8> pixels;
+
+	for(int i = 0; i < block.m_tiles.size(); i++)
+	{
+		TileId tileId = block.m_tiles[i].m_id;
+		u32 tileFlags = block.m_tiles[i].m_flags;
+
+		if(const Tile* tile = m_tileset.GetTile(tileId))
+		{
+			//Hash pixels once per tile, tiles with equal pixels hash equal regardless of id
+			TBlockTileKeyCache::iterator it = tileKeyCache.find(tileId);
+			if(it == tileKeyCache.end())
+			{
+				tile->GetPixels(pixels);
+
+				BlockTileKey key;
+				key.pixelHash = ion::HashFast64(pixels.data(), pixels.size());
+				key.solid = IsSolidColourTile(*tile);
+				it = tileKeyCache.insert(std::make_pair(tileId, key)).first;
+			}
+
+			//Solid colour tiles only need priority to match
+			tileKeys[i * 2] = it->second.pixelHash;
+			tileKeys[(i * 2) + 1] = it->second.solid ? (tileFlags & Map::eHighPlane) : tileFlags;
+		}
+		else
+		{
+			//No tile, only matches same id and flags
+			tileKeys[i * 2] = tileId;
+			tileKeys[(i * 2) + 1] = ((u64)1 << 32) | tileFlags;
+		}
+	}
+
+	return ion::HashFast64(tileKeys.data(), tileKeys.size() * sizeof(u64));
+}
+
+bool Project::CompareBlocks(const Map::Block& blockA, const Map::Block& blockB) const
+{
+	if(blockA == blockB)
+	{
+		return true;
+	}
+
+	if(blockA.m_tiles.size() != blockB.m_tiles.size())
+	{
+		return false;
+	}
+
+	for(int i = 0; i < blockA.m_tiles.size(); i++)
+	{
+		TileId tileIdA = blockA.m_tiles[i].m_id;
+		TileId tileIdB = blockB.m_tiles[i].m_id;
+		u32 tileFlagsA = blockA.m_tiles[i].m_flags;
+		u32 tileFlagsB = blockB.m_tiles[i].m_flags;
+
+		//If tile ids and flags match, tile is definitely equal
+		if(tileIdA != tileIdB || tileFlagsA != tileFlagsB)
+		{
+			//Check tile A == tile B without taking id or flip flags into account
+			const Tile* tileA = m_tileset.GetTile(tileIdA);
+			const Tile* tileB = m_tileset.GetTile(tileIdB);
+
+			if(!tileA || !tileB || !(*tileA == *tileB))
+			{
+				//Tiles don't match
+				return false;
+			}
+
+			if(IsSolidColourTile(*tileA))
+			{
+				//Solid colour, only priority flags must match
+				if((tileFlagsA & Map::eHighPlane) != (tileFlagsB & Map::eHighPlane))
+				{
+					return false;
+				}
+			}
+			else if(tileFlagsA != tileFlagsB)
+			{
+				//Not solid colour, all flags must match
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 bool Project::ExportBlocks(const std::string& filename, ExportFormat format, int blockWidth, int blockHeight)
 {
 	//Generate map blocks and concatenate into one list
@@ -3782,83 +4606,30 @@ bool Project::ExportBlocks(const std::string& filename, ExportFormat format, int
 		}
 	}
 
-	//Find unique blocks
+	//Find unique blocks, bucketed by content hash
 	std::vector<Map::Block*> uniqueBlocks;
+	std::unordered_map<u64, std::vector<int>> uniqueBlocksByHash;
+	TBlockTileKeyCache tileKeyCache;
 
 	for(int i = 0; i < blocks.size(); i++)
 	{
-		Map::Block* blockA = blocks[i];
+		std::vector<int>& bucket = uniqueBlocksByHash[HashBlock(*blocks[i], tileKeyCache)];
+
+		for(int j = 0; j < bucket.size() && blocks[i]->uniqueIndex == -1; j++)
+		{
+			if(CompareBlocks(*uniqueBlocks[bucket[j]], *blocks[i]))
+			{
+				blocks[i]->uniqueIndex = bucket[j];
+			}
+		}
 
 		if(blocks[i]->uniqueIndex == -1)
 		{
 			blocks[i]->uniqueIndex = uniqueBlocks.size();
 			blocks[i]->unique = true;
 
+			bucket.push_back(uniqueBlocks.size());
 			uniqueBlocks.push_back(blocks[i]);
-
-			for(int j = i + 1; j < blocks.size(); j++)
-			{
-				Map::Block* blockB = blocks[j];
-
-				bool equal = true;
-
-				if(!(*blocks[i] == *blocks[j]))
-				{
-					//Solid (all pixels same colour) tiles are considered equivalent regardless of flip flags
-					for(int k = 0; k < blocks[i]->m_tiles.size() && equal; k++)
-					{
-						TileId tileIdA = blocks[i]->m_tiles[k].m_id;
-						TileId tileIdB = blocks[j]->m_tiles[k].m_id;
-						u32 tileFlagsA = blocks[i]->m_tiles[k].m_flags;
-						u32 tileFlagsB = blocks[j]->m_tiles[k].m_flags;
-
-						//If tile ids and flags match, tile is definitely equal
-						if(tileIdA != tileIdB || tileFlagsA != tileFlagsB)
-						{
-							//Check tile A == tile B without taking id or flip flags into account
-							const Tile* tileA = m_tileset.GetTile(blocks[i]->m_tiles[k].m_id);
-							const Tile* tileB = m_tileset.GetTile(blocks[j]->m_tiles[k].m_id);
-
-							if(*tileA == *tileB)
-							{
-								//Check if tile is solid colour
-								bool solidColourTile = true;
-
-								u8 firstColourIdx = tileA->GetPixelColour(0, 0);
-
-								for(int tileX = 0; tileX < m_platformConfig.tileWidth && solidColourTile; tileX++)
-								{
-									for(int tileY = 0; tileY < m_platformConfig.tileHeight && solidColourTile; tileY++)
-									{
-										solidColourTile = (firstColourIdx == tileA->GetPixelColour(tileX, tileY));
-									}
-								}
-
-								if (solidColourTile)
-								{
-									//Solid colour, only priority flags must match
-									equal = ((tileFlagsA & Map::eHighPlane) == (tileFlagsB & Map::eHighPlane));
-								}
-								else
-								{
-									//Not solid colour, all flags must match
-									equal = (tileFlagsA == tileFlagsB);
-								}
-							}
-							else
-							{
-								//Tiles don't match
-								equal = false;
-							}
-						}
-					}
-				}
-
-				if(equal)
-				{
-					blocks[j]->uniqueIndex = blocks[i]->uniqueIndex;
-				}
-			}
 		}
 	}
 
@@ -3923,6 +4694,7 @@ bool Project::ExportBlocks(const std::string& filename, ExportFormat format, int
 
 		stream << "map_blocks_" << m_name << "_size_w\tequ (map_blocks_" << m_name << "_size_b/2)\t; Size in words" << std::endl;
 		stream << "map_blocks_" << m_name << "_size_l\tequ (map_blocks_" << m_name << "_size_b/4)\t; Size in longwords" << std::endl;
+		//Decimal in every format, text export used to inherit hex (without a 0x prefix) from the block data
 		stream << "map_blocks_" << m_name << "_num_blocks\tequ " << uniqueBlocks.size() << "\t; Size in blocks" << std::endl;
 
 		file.Write(stream.str().c_str(), stream.str().size());
@@ -4035,23 +4807,29 @@ bool Project::ExportTerrainBlocks(const std::string& filename, ExportFormat form
 		}
 	}
 
-	//Find unique blocks
+	//Find unique blocks, bucketed by content hash
 	std::vector<CollisionMap::Block*> uniqueBlocks;
+	std::unordered_map<u64, std::vector<int>> uniqueBlocksByHash;
 
 	for(int i = 0; i < blocks.size(); i++)
 	{
+		const std::vector<CollisionMap::TTerrainTileDesc>& tiles = blocks[i]->m_tiles;
+		std::vector<int>& bucket = uniqueBlocksByHash[ion::HashFast64(tiles.data(), tiles.size() * sizeof(CollisionMap::TTerrainTileDesc))];
+
+		for(int j = 0; j < bucket.size() && blocks[i]->uniqueIndex == -1; j++)
+		{
+			if(*uniqueBlocks[bucket[j]] == *blocks[i])
+			{
+				blocks[i]->uniqueIndex = bucket[j];
+			}
+		}
+
 		if(blocks[i]->uniqueIndex == -1)
 		{
 			blocks[i]->uniqueIndex = uniqueBlocks.size();
-			uniqueBlocks.push_back(blocks[i]);
 
-			for(int j = i + 1; j < blocks.size(); j++)
-			{
-				if(*blocks[i] == *blocks[j])
-				{
-					blocks[j]->uniqueIndex = blocks[i]->uniqueIndex;
-				}
-			}
+			bucket.push_back(uniqueBlocks.size());
+			uniqueBlocks.push_back(blocks[i]);
 		}
 	}
 
@@ -4111,6 +4889,7 @@ bool Project::ExportTerrainBlocks(const std::string& filename, ExportFormat form
 
 		stream << "terrainmap_blocks_" << m_name << "_size_w\tequ (terrainmap_blocks_" << m_name << "_size_b/2)\t; Size in words" << std::endl;
 		stream << "terrainmap_blocks_" << m_name << "_size_l\tequ (terrainmap_blocks_" << m_name << "_size_b/4)\t; Size in longwords" << std::endl;
+		//Decimal, as for map blocks
 		stream << "terrainmap_blocks_" << m_name << "_num_blocks\tequ " << uniqueBlocks.size() << "\t; Size in blocks" << std::endl;
 
 		file.Write(stream.str().c_str(), stream.str().size());
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 #include "Types.h"
 #include "PlatformConfig.h"
@@ -58,6 +59,8 @@ public:
 		eTileImportInsertBGTile			= (1 << 8),
 		eTileImportOnlyExistingStamps	= (1 << 9),
 		eTileImportNoDuplicateTileCheck	= (1 << 10),
+		eTileImportQuantise				= (1 << 11),	//Map tiles with no exact palette to the nearest colours of the closest existing palette
+		eTileImportDither				= (1 << 12),	//Ordered dither when quantising
 	};
 
 	enum class ExportFormat
@@ -160,7 +163,20 @@ public:
 	void MergePaletteEntries(u8 paletteId, u8 mergeFromIdx, u8 mergeToIdx);
 
 	//Tiles
+	struct TileReplacement
+	{
+		TileId tileId;
+		TileId replacementId;
+		u32 flipFlags;
+	};
+
 	void DeleteTile(TileId tileId);
+
+	//Delete tiles in bulk, compacting the tileset (remaining tiles keep their order) and remapping all
+	//map and stamp references in one pass. References to replaced tiles are redirected to the replacement
+	//and flipped by its flags, references to other deleted tiles are cleared.
+	void DeleteTiles(const std::vector<TileId>& tileIds, const std::vector<TileReplacement>& replacements);
+
 	void SwapTiles(TileId tileId1, TileId tileId2);
 	void SetBackgroundTile(TileId tileId);
 	TileId GetBackgroundTile() const { return m_backgroundTile; }
@@ -334,6 +350,21 @@ public:
 	bool ExportSceneAnimations(MapId mapId, const std::string& filename, ExportFormat format);
 	bool ExportGameObjects(MapId mapId, const std::string& filename, ExportFormat format);
 
+	struct ExportStageTiming
+	{
+		std::string name;
+		double seconds;
+		bool result;
+		bool skipped;
+		bool upToDate;
+	};
+
+	//Run all project and map exports enabled in export filenames. Independent stages run concurrently,
+	//block maps wait for their block stage. Fills timings per stage, returns false if any stage failed.
+	//If a manifest filename is given, stages whose inputs and output filename are unchanged since the
+	//last export, and whose output file still exists, are left alone.
+	bool ExportAll(std::vector<ExportStageTiming>& timings, const std::string& manifestFilename = "", u32 maxThreads = 0);
+
 	//Serialise
 	void Serialise(ion::io::Archive& archive);
 
@@ -458,9 +489,55 @@ public:
 	Settings m_settings;
 
 private:
+	//Palette colours packed for matching against many pixels
+	struct PackedPalette
+	{
+		//Mask of used entries matching colour
+		u16 FindColour(u32 rgb) const
+		{
+			u16 mask = 0;
+
+			for(int i = 0; i < Palette::coloursPerPalette; i++)
+			{
+				mask |= (u16)(colours[i] == rgb) << i;
+			}
+
+			return mask & usedColours;
+		}
+
+		u32 colours[Palette::coloursPerPalette];
+		u16 usedColours;
+	};
+
+	//Bitmap import tile, matched to a palette on a worker thread
+	struct ImportTile
+	{
+		ImportTile(u8 tileWidth, u8 tileHeight) : tile(tileWidth, tileHeight) {}
+
+		Tile tile;
+		u64 hashes[Tileset::eNumHashOrientations];
+		PaletteId paletteId;
+		PaletteId closestPaletteId;
+		int closestColourCount;
+		bool paletteFound;
+	};
+
+	//Tiles per bitmap import batch
+	static const int s_importBatchSize = 256;
+
+	void PackPalettes(PackedPalette packedPalettes[s_maxPalettes]) const;
+
 	//Find palette matching 8x8 colour grid
-	bool FindPalette(Colour* pixels, u32 useablePalettes, PaletteId& paletteId, PaletteId& closestPalette, int& closestColourCount) const;
-	bool ImportPalette(Colour* pixels, Palette& palette);
+	bool FindPalette(const Colour* pixels, u32 useablePalettes, const PackedPalette packedPalettes[s_maxPalettes], PaletteId& paletteId, PaletteId& closestPalette, int& closestColourCount) const;
+
+	//Find palette and colour indices for an import tile, safe to call from worker threads
+	void MatchImportTile(const Colour* pixels, u32 useablePalettes, const PackedPalette packedPalettes[s_maxPalettes], ImportTile& importTile) const;
+	bool MapImportTileColours(const Colour* pixels, const PackedPalette& palette, ImportTile& importTile) const;
+
+	//Map import tile to the useable palette with least perceptual error, false if no useable palette has colours
+	bool QuantiseImportTile(const Colour* pixels, int tileSrcX, int tileSrcY, u32 useablePalettes, bool dither, ImportTile& importTile) const;
+
+	bool ImportPalette(const Colour* pixels, Palette& palette);
 	bool MergePalettes(Palette& dest, const Palette& source);
 
 	//Collapse palette slots to palettes in use
@@ -473,6 +550,51 @@ private:
 	//Get tile at position (including on stamps)
 	TileId GetTileAtPosition(const ion::Vector2i& position);
 
+	//Export block deduplication, solid colour tiles match regardless of flip flags.
+	//Equal blocks always hash equal, so only blocks in the same hash bucket need comparing.
+	struct BlockTileKey
+	{
+		u64 pixelHash;
+		bool solid;
+	};
+
+	typedef std::unordered_map<TileId, BlockTileKey> TBlockTileKeyCache;
+
+	u64 HashBlock(const Map::Block& block, TBlockTileKeyCache& tileKeyCache) const;
+	bool CompareBlocks(const Map::Block& blockA, const Map::Block& blockB) const;
+	bool IsSolidColourTile(const Tile& tile) const;
+
+	//Incremental export manifest, export stage key to fingerprint of the stage's inputs
+	typedef std::map<std::string, u64> TExportManifest;
+
+	bool LoadExportManifest(const std::string& filename, TExportManifest& manifest) const;
+	bool SaveExportManifest(const std::string& filename, const TExportManifest& manifest) const;
+
+	//Stamp duplicate lookup index, keyed by a hash of each stamp's tile hashes and flags.
+	//Stamps are rehashed lazily when their content version or the tileset hash generation changes.
+	template <typename TStampId> struct StampHashIndex
+	{
+		struct Entry
+		{
+			u64 hash;
+			u32 version;
+		};
+
+		StampHashIndex() { tilesetGeneration = 0; }
+
+		void Clear();
+		void Insert(TStampId stampId, u64 hash, u32 version);
+		void Remove(TStampId stampId);
+
+		std::unordered_map<u64, std::vector<TStampId>> buckets;
+		std::map<TStampId, Entry> entries;
+		u32 tilesetGeneration;
+	};
+
+	template <typename TStamp> u64 HashStamp(const TStamp& stamp) const;
+	template <typename TStamp> bool CompareStamps(const TStamp& stampA, const TStamp& stampB) const;
+	template <typename TStampMap, typename TStampId> void RefreshStampHashIndex(const TStampMap& stamps, StampHashIndex<TStampId>& index) const;
+
 	//Platform config
 	PlatformConfig m_platformConfig;
 
@@ -491,6 +613,7 @@ private:
 	//Terrain stamps
 	TTerrainStampMap m_terrainStamps;
 	TerrainStampId m_nextFreeTerrainStampId;
+	mutable StampHashIndex<TerrainStampId> m_terrainStampHashIndex;
 
 	//Map
 	TMapMap m_maps;
@@ -507,6 +630,7 @@ private:
 	//Stamps
 	TStampMap m_stamps;
 	StampId m_nextFreeStampId;
+	mutable StampHashIndex<StampId> m_stampHashIndex;
 
 	//Actors
 	std::map<ActorId, Actor> m_actors;
@@ -17,6 +17,7 @@
 #include <core/string/String.h>
 #include <core/cryptography/Hash.h>
 #include <ion/maths/Geometry.h>
+#include <ion/core/io/AsmEmitter.h>
 
 #define HEX1(val) std::hex << std::setfill('0') << std::setw(1) << std::uppercase << (int)val
 #define HEX2(val) std::hex << std::setfill('0') << std::setw(2) << std::uppercase << (int)val
@@ -28,6 +29,7 @@ Stamp::Stamp()
 	m_width = 0;
 	m_height = 0;
 	m_nameHash = 0;
+	m_contentVersion = 0;
 }
 
 Stamp::Stamp(StampId stampId, const Stamp& rhs)
@@ -42,6 +44,7 @@ Stamp::Stamp(StampId stampId, int width, int height)
 	m_width = width;
 	m_height = height;
 	m_nameHash = 0;
+	m_contentVersion = 0;
 
 	int size = width * height;
 	m_tiles.resize(size);
@@ -155,6 +158,7 @@ void Stamp::Resize(int width, int height, bool shiftRight, bool shiftDown)
 	m_tiles = tiles;
 	m_width = width;
 	m_height = height;
+	m_contentVersion++;
 }
 
 void Stamp::SetTile(int x, int y, TileId tile)
@@ -163,6 +167,7 @@ void Stamp::SetTile(int x, int y, TileId tile)
 	ion::debug::Assert(tileIdx < (m_width * m_height), "Stamp::SetTile() - Out of range");
 	m_tiles[tileIdx].m_id = tile;
 	m_tiles[tileIdx].m_flags = 0;
+	m_contentVersion++;
 }
 
 TileId Stamp::GetTile(int x, int y) const
@@ -190,6 +195,7 @@ void Stamp::SetTileFlags(int x, int y, u32 flags)
 	int tileIdx = (y * m_width) + x;
 	ion::debug::Assert(tileIdx < (m_width * m_height), "Stamp::SetTileFlags() - Out of range");
 	m_tiles[tileIdx].m_flags = flags;
+	m_contentVersion++;
 }
 
 u32 Stamp::GetTileFlags(int x, int y) const
@@ -523,6 +529,11 @@ void Stamp::Serialise(ion::io::Archive& archive)
 	archive.Serialise(m_terrainBeziers, "beziers");
 	archive.Serialise(m_terrainLayers, "terrainLayers");
 
+	if (archive.GetDirection() == ion::io::Archive::Direction::In)
+	{
+		m_contentVersion++;
+	}
+
 	//Legacy single terrain layer
 	if (archive.GetDirection() == ion::io::Archive::Direction::In && m_terrainLayers.size() == 0)
 	{
@@ -538,6 +549,8 @@ void Stamp::Serialise(ion::io::Archive& archive)
 
 void Stamp::Export(const Project& project, std::stringstream& stream) const
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	//Use background tile if there is one, else use first tile
 	u32 backgroundTileId = project.GetBackgroundTile();
 	if(backgroundTileId == InvalidTileId)
@@ -548,11 +561,10 @@ void Stamp::Export(const Project& project, std::stringstream& stream) const
 	//if(project.GetPlatformConfig().platform == ePlatformMegaDrive)
 	{
 		//Output to stream
-		stream << std::hex << std::setfill('0') << std::uppercase;
 
 		for(int y = 0; y < m_height; y++)
 		{
-			stream << "\tdc.w\t";
+			emitter.BeginDcW();
 
 			for(int x = 0; x < m_width; x++)
 			{
@@ -585,16 +597,15 @@ void Stamp::Export(const Project& project, std::stringstream& stream) const
 				//Generate word
 				u16 word = tileIndex | flipV | flipH | palette;
 
-				stream << "0x" << std::setw(4) << (u32)word;
+				emitter.HexLiteral(word, 4);
 
 				if(x < (m_width - 1))
-					stream << ",";
+					emitter.Char(',');
 			}
 
-			stream << std::endl;
+			emitter.NewLine();
 		}
 
-		stream << std::dec;
 	}
 	//else if(project.GetPlatformConfig().platform == ePlatformSNES)
 	{
@@ -60,6 +60,9 @@ public:
 	void SetTileFlags(int x, int y, u32 flags);
 	u32 GetTileFlags(int x, int y) const;
 
+	//Incremented whenever graphics tiles or flags change
+	u32 GetContentVersion() const { return m_contentVersion; }
+
 	//Collision/terrain tiles
 	void SetTerrainTile(int x, int y, TerrainTileId tile, int layer = 0);
 	TerrainTileId GetTerrainTile(int x, int y, int layer = 0) const;
@@ -122,9 +125,12 @@ private:
 	int m_height;
 	std::string m_name;
 	u32 m_nameHash;
+	u32 m_contentVersion;
 
 	struct TileDesc
 	{
+		ION_SERIALISE_POD(u32)
+
 		TileDesc() { m_id = 0; m_flags = 0; }
 		TileDesc(TileId tileId) { m_id = tileId; m_flags = 0; }
 
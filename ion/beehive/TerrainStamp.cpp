@@ -22,6 +22,7 @@ TerrainStamp::TerrainStamp()
 	m_id = InvalidTerrainStampId;
 	m_width = 0;
 	m_height = 0;
+	m_contentVersion = 0;
 }
 
 TerrainStamp::TerrainStamp(TerrainStampId TerrainStampId, const TerrainStamp& rhs)
@@ -35,6 +36,7 @@ TerrainStamp::TerrainStamp(TerrainStampId TerrainStampId, int width, int height)
 	m_id = TerrainStampId;
 	m_width = width;
 	m_height = height;
+	m_contentVersion = 0;
 
 	int size = width * height;
 	m_layers.resize(1);
@@ -69,6 +71,7 @@ int TerrainStamp::GetNumLayers() const
 void TerrainStamp::SetNumLayers(int numLayers)
 {
 	m_layers.resize(numLayers);
+	m_contentVersion++;
 }
 
 void TerrainStamp::Resize(int width, int height, bool shiftRight, bool shiftDown)
@@ -112,6 +115,7 @@ void TerrainStamp::Resize(int width, int height, bool shiftRight, bool shiftDown
 
 	m_width = width;
 	m_height = height;
+	m_contentVersion++;
 }
 
 void TerrainStamp::SetTile(int x, int y, TerrainTileId tile, int layer)
@@ -121,6 +125,7 @@ void TerrainStamp::SetTile(int x, int y, TerrainTileId tile, int layer)
 	ion::debug::Assert(terrainTileIdx < (m_width * m_height), "TerrainStamp::SetTile() - Tile index out of range");
 	m_layers[layer][terrainTileIdx].m_id = tile;
 	m_layers[layer][terrainTileIdx].m_flags = 0;
+	m_contentVersion++;
 }
 
 TerrainTileId TerrainStamp::GetTile(int x, int y, int layer) const
@@ -150,6 +155,7 @@ void TerrainStamp::SetTileFlags(int x, int y, u32 flags, int layer)
 	ion::debug::Assert(layer < m_layers.size(), "TerrainStamp::SetTileFlags() - Layer out of range");
 	ion::debug::Assert(terrainTileIdx < (m_width * m_height), "TerrainStamp::SetTileFlags() - Tile index out of range");
 	m_layers[layer][terrainTileIdx].m_flags = flags;
+	m_contentVersion++;
 }
 
 u32 TerrainStamp::GetTileFlags(int x, int y, int layer) const
@@ -173,4 +179,9 @@ void TerrainStamp::Serialise(ion::io::Archive& archive)
 		m_layers.resize(1);
 		archive.Serialise(m_layers[0], "tiles");
 	}
+
+	if (archive.GetDirection() == ion::io::Archive::Direction::In)
+	{
+		m_contentVersion++;
+	}
 }
@@ -41,15 +41,21 @@ public:
 	void SetTileFlags(int x, int y, u32 flags, int layer = 0);
 	u32 GetTileFlags(int x, int y, int layer = 0) const;
 
+	//Incremented whenever tiles or flags change
+	u32 GetContentVersion() const { return m_contentVersion; }
+
 	void Serialise(ion::io::Archive& archive);
 
 private:
 	TerrainStampId m_id;
 	int m_width;
 	int m_height;
+	u32 m_contentVersion;
 
 	struct TileDesc
 	{
+		ION_SERIALISE_POD(u32)
+
 		TileDesc() { m_id = 0; m_flags = 0; }
 
 		void Serialise(ion::io::Archive& archive)
@@ -151,21 +151,22 @@ void TerrainTile::Serialise(ion::io::Archive& archive)
 
 void TerrainTile::Export(std::stringstream& stream) const
 {
-	stream << std::hex << std::setfill('0') << std::uppercase;
+	ion::io::AsmEmitter emitter(stream);
+	Export(emitter);
+}
 
-	stream << "\tdc.b\t";
+void TerrainTile::Export(ion::io::AsmEmitter& emitter) const
+{
+	emitter.BeginDcB();
 
 	//1 byte per height
 	for(int x = 0; x < m_width; x++)
 	{
-		stream << "0x";
-		stream << std::setw(1) << (int)GetHeight(x);
+		emitter.HexLiteral((u32)(int)GetHeight(x), 1);
 
 		if(x < (m_width-1))
-			stream << ", ";
+			emitter.Text(", ");
 	}
-
-	stream << std::dec;
 }
 
 void TerrainTile::Export(ion::io::File& file) const
@@ -186,7 +187,7 @@ u64 TerrainTile::CalculateHash()
 	data.insert(data.end(), m_widthmap.begin(), m_widthmap.end());
 	data.push_back(m_angleByte);
 
-	m_hash = ion::Hash64((const u8*)data.data(), data.size());
+	m_hash = ion::HashFast64(data.data(), data.size());
 	return m_hash;
 }
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <ion/core/io/Archive.h>
+#include <ion/core/io/AsmEmitter.h>
 #include <ion/maths/Vector.h>
 #include <sstream>
 
@@ -63,6 +64,7 @@ public:
 
 	void Serialise(ion::io::Archive& archive);
 	void Export(std::stringstream& stream) const;
+	void Export(ion::io::AsmEmitter& emitter) const;
 	void Export(ion::io::File& file) const;
 
 private:
@@ -96,7 +96,7 @@ void TerrainTileset::CalculateHash(const TerrainTile& tile, u64& hash) const
 	data.insert(data.end(), heights.begin(), heights.end());
 	data.insert(data.end(), widths.begin(), widths.end());
 
-	hash = ion::Hash64((u8*)data.data(), data.size());
+	hash = ion::HashFast64(data.data(), data.size());
 }
 
 TerrainTileId TerrainTileset::FindDuplicate(const TerrainTile& tile) const
@@ -155,14 +155,22 @@ void TerrainTileset::Serialise(ion::io::Archive& archive)
 {
 	archive.Serialise(m_tiles, "tiles");
 	archive.Serialise(m_hashMap, "hashMap");
+
+	if (archive.GetDirection() == ion::io::Archive::Direction::In)
+	{
+		//Stored hashes may come from an older hash function
+		RebuildHashMap();
+	}
 }
 
 void TerrainTileset::Export(std::stringstream& stream) const
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	for(int i = 0; i < m_tiles.size(); i++)
 	{
-		m_tiles[i].Export(stream);
-		stream << std::endl;
+		m_tiles[i].Export(emitter);
+		emitter.NewLine();
 	}
 }
 
@@ -35,7 +35,7 @@ Tile::Tile(u8 width, u8 height)
 	m_hash = 0;
 	m_width = width;
 	m_height = height;
-	m_pixels.resize(width * height);
+	m_pixels.resize(GetPackedSize(width, height));
 }
 
 bool Tile::operator == (const Tile& rhs) const
@@ -43,6 +43,36 @@ bool Tile::operator == (const Tile& rhs) const
 	return m_pixels == rhs.m_pixels;
 }
 
+bool Tile::CompareFlipped(const Tile& rhs, bool flipX, bool flipY) const
+{
+	if(m_width != rhs.m_width || m_height != rhs.m_height)
+	{
+		return false;
+	}
+
+	if(!flipX && !flipY)
+	{
+		return m_pixels == rhs.m_pixels;
+	}
+
+	for(int y = 0; y < m_height; y++)
+	{
+		int sourceY = flipY ? (m_height - 1 - y) : y;
+
+		for(int x = 0; x < m_width; x++)
+		{
+			int sourceX = flipX ? (m_width - 1 - x) : x;
+
+			if(GetPackedPixel((sourceY * m_height) + sourceX) != rhs.GetPackedPixel((y * m_height) + x))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 void Tile::SetIndex(u32 index)
 {
 	m_index = index;
@@ -57,14 +87,22 @@ void Tile::SetPixelColour(int x, int y, u8 colourIdx)
 {
 	int pixelIdx = (y * m_height) + x;
 	ion::debug::Assert(pixelIdx < (m_width * m_height), "Tile::SetPixelColour() - Out of range");
-	m_pixels[pixelIdx] = colourIdx;
+	ion::debug::Assert(colourIdx < Palette::coloursPerPalette, "Tile::SetPixelColour() - Colour index out of range");
+	SetPackedPixel(pixelIdx, colourIdx);
 }
 
 u8 Tile::GetPixelColour(int x, int y) const
 {
 	int pixelIdx = (y * m_height) + x;
 	ion::debug::Assert(pixelIdx < (m_width * m_height), "Tile::GetPixelColour() - Out of range");
-	return m_pixels[pixelIdx];
+	return GetPackedPixel(pixelIdx);
+}
+
+void Tile::SetPackedPixel(int pixelIdx, u8 colourIdx)
+{
+	int shift = (~pixelIdx & 1) << 2;
+	u8& byte = m_pixels[pixelIdx >> 1];
+	byte = (byte & ~(0xF << shift)) | ((colourIdx & 0xF) << shift);
 }
 
 void Tile::CopyPixels(const Tile& tile)
@@ -74,48 +112,48 @@ void Tile::CopyPixels(const Tile& tile)
 
 void Tile::GetPixels(std::vector<u8>& pixels) const
 {
-	pixels.resize(m_pixels.size());
-	ion::memory::MemCopy(pixels.data(), m_pixels.data(), m_pixels.size());
+	//Unpack to one byte per pixel
+	const int numPixels = m_width * m_height;
+	pixels.resize(numPixels);
+
+	for(int i = 0; i < numPixels; i++)
+	{
+		pixels[i] = GetPackedPixel(i);
+	}
 }
 
 void Tile::FlipX()
 {
-	std::vector<u8> temp;
-	temp.resize(m_width * m_height);
-
-	for(int sourceX = 0; sourceX < m_width; sourceX++)
+	//Swap in place
+	for(int sourceY = 0; sourceY < m_height; sourceY++)
 	{
-		for(int sourceY = 0; sourceY < m_height; sourceY++)
+		for(int sourceX = 0; sourceX < m_width / 2; sourceX++)
 		{
 			int destX = m_width - 1 - sourceX;
-			int destY = sourceY;
 			int pixelSourceIdx = (sourceY * m_height) + sourceX;
-			int pixelDestIdx = (destY * m_height) + destX;
-			temp[pixelDestIdx] = m_pixels[pixelSourceIdx];
+			int pixelDestIdx = (sourceY * m_height) + destX;
+			u8 temp = GetPackedPixel(pixelDestIdx);
+			SetPackedPixel(pixelDestIdx, GetPackedPixel(pixelSourceIdx));
+			SetPackedPixel(pixelSourceIdx, temp);
 		}
 	}
-
-	m_pixels = std::move(temp);
 }
 
 void Tile::FlipY()
 {
-	std::vector<u8> temp;
-	temp.resize(m_width * m_height);
-
-	for(int sourceX = 0; sourceX < m_width; sourceX++)
+	//Swap in place
+	for(int sourceY = 0; sourceY < m_height / 2; sourceY++)
 	{
-		for(int sourceY = 0; sourceY < m_height; sourceY++)
+		for(int sourceX = 0; sourceX < m_width; sourceX++)
 		{
-			int destX = sourceX;
 			int destY = m_height - 1 - sourceY;
 			int pixelSourceIdx = (sourceY * m_height) + sourceX;
-			int pixelDestIdx = (destY * m_height) + destX;
-			temp[pixelDestIdx] = m_pixels[pixelSourceIdx];
+			int pixelDestIdx = (destY * m_height) + sourceX;
+			u8 temp = GetPackedPixel(pixelDestIdx);
+			SetPackedPixel(pixelDestIdx, GetPackedPixel(pixelSourceIdx));
+			SetPackedPixel(pixelSourceIdx, temp);
 		}
 	}
-
-	m_pixels = std::move(temp);
 }
 
 void Tile::SetPaletteId(PaletteId palette)
@@ -135,28 +173,49 @@ void Tile::Serialise(ion::io::Archive& archive)
 	archive.Serialise(m_index, "index");
 	archive.Serialise(m_palette, "palette");
 	archive.Serialise(m_hash, "hash");
-	archive.Serialise(m_pixels, "pixels");
+
+	//Serialised unpacked, one byte per pixel, to keep existing projects compatible
+	std::vector<u8> pixels;
+
+	if(archive.GetDirection() == ion::io::Archive::Direction::Out)
+	{
+		GetPixels(pixels);
+	}
+
+	archive.Serialise(pixels, "pixels");
+
+	if(archive.GetDirection() == ion::io::Archive::Direction::In)
+	{
+		m_pixels.resize(GetPackedSize(m_width, m_height));
+
+		for(int i = 0; i < pixels.size() && i < (m_width * m_height); i++)
+		{
+			SetPackedPixel(i, pixels[i]);
+		}
+	}
 }
 
 void Tile::Export(const PlatformConfig& config, std::stringstream& stream) const
+{
+	ion::io::AsmEmitter emitter(stream);
+	Export(config, emitter);
+}
+
+void Tile::Export(const PlatformConfig& config, ion::io::AsmEmitter& emitter) const
 {
 	//if(config.platform == ePlatformMegaDrive)
 	{
-		stream << std::hex << std::setfill('0') << std::uppercase;
-
 		for(int y = 0; y < m_height; y++)
 		{
-			stream << "\tdc.l\t0x";
+			emitter.BeginDcL().Text("0x");
 
 			for(int x = 0; x < m_width; x++)
 			{
-				stream << std::setw(1) << (int)GetPixelColour(x, y);
+				emitter.Hex(GetPixelColour(x, y), 1);
 			}
 
-			stream << std::endl;
+			emitter.NewLine();
 		}
-
-		stream << std::dec;
 	}
 	//else if(config.platform == ePlatformSNES)
 	{
@@ -218,7 +277,58 @@ u32 Tile::GetBinarySize() const
 
 void Tile::CalculateHash()
 {
-	m_hash = ion::Hash64(m_pixels.data(), m_width * m_height);
+	m_hash = CalculateHashFlipped(false, false);
+}
+
+u64 Tile::CalculateHashFlipped(bool flipX, bool flipY) const
+{
+	//Hash packed pixels
+	if(!flipX && !flipY)
+	{
+		return ion::HashFast64(m_pixels.data(), m_pixels.size());
+	}
+
+	//Repack flipped pixels through a small buffer, streaming gives the same hash as one call over the whole tile
+	ion::HashStream64 stream;
+	u8 buffer[64];
+	int bufferSize = 0;
+	int pixelIdx = 0;
+
+	for(int y = 0; y < m_height; y++)
+	{
+		int sourceY = flipY ? (m_height - 1 - y) : y;
+
+		for(int x = 0; x < m_width; x++, pixelIdx++)
+		{
+			int sourceX = flipX ? (m_width - 1 - x) : x;
+			u8 colourIdx = GetPackedPixel((sourceY * m_height) + sourceX);
+
+			//Even pixel in the high nybble
+			if((pixelIdx & 1) == 0)
+			{
+				buffer[bufferSize] = colourIdx << 4;
+			}
+			else
+			{
+				buffer[bufferSize++] |= colourIdx;
+
+				if(bufferSize == sizeof(buffer))
+				{
+					stream.Update(buffer, bufferSize);
+					bufferSize = 0;
+				}
+			}
+		}
+	}
+
+	//Odd pixel count, last low nybble stays clear
+	if(pixelIdx & 1)
+	{
+		bufferSize++;
+	}
+
+	stream.Update(buffer, bufferSize);
+	return stream.Finalise();
 }
 
 u64 Tile::GetHash() const
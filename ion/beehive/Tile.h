@@ -12,6 +12,7 @@
 #pragma once
 
 #include <ion/core/io/Archive.h>
+#include <ion/core/io/AsmEmitter.h>
 #include <sstream>
 
 #include "Palette.h"
@@ -28,12 +29,18 @@ public:
 
 	bool operator == (const Tile& rhs) const;
 
+	//Compare against rhs as if this tile were flipped, without modifying or copying it
+	bool CompareFlipped(const Tile& rhs, bool flipX, bool flipY) const;
+
 	void SetIndex(u32 index);
 	u32 GetIndex() const;
 
 	void CalculateHash();
 	u64 GetHash() const;
 
+	//Hash of this tile as if it were flipped, equal to GetHash() of a flipped copy. Doesn't allocate.
+	u64 CalculateHashFlipped(bool flipX, bool flipY) const;
+
 	u8 GetWidth() const { return m_width; }
 	u8 GetHeight() const { return m_height; }
 
@@ -50,11 +57,17 @@ public:
 
 	void Serialise(ion::io::Archive& archive);
 	void Export(const PlatformConfig& config, std::stringstream& stream) const;
+	void Export(const PlatformConfig& config, ion::io::AsmEmitter& emitter) const;
 	void Export(const PlatformConfig& config, ion::io::File& file) const;
 	void Export(const PlatformConfig& config, std::vector<u8>& buffer) const;
 	u32 GetBinarySize() const;
 
 private:
+	//Pixels are stored packed at 4bpp, even pixel in the high nybble
+	u8 GetPackedPixel(int pixelIdx) const { return (m_pixels[pixelIdx >> 1] >> ((~pixelIdx & 1) << 2)) & 0xF; }
+	void SetPackedPixel(int pixelIdx, u8 colourIdx);
+	static int GetPackedSize(u8 width, u8 height) { return ((width * height) + 1) / 2; }
+
 	PaletteId m_palette;
 	u32 m_index;
 	u64 m_hash;
@@ -21,16 +21,19 @@ const u32 Tileset::s_orientationFlags[eNumHashOrientations] = { 0, Map::eFlipX,
 Tileset::Tileset()
 {
 	m_platformConfig = nullptr;
+	m_hashGeneration = 0;
 }
 
 Tileset::Tileset(const PlatformConfig& platformConfig)
 	: m_platformConfig(&platformConfig)
 {
+	m_hashGeneration = 0;
 }
 
 void Tileset::Clear()
 {
 	m_tiles.clear();
+	m_hashGeneration++;
 }
 
 TileId Tileset::AddTile()
@@ -43,11 +46,53 @@ TileId Tileset::AddTile()
 	return index;
 }
 
+TileId Tileset::AddTile(const Tile& tile)
+{
+	TileId index = m_tiles.size();
+	m_tiles.push_back(Tile(m_platformConfig->tileWidth, m_platformConfig->tileHeight));
+	m_tiles[index].SetIndex(index);
+	m_tiles[index].CopyPixels(tile);
+	m_tiles[index].CalculateHash();
+	AddToHashMap(index);
+	return index;
+}
+
 void Tileset::PopBackTile()
 {
 	TileId tileId = m_tiles.size() - 1;
 	RemoveFromHashMap(tileId);
 	m_tiles.pop_back();
+	m_hashGeneration++;
+}
+
+void Tileset::RemoveTiles(const std::vector<bool>& removeTiles, std::vector<TileId>& remap)
+{
+	remap.resize(m_tiles.size());
+
+	//Compact in place
+	TileId nextTileId = 0;
+
+	for(TileId tileId = 0; tileId < m_tiles.size(); tileId++)
+	{
+		if(tileId < removeTiles.size() && removeTiles[tileId])
+		{
+			remap[tileId] = InvalidTileId;
+		}
+		else
+		{
+			if(nextTileId != tileId)
+			{
+				m_tiles[nextTileId] = std::move(m_tiles[tileId]);
+			}
+
+			m_tiles[nextTileId].SetIndex(nextTileId);
+			remap[tileId] = nextTileId++;
+		}
+	}
+
+	m_tiles.erase(m_tiles.begin() + nextTileId, m_tiles.end());
+
+	RebuildHashMap();
 }
 
 void Tileset::HashChanged(TileId tileId)
@@ -55,6 +100,7 @@ void Tileset::HashChanged(TileId tileId)
 	RemoveFromHashMap(tileId);
 	m_tiles[tileId].CalculateHash();
 	AddToHashMap(tileId);
+	m_hashGeneration++;
 }
 
 void Tileset::AddToHashMap(TileId tileId)
@@ -95,49 +141,11 @@ void Tileset::RemoveFromHashMap(TileId tileId)
 
 void Tileset::CalculateHashes(const Tile& tile, u64 hashes[Tileset::eNumHashOrientations]) const
 {
-	std::vector<u8> pixels;
-	tile.GetPixels(pixels);
-
-	std::vector<u8> pixelsFlipped(pixels.size());
-
-	const int tileWidth = m_platformConfig->tileWidth;
-	const int tileHeight = m_platformConfig->tileHeight;
-
-	//Normal
-	hashes[eNormal] = ion::Hash64(pixels.data(), pixels.size());
-
-	//Flip X
-	for(int x = 0; x < tileWidth; x++)
-	{
-		for(int y = 0; y < tileHeight; y++)
-		{
-			pixelsFlipped[(y * tileWidth) + (tileWidth - 1 - x)] = pixels[(y * tileWidth) + x];
-		}
-	}
-
-	hashes[eFlipX] = ion::Hash64(pixelsFlipped.data(), pixelsFlipped.size());
-
-	//Flip Y
-	for(int x = 0; x < tileWidth; x++)
-	{
-		for(int y = 0; y < tileHeight; y++)
-		{
-			pixelsFlipped[((tileWidth - 1 - y) * tileWidth) + x] = pixels[(y * tileWidth) + x];
-		}
-	}
-
-	hashes[eFlipY] = ion::Hash64(pixelsFlipped.data(), pixelsFlipped.size());
-
-	//Flip XY
-	for(int x = 0; x < tileWidth; x++)
-	{
-		for(int y = 0; y < tileHeight; y++)
-		{
-			pixelsFlipped[((tileWidth - 1 - y) * tileWidth) + (tileWidth - 1 - x)] = pixels[(y * tileWidth) + x];
-		}
-	}
-
-	hashes[eFlipXY] = ion::Hash64(pixelsFlipped.data(), pixelsFlipped.size());
+	//Must match Tile::CalculateHash() of the flipped tile
+	hashes[eNormal] = tile.CalculateHashFlipped(false, false);
+	hashes[eFlipX] = tile.CalculateHashFlipped(true, false);
+	hashes[eFlipY] = tile.CalculateHashFlipped(false, true);
+	hashes[eFlipXY] = tile.CalculateHashFlipped(true, true);
 }
 
 void Tileset::RebuildHashMap()
@@ -149,6 +157,8 @@ void Tileset::RebuildHashMap()
 		m_tiles[i].CalculateHash();
 		AddToHashMap(i);
 	}
+
+	m_hashGeneration++;
 }
 
 TileId Tileset::FindDuplicate(const Tile& tile, u32& tileFlags) const
@@ -157,6 +167,11 @@ TileId Tileset::FindDuplicate(const Tile& tile, u32& tileFlags) const
 	u64 hashes[eNumHashOrientations];
 	CalculateHashes(tile, hashes);
 
+	return FindDuplicate(tile, hashes, tileFlags);
+}
+
+TileId Tileset::FindDuplicate(const Tile& tile, const u64 hashes[eNumHashOrientations], u32& tileFlags) const
+{
 	//Find duplicate hash of any orientation
 	for(int i = 0; i < eNumHashOrientations; i++)
 	{
@@ -167,23 +182,10 @@ TileId Tileset::FindDuplicate(const Tile& tile, u32& tileFlags) const
 			//Hash match, find exact match of this orientation
 			for(int j = 0; j < it->second.size(); j++)
 			{
-				Tile tempTile = m_tiles[it->second[j]];
+				bool flipX = (i == eFlipX) || (i == eFlipXY);
+				bool flipY = (i == eFlipY) || (i == eFlipXY);
 
-				if(i == eFlipX)
-				{
-					tempTile.FlipX();
-				}
-				else if(i == eFlipY)
-				{
-					tempTile.FlipY();
-				}
-				else if(i == eFlipXY)
-				{
-					tempTile.FlipX();
-					tempTile.FlipY();
-				}
-
-				if(tempTile == tile)
+				if(m_tiles[it->second[j]].CompareFlipped(tile, flipX, flipY))
 				{
 					tileFlags = s_orientationFlags[i];
 					return it->second[j];
@@ -228,6 +230,11 @@ void Tileset::Serialise(ion::io::Archive& archive)
 {
 	archive.Serialise(m_tiles, "tiles");
 
+	if (archive.GetDirection() == ion::io::Archive::Direction::In)
+	{
+		m_hashGeneration++;
+	}
+
 	if (archive.GetContentType() == ion::io::Archive::Content::Full)
 	{
 		archive.Serialise(m_hashMap, "multiHashMap");
@@ -246,10 +253,12 @@ int Tileset::GetBinarySize(const PlatformConfig& config) const
 
 void Tileset::Export(const PlatformConfig& config, std::stringstream& stream) const
 {
+	ion::io::AsmEmitter emitter(stream);
+
 	for(int i = 0; i < m_tiles.size(); i++)
 	{
-		m_tiles[i].Export(config, stream);
-		stream << std::endl;
+		m_tiles[i].Export(config, emitter);
+		emitter.NewLine();
 	}
 }
 
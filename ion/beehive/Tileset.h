@@ -43,9 +43,18 @@ public:
 	void Clear();
 
 	TileId AddTile();
+
+	//Appends a copy of tile's pixels. Like AddTile(), leaves the hash generation alone, no stamp can use the new id yet.
+	TileId AddTile(const Tile& tile);
+
 	void PopBackTile();
+
+	//Remove many tiles in one pass, remaining tiles keep their order.
+	//Fills remap with old to new ids, InvalidTileId for removed tiles.
+	void RemoveTiles(const std::vector<bool>& removeTiles, std::vector<TileId>& remap);
 	void HashChanged(TileId tileId);
 	TileId FindDuplicate(const Tile& tile, u32& tileFlags) const;
+	TileId FindDuplicate(const Tile& tile, const u64 hashes[eNumHashOrientations], u32& tileFlags) const;
 
 	Tile* GetTile(TileId tileId);
 	const Tile* GetTile(TileId tileId) const;
@@ -54,6 +63,9 @@ public:
 	void CalculateHashes(const Tile& tile, u64 hashes[eNumHashOrientations]) const;
 	void RebuildHashMap();
 
+	//Incremented whenever an existing tile's hash or id may have changed
+	u32 GetHashGeneration() const { return m_hashGeneration; }
+
 	void Serialise(ion::io::Archive& archive);
 	void Export(const PlatformConfig& config, std::stringstream& stream) const;
 	void Export(const PlatformConfig& config, ion::io::File& file, bool compress) const;
@@ -68,4 +80,5 @@ private:
 	const PlatformConfig* m_platformConfig;
 	std::vector<Tile> m_tiles;
 	HashMap m_hashMap;
+	u32 m_hashGeneration;
 };
\ No newline at end of file
@@ -9,38 +9,72 @@
 // File:		Queue.h
 // Date:		22nd December 2013
 // Authors:		Matt Phillips
-// Description:	Lock-free single producer, single consumer queue
+// Description:	Lock-free bounded multiple producer, multiple consumer queue
 ///////////////////////////////////////////////////
 
 #pragma once
 
 #include "core/Types.h"
-#include "core/thread/Atomic.h"
+#include "core/thread/Sleep.h"
+
+#include <atomic>
 
 namespace ion
 {
+	//Each slot carries a sequence number saying whether it is ready to be written (== position)
+	//or read (== position + 1) for the current lap of the ring. Producers and consumers claim
+	//positions with a CAS on their own counter, and publish the slot with a release store of
+	//its sequence, so no locks are held and a stalled thread only blocks its own slot.
 	template <typename T, int SIZE> class Queue
 	{
 	public:
 		Queue();
 		~Queue();
 
-		void Push(T& item);
+		//Non-blocking, return false if full/empty
+		bool TryPush(const T& item);
+		bool TryPop(T& item);
+
+		//Blocking, spin then yield until space/item available
+		void Push(const T& item);
 		T Pop();
 
+		//Snapshot only, may be out of date immediately if other threads are pushing/popping
 		bool IsEmpty() const;
 		bool IsFull() const;
+		u32 GetSize() const;
 
 	private:
-		T m_items[SIZE];
-		u32 m_producerIdx;
-		u32 m_consumerIdx;
+		//Spins before yielding the thread in blocking calls
+		static const int s_spinCount = 64;
+
+		//Keep producer/consumer counters and slots on separate cache lines
+		static const int s_cacheLineSize = 64;
+
+		struct Slot
+		{
+			std::atomic<u64> sequence;
+			T item;
+		};
+
+		static void Backoff(int& spins);
+
+		alignas(s_cacheLineSize) Slot m_slots[SIZE];
+		alignas(s_cacheLineSize) std::atomic<u64> m_producerIdx;
+		alignas(s_cacheLineSize) std::atomic<u64> m_consumerIdx;
 	};
 
 	template <typename T, int SIZE> Queue<T, SIZE>::Queue()
 	{
-		m_producerIdx = 0;
-		m_consumerIdx = 0;
+		static_assert(SIZE > 0, "Queue size must be greater than zero");
+
+		for(int i = 0; i < SIZE; i++)
+		{
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		m_producerIdx.store(0, std::memory_order_relaxed);
+		m_consumerIdx.store(0, std::memory_order_relaxed);
 	}
 
 	template <typename T, int SIZE> Queue<T, SIZE>::~Queue()
@@ -48,29 +82,121 @@ namespace ion
 
 	}
 
-	template <typename T, int SIZE> void Queue<T, SIZE>::Push(T& item)
+	template <typename T, int SIZE> bool Queue<T, SIZE>::TryPush(const T& item)
+	{
+		u64 position = m_producerIdx.load(std::memory_order_relaxed);
+
+		while(true)
+		{
+			Slot& slot = m_slots[position % SIZE];
+			u64 sequence = slot.sequence.load(std::memory_order_acquire);
+			s64 diff = (s64)sequence - (s64)position;
+
+			if(diff == 0)
+			{
+				//Slot free on this lap, claim it
+				if(m_producerIdx.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					slot.item = item;
+
+					//Publish to consumers
+					slot.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if(diff < 0)
+			{
+				//Slot still holds last lap's item, full
+				return false;
+			}
+			else
+			{
+				//Another producer claimed this position, reload
+				position = m_producerIdx.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template <typename T, int SIZE> bool Queue<T, SIZE>::TryPop(T& item)
+	{
+		u64 position = m_consumerIdx.load(std::memory_order_relaxed);
+
+		while(true)
+		{
+			Slot& slot = m_slots[position % SIZE];
+			u64 sequence = slot.sequence.load(std::memory_order_acquire);
+			s64 diff = (s64)sequence - (s64)(position + 1);
+
+			if(diff == 0)
+			{
+				//Slot written on this lap, claim it
+				if(m_consumerIdx.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					item = slot.item;
+
+					//Release slot to producers on next lap
+					slot.sequence.store(position + SIZE, std::memory_order_release);
+					return true;
+				}
+			}
+			else if(diff < 0)
+			{
+				//Slot not yet written, empty
+				return false;
+			}
+			else
+			{
+				//Another consumer claimed this position, reload
+				position = m_consumerIdx.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template <typename T, int SIZE> void Queue<T, SIZE>::Backoff(int& spins)
+	{
+		if(++spins > s_spinCount)
+		{
+			thread::Sleep(0);
+		}
+	}
+
+	template <typename T, int SIZE> void Queue<T, SIZE>::Push(const T& item)
 	{
-		int index = m_producerIdx % SIZE;
-		m_items[index] = item;
-		thread::atomic::Increment(m_producerIdx);
+		int spins = 0;
+
+		while(!TryPush(item))
+		{
+			Backoff(spins);
+		}
 	}
 
 	template <typename T, int SIZE> T Queue<T, SIZE>::Pop()
 	{
-		int index = m_consumerIdx % SIZE;
-		T item = m_items[index];
-		thread::atomic::Increment(m_consumerIdx);
+		T item;
+		int spins = 0;
+
+		while(!TryPop(item))
+		{
+			Backoff(spins);
+		}
 
 		return item;
 	}
 
 	template <typename T, int SIZE> bool Queue<T, SIZE>::IsEmpty() const
 	{
-		return m_consumerIdx == m_producerIdx;
+		return GetSize() == 0;
 	}
 
 	template <typename T, int SIZE> bool Queue<T, SIZE>::IsFull() const
 	{
-		return (m_producerIdx - m_consumerIdx) == SIZE;
+		return GetSize() >= SIZE;
+	}
+
+	template <typename T, int SIZE> u32 Queue<T, SIZE>::GetSize() const
+	{
+		u64 consumerIdx = m_consumerIdx.load(std::memory_order_acquire);
+		u64 producerIdx = m_producerIdx.load(std::memory_order_acquire);
+		return (producerIdx > consumerIdx) ? (u32)(producerIdx - consumerIdx) : 0;
 	}
-}
\ No newline at end of file
+}
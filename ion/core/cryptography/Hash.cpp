@@ -13,6 +13,13 @@
 ///////////////////////////////////////////////////
 
 #include "Hash.h"
+#include "core/memory/Memory.h"
+
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace ion
 {
@@ -54,4 +61,210 @@ namespace ion
 
 		return hash ^ (hash << 37);
 	}
-}
\ No newline at end of file
+
+	namespace hashfast
+	{
+		static const u64 s_secret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+		//Seed for second HashFast128 lane
+		static const u64 s_seed128 = 0x9e3779b97f4a7c15ull;
+
+		//Full 64x64->128 multiply, a = low, b = high
+		static inline void Multiply128(u64& a, u64& b)
+		{
+#if defined(__SIZEOF_INT128__)
+			__uint128_t result = (__uint128_t)a * b;
+			a = (u64)result;
+			b = (u64)(result >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			a = _umul128(a, b, &b);
+#else
+			u64 ha = a >> 32, hb = b >> 32, la = (u32)a, lb = (u32)b;
+			u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+			u64 t = rl + (rm0 << 32);
+			u64 carry = (t < rl) ? 1 : 0;
+			u64 low = t + (rm1 << 32);
+			carry += (low < t) ? 1 : 0;
+			a = low;
+			b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+		}
+
+		static inline u64 Mix(u64 a, u64 b)
+		{
+			Multiply128(a, b);
+			return a ^ b;
+		}
+
+		//Unaligned reads, compile to a single load
+		static inline u64 Read64(const u8* data)
+		{
+			u64 value;
+			std::memcpy(&value, data, sizeof(u64));
+			return value;
+		}
+
+		static inline u64 Read32(const u8* data)
+		{
+			u32 value;
+			std::memcpy(&value, data, sizeof(u32));
+			return value;
+		}
+
+		static inline u64 Read3(const u8* data, u64 size)
+		{
+			return (((u64)data[0]) << 16) | (((u64)data[size >> 1]) << 8) | data[size - 1];
+		}
+
+		static inline u64 InitSeed(u64 seed)
+		{
+			return seed ^ Mix(seed ^ s_secret[0], s_secret[1]);
+		}
+
+		static inline void MixBlock(const u8* data, u64& seed, u64& lane1, u64& lane2)
+		{
+			seed = Mix(Read64(data) ^ s_secret[1], Read64(data + 8) ^ seed);
+			lane1 = Mix(Read64(data + 16) ^ s_secret[2], Read64(data + 24) ^ lane1);
+			lane2 = Mix(Read64(data + 32) ^ s_secret[3], Read64(data + 40) ^ lane2);
+		}
+
+		//Hash remaining <= 48 bytes, data[-16] must be readable if totalSize > 16
+		static u64 Finalise(const u8* data, u64 size, u64 totalSize, u64 seed)
+		{
+			u64 a = 0;
+			u64 b = 0;
+
+			if(totalSize <= 16)
+			{
+				if(size >= 4)
+				{
+					a = (Read32(data) << 32) | Read32(data + ((size >> 3) << 2));
+					b = (Read32(data + size - 4) << 32) | Read32(data + size - 4 - ((size >> 3) << 2));
+				}
+				else if(size > 0)
+				{
+					a = Read3(data, size);
+				}
+			}
+			else
+			{
+				while(size > 16)
+				{
+					seed = Mix(Read64(data) ^ s_secret[1], Read64(data + 8) ^ seed);
+					data += 16;
+					size -= 16;
+				}
+
+				a = Read64(data + size - 16);
+				b = Read64(data + size - 8);
+			}
+
+			a ^= s_secret[1];
+			b ^= seed;
+			Multiply128(a, b);
+			return Mix(a ^ s_secret[0] ^ totalSize, b ^ s_secret[1]);
+		}
+	}
+
+	u64 HashFast64(const void* data, u64 size, u64 seed)
+	{
+		const u8* bytes = (const u8*)data;
+		u64 remaining = size;
+
+		seed = hashfast::InitSeed(seed);
+
+		if(remaining > 48)
+		{
+			u64 lane1 = seed;
+			u64 lane2 = seed;
+
+			do
+			{
+				hashfast::MixBlock(bytes, seed, lane1, lane2);
+				bytes += 48;
+				remaining -= 48;
+			} while(remaining > 48);
+
+			seed ^= lane1 ^ lane2;
+		}
+
+		return hashfast::Finalise(bytes, remaining, size, seed);
+	}
+
+	Hash128 HashFast128(const void* data, u64 size, u64 seed)
+	{
+		Hash128 hash;
+		hash.low = HashFast64(data, size, seed);
+		hash.high = HashFast64(data, size, seed ^ hashfast::s_seed128);
+		return hash;
+	}
+
+	HashStream64::HashStream64(u64 seed)
+	{
+		Reset(seed);
+	}
+
+	void HashStream64::Reset(u64 seed)
+	{
+		m_seed = hashfast::InitSeed(seed);
+		m_lane1 = m_seed;
+		m_lane2 = m_seed;
+		m_totalSize = 0;
+		m_blocksProcessed = false;
+		m_bufferSize = 0;
+	}
+
+	void HashStream64::Update(const void* data, u64 size)
+	{
+		const u8* bytes = (const u8*)data;
+		m_totalSize += size;
+
+		//A block is only mixed once more data follows it, the last <= 48 bytes are left for Finalise()
+		while(size > 0)
+		{
+			if(m_bufferSize == s_blockSize)
+			{
+				hashfast::MixBlock(m_buffer, m_seed, m_lane1, m_lane2);
+				memory::MemCopy(m_history, m_buffer + s_blockSize - s_tailSize, s_tailSize);
+				m_blocksProcessed = true;
+				m_bufferSize = 0;
+			}
+
+			if(m_bufferSize == 0)
+			{
+				//Mix straight from source while more than a block remains
+				while(size > s_blockSize)
+				{
+					hashfast::MixBlock(bytes, m_seed, m_lane1, m_lane2);
+					memory::MemCopy(m_history, bytes + s_blockSize - s_tailSize, s_tailSize);
+					m_blocksProcessed = true;
+					bytes += s_blockSize;
+					size -= s_blockSize;
+				}
+			}
+
+			u32 bytesToCopy = (u32)((size < (u64)(s_blockSize - m_bufferSize)) ? size : (s_blockSize - m_bufferSize));
+			memory::MemCopy(m_buffer + m_bufferSize, bytes, bytesToCopy);
+			m_bufferSize += bytesToCopy;
+			bytes += bytesToCopy;
+			size -= bytesToCopy;
+		}
+	}
+
+	u64 HashStream64::Finalise() const
+	{
+		//Pending bytes preceded by previous block tail, final read may reach back into it
+		u8 data[s_tailSize + s_blockSize];
+		memory::MemCopy(data, m_history, s_tailSize);
+		memory::MemCopy(data + s_tailSize, m_buffer, m_bufferSize);
+
+		u64 seed = m_seed;
+
+		if(m_blocksProcessed)
+		{
+			seed ^= m_lane1 ^ m_lane2;
+		}
+
+		return hashfast::Finalise(data + s_tailSize, m_bufferSize, m_totalSize, seed);
+	}
+}
@@ -21,4 +21,55 @@ namespace ion
 	u32 Hash(const char* string);
 	u32 Hash(const u8* data, int size);
 	u64 Hash64(const u8* data, int size);
-}
\ No newline at end of file
+
+	//Compile time equivalent of Hash(const char*), for string literals
+	constexpr u32 HashConst(const char* string, u32 hash = 0)
+	{
+		return *string ? HashConst(string + 1, (u32)(*string) + (hash << 6) + (hash << 16) - hash) : hash;
+	}
+
+	//Fast non-cryptographic hash (wyhash construction), processes 48 bytes per iteration
+	//in three independent multiply lanes. Not compatible with Hash()/Hash64() values.
+	u64 HashFast64(const void* data, u64 size, u64 seed = 0);
+
+	struct Hash128
+	{
+		u64 low;
+		u64 high;
+
+		bool operator == (const Hash128& rhs) const { return low == rhs.low && high == rhs.high; }
+		bool operator != (const Hash128& rhs) const { return !(*this == rhs); }
+		bool operator < (const Hash128& rhs) const { return (high != rhs.high) ? (high < rhs.high) : (low < rhs.low); }
+	};
+
+	//Two independently seeded 64-bit lanes
+	Hash128 HashFast128(const void* data, u64 size, u64 seed = 0);
+
+	//Incremental HashFast64, same result as hashing all data in one call
+	class HashStream64
+	{
+	public:
+		HashStream64(u64 seed = 0);
+
+		void Reset(u64 seed = 0);
+		void Update(const void* data, u64 size);
+		u64 Finalise() const;
+
+	private:
+		static const int s_blockSize = 48;
+		static const int s_tailSize = 16;
+
+		u64 m_seed;
+		u64 m_lane1;
+		u64 m_lane2;
+		u64 m_totalSize;
+		bool m_blocksProcessed;
+
+		//Last tail bytes of previous block, final read can overlap it
+		u8 m_history[s_tailSize];
+
+		//Pending bytes, up to one block
+		u8 m_buffer[s_blockSize];
+		u32 m_bufferSize;
+	};
+}
@@ -16,20 +16,69 @@
 #include "core/io/Stream.h"
 #include "core/cryptography/Hash.h"
 #include "core/debug/Debug.h"
+#include "core/memory/Endian.h"
+
+#if defined ION_ARCHIVE_TAG_REGISTRY
+#include "core/thread/CriticalSection.h"
+#endif
 
 namespace ion
 {
 	namespace io
 	{
 		Archive::Archive(Stream& stream, Direction direction, ResourceManager* resourceManager, u32 version)
-			: m_stream(stream)
+			: m_stream(&stream)
+			, m_baseStream(&stream)
 		{
 			m_direction = direction;
 			m_contentType = Content::Full;
+			m_writeMode = WriteMode::Buffered;
 			m_version = version;
 			m_resourceManager = resourceManager;
+			m_formatVersion = FormatVersionCurrent;
+			m_formatHeaderWritten = false;
+			m_endianSwap = false;
+			m_compressedStream = NULL;
+
+			if(direction == Direction::In)
+			{
+				if(CompressedStream::IsCompressed(stream))
+				{
+					m_compressedStream = new CompressedStream(stream);
+					if(m_compressedStream->IsValid())
+					{
+						m_stream = m_compressedStream;
+					}
+					else
+					{
+						debug::error << "Archive::Archive() - Invalid compressed stream" << debug::end;
+						delete m_compressedStream;
+						m_compressedStream = NULL;
+					}
+				}
+
+				//Determine block layout from stream
+				ReadFormatHeader();
+			}
 		}
 
+		Archive::~Archive()
+		{
+			if(m_compressedStream)
+			{
+				if(m_direction == Direction::Out)
+				{
+					m_compressedStream->Finish();
+				}
+
+				delete m_compressedStream;
+			}
+		}
+
+		const u32 Archive::s_formatTag = HashConst("__archive_format");
+		const u32 Archive::s_byteOrderMark = 0x01020304;
+		const u32 Archive::s_indexTag = HashConst("__index");
+
 
 		void Archive::SetContentType(Archive::Content content)
 		{
@@ -41,23 +90,129 @@ namespace ion
 			return m_contentType;
 		}
 
+		void Archive::SetWriteMode(WriteMode writeMode)
+		{
+			debug::Assert(m_blockStack.size() == 0, "Archive::SetWriteMode() - Cannot change write mode inside a block");
+			debug::Assert(writeMode == WriteMode::Buffered || !m_compressedStream, "Archive::SetWriteMode() - Streaming mode cannot back-patch compressed output");
+			m_writeMode = writeMode;
+		}
+
+		void Archive::SetCompression(CompressedStream::Codec codec, u32 chunkSize)
+		{
+			debug::Assert(m_direction == Direction::Out, "Archive::SetCompression() - Compression is detected automatically on read");
+			debug::Assert(!m_formatHeaderWritten && !m_compressedStream, "Archive::SetCompression() - Data already written");
+			debug::Assert(m_writeMode == WriteMode::Buffered, "Archive::SetCompression() - Streaming mode cannot back-patch compressed output");
+
+			m_compressedStream = new CompressedStream(*m_baseStream, codec, chunkSize);
+			m_stream = m_compressedStream;
+		}
+
+		Archive::WriteMode Archive::GetWriteMode() const
+		{
+			return m_writeMode;
+		}
+
+		void Archive::SetFormatVersion(u32 formatVersion)
+		{
+			debug::Assert(!m_formatHeaderWritten, "Archive::SetFormatVersion() - Format header already written");
+			m_formatVersion = formatVersion;
+		}
+
+		u32 Archive::GetFormatVersion() const
+		{
+			return m_formatVersion;
+		}
+
+		void Archive::WriteFormatHeader()
+		{
+			m_formatHeaderWritten = true;
+
+			//Written as a regular root block, so the scanning reader skips over it
+			Block::Header header;
+			header.tag = s_formatTag;
+			header.size = sizeof(Block::Header) + sizeof(u32);
+
+			if(m_formatVersion >= FormatVersionByteOrder)
+			{
+				header.size += sizeof(u32);
+			}
+
+			Serialise(header);
+			Serialise(m_formatVersion);
+
+			if(m_formatVersion >= FormatVersionByteOrder)
+			{
+				//Byte order mark, reads back reversed on an opposite endian target
+				u32 byteOrderMark = s_byteOrderMark;
+				Serialise(byteOrderMark);
+			}
+		}
+
+		void Archive::ReadFormatHeader()
+		{
+			u64 startPos = m_stream->GetPosition();
+
+			if((u64)m_stream->GetSize() >= startPos + sizeof(Block::Header) + sizeof(u32))
+			{
+				Block::Header header;
+				Serialise(header);
+
+				//Header written on an opposite endian target reads back with its tag reversed
+				u32 swappedTag = header.tag.m_hash;
+				memory::EndianSwap(swappedTag);
+
+				if(swappedTag == s_formatTag)
+				{
+					//All further values are swapped on read
+					m_endianSwap = true;
+					memory::EndianSwap(header.size);
+				}
+
+				if((header.tag == s_formatTag || m_endianSwap) && header.size >= (sizeof(Block::Header) + sizeof(u32)))
+				{
+					Serialise(m_formatVersion);
+
+					if(m_formatVersion >= FormatVersionByteOrder && header.size >= (sizeof(Block::Header) + sizeof(u32) + sizeof(u32)))
+					{
+						u32 byteOrderMark = 0;
+						Serialise(byteOrderMark);
+						debug::Assert(byteOrderMark == s_byteOrderMark, "Archive::ReadFormatHeader() - Bad byte order mark");
+					}
+
+					m_stream->Seek(startPos + header.size, SeekMode::Start);
+					return;
+				}
+			}
+
+			//No format header, assume legacy layout
+			m_formatVersion = FormatVersionLegacy;
+			m_endianSwap = false;
+			m_stream->Seek(startPos, SeekMode::Start);
+		}
+
 		void Archive::Serialise(void* data, u64 size)
 		{
 			if(GetDirection() == Direction::In)
 			{
-				m_stream.Read(data, size);
+				m_stream->Read(data, size);
 			}
 			else
 			{
-				if(m_blockStack.size() > 0)
+				if(m_blockStack.size() > 0 && m_writeMode == WriteMode::Buffered)
 				{
 					//Not root block, write to temp data
 					m_blockStack.back().data.Write(data, size);
 				}
 				else
 				{
-					//Root block, write to file
-					m_stream.Write(data, size);
+					//Root block or streaming, write format header first
+					if(!m_formatHeaderWritten && m_formatVersion != FormatVersionLegacy)
+					{
+						WriteFormatHeader();
+					}
+
+					//Write to file
+					m_stream->Write(data, size);
 				}
 			}
 		}
@@ -92,81 +247,257 @@ namespace ion
 			{
 				//Get start and end of inner scope (or whole file if at root level)
 				u64 scopeStart = block.parent ? (block.parent->startPos + sizeof(Block::Header)) : 0;
-				u64 scopeEnd = block.parent ? (block.parent->startPos + block.parent->header.size) : m_stream.GetSize();
+				u64 scopeEnd = block.parent ? (block.parent->startPos + block.parent->header.size) : m_stream->GetSize();
+
+				bool found = (m_formatVersion >= FormatVersionBlockIndex)
+					? FindBlockIndexed(block, tag, scopeStart, scopeEnd)
+					: FindBlockLegacy(block, tag, scopeStart, scopeEnd);
 
-				//If already at end of current scope or end of file, seek to start
-				if((u64)m_stream.GetPosition() >= scopeEnd)
+				if(!found)
 				{
-					m_stream.Seek(scopeStart, SeekMode::Start);
+					//Could not find block
+					return false;
+				}
+			}
+			else
+			{
+				if(m_writeMode == WriteMode::Streaming && !m_formatHeaderWritten && m_formatVersion != FormatVersionLegacy)
+				{
+					//Format header must precede first block
+					WriteFormatHeader();
 				}
 
-				//Record block Position
-				block.startPos = m_stream.GetPosition();
+				block.startPos = m_stream->GetPosition();
+				block.header.tag = tag;
 
-				//Read header at current Position
-				Serialise(block.header);
+				if(m_writeMode == WriteMode::Streaming)
+				{
+					//Write placeholder header, size is patched on PopBlock
+					Serialise(block.header);
+				}
+			}
 
-				if(block.header.tag != tag)
+			//Block found (or being written), push to stack
+			m_blockStack.push_back(block);
+
+			//Success
+			return true;
+		}
+
+		bool Archive::FindBlockLegacy(Block& block, const Tag& tag, u64 scopeStart, u64 scopeEnd)
+		{
+			//If already at end of current scope or end of file, seek to start
+			if((u64)m_stream->GetPosition() >= scopeEnd)
+			{
+				m_stream->Seek(scopeStart, SeekMode::Start);
+			}
+
+			//Record block Position
+			block.startPos = m_stream->GetPosition();
+
+			//Read header at current Position
+			Serialise(block.header);
+
+			if(block.header.tag != tag)
+			{
+				//No match, record search start pos
+				u64 searchStartPos = block.startPos;
+
+				do
 				{
-					//No match, record search start pos
-					u64 searchStartPos = block.startPos;
+					u64 blockEnd = (block.startPos + block.header.size);
 
-					do
+					//If end of scope or end of file
+					if(block.header.size == 0 || blockEnd >= scopeEnd)
 					{
-						u64 blockEnd = (block.startPos + block.header.size);
+						//Seek back to start of scope or start of file
+						m_stream->Seek(scopeStart, SeekMode::Start);
+					}
+					else
+					{
+						//Seek to start of next block
+						m_stream->Seek(block.startPos + block.header.size, SeekMode::Start);
+					}
 
-						//If end of scope or end of file
-						if(block.header.size == 0 || blockEnd >= scopeEnd)
-						{
-							//Seek back to start of scope or start of file
-							m_stream.Seek(scopeStart, SeekMode::Start);
-						}
-						else
-						{
-							//Seek to start of next block
-							m_stream.Seek(block.startPos + block.header.size, SeekMode::Start);
-						}
+					//Record next block Position
+					block.startPos = m_stream->GetPosition();
+
+					//Serialise next block header
+					Serialise(block.header);
+
+				} while(block.header.tag != tag && block.startPos != searchStartPos);
+
+				if(block.header.tag != tag)
+				{
+					//Block not found, return to original starting Position
+					m_stream->Seek(searchStartPos, SeekMode::Start);
+				}
+			}
+
+			return block.header.tag == tag;
+		}
+
+		bool Archive::FindBlockIndexed(Block& block, const Tag& tag, u64 scopeStart, u64 scopeEnd)
+		{
+			//Child offsets are relative to the owning block's start (or start of file at root level)
+			BlockIndex& index = block.parent ? block.parent->index : m_rootIndex;
+			u64 scopeOwnerPos = block.parent ? block.parent->startPos : 0;
+			u64 position = m_stream->GetPosition();
+
+			if(!index.built)
+			{
+				BuildBlockIndex(index, block.parent != NULL, scopeOwnerPos, scopeStart, scopeEnd);
+			}
+
+			u64 offset = 0;
+			if(!index.Find(tag.m_hash, position - scopeOwnerPos, offset))
+			{
+				//Not found, return to original position
+				m_stream->Seek(position, SeekMode::Start);
+				return false;
+			}
+
+			//Seek to block and read header
+			block.startPos = scopeOwnerPos + offset;
+			m_stream->Seek(block.startPos, SeekMode::Start);
+			Serialise(block.header);
+
+			if(block.header.tag != tag)
+			{
+				//Index doesn't match the data, fall back to scanning
+				debug::log << "Archive::PushBlock() - Block index mismatch, falling back to scan" << debug::end;
+				return FindBlockLegacy(block, tag, scopeStart, scopeEnd);
+			}
+
+			return true;
+		}
 
-						//Record next block Position
-						block.startPos = m_stream.GetPosition();
+		void Archive::BuildBlockIndex(BlockIndex& index, bool hasTable, u64 scopeOwnerPos, u64 scopeStart, u64 scopeEnd)
+		{
+			const u64 entrySize = sizeof(u32) + sizeof(u64);
+			const u64 scopeSize = scopeEnd - scopeStart;
+
+			index.built = true;
+
+			//Nested scopes may end with an index table, the root scope never does
+			if(hasTable && scopeSize >= (sizeof(Block::Header) + sizeof(u64) + sizeof(u32)))
+			{
+				//Table offset and entry count are the last fields in the table
+				u64 tableOffset = 0;
+				u32 count = 0;
+				m_stream->Seek(scopeEnd - sizeof(u64) - sizeof(u32), SeekMode::Start);
+				Serialise(tableOffset);
+				Serialise(count);
 
-						//Serialise next block header
-						Serialise(block.header);
+				u64 tableSize = sizeof(Block::Header) + (count * entrySize) + sizeof(u64) + sizeof(u32);
 
-					} while(block.header.tag != tag && block.startPos != searchStartPos);
+				//Offset check rejects a table belonging to a last child that ends at the same position
+				if(tableSize <= scopeSize && tableOffset == (scopeEnd - tableSize - scopeOwnerPos))
+				{
+					Block::Header header;
+					m_stream->Seek(scopeEnd - tableSize, SeekMode::Start);
+					Serialise(header);
 
-					if(block.header.tag != tag)
+					if(header.tag == s_indexTag && header.size == tableSize)
 					{
-						//Block not found, return to original starting Position
-						m_stream.Seek(searchStartPos, SeekMode::Start);
+						for(u32 i = 0; i < count; i++)
+						{
+							u32 tag = 0;
+							u64 offset = 0;
+							Serialise(tag);
+							Serialise(offset);
+							index.Add(tag, offset);
+						}
+
+						return;
 					}
 				}
 			}
-			else
+
+			//No table, walk sibling headers once
+			u64 position = scopeStart;
+
+			while(position + sizeof(Block::Header) <= scopeEnd)
 			{
-				block.startPos = m_stream.GetPosition();
-				block.header.tag = tag;
+				Block::Header header;
+				m_stream->Seek(position, SeekMode::Start);
+				Serialise(header);
+
+				if(header.size < sizeof(Block::Header))
+				{
+					break;
+				}
+
+				if(header.tag != s_indexTag)
+				{
+					index.Add(header.tag.m_hash, position - scopeOwnerPos);
+				}
+
+				position += header.size;
 			}
+		}
 
-			if(block.header.tag == tag)
-			{
-				//Block found (or being written), push to stack
-				m_blockStack.push_back(block);
+		void Archive::WriteBlockIndex(Block& block)
+		{
+			const u64 entrySize = sizeof(u32) + sizeof(u64);
+
+			//Written as the last child block, with its own offset and the entry count last so the reader can find it from the block end
+			u64 tableOffset = (m_writeMode == WriteMode::Streaming) ? (m_stream->GetPosition() - block.startPos) : (sizeof(Block::Header) + block.data.GetPosition());
+
+			Block::Header header;
+			header.tag = s_indexTag;
+			header.size = sizeof(Block::Header) + (block.children.size() * entrySize) + sizeof(u64) + sizeof(u32);
+			Serialise(header);
 
-				//Success
-				return true;
+			for(int i = 0; i < (int)block.children.size(); i++)
+			{
+				Serialise(block.children[i].first);
+				Serialise(block.children[i].second);
 			}
-			else
+
+			u32 count = (u32)block.children.size();
+			Serialise(tableOffset);
+			Serialise(count);
+		}
+
+		bool Archive::BlockIndex::Find(u32 tag, u64 position, u64& offset)
+		{
+			std::unordered_map<u32, Entry>::iterator it = entries.find(tag);
+			if(it == entries.end())
 			{
-				//Could not find block
 				return false;
 			}
+
+			Entry& entry = it->second;
+			u32 idx = entry.cursor;
+
+			//Find first block at or after current position, wrapping to start of scope
+			if(idx >= entry.offsets.size() || entry.offsets[idx] < position || (idx > 0 && entry.offsets[idx - 1] >= position))
+			{
+				idx = (u32)(std::lower_bound(entry.offsets.begin(), entry.offsets.end(), position) - entry.offsets.begin());
+
+				if(idx == entry.offsets.size())
+				{
+					idx = 0;
+				}
+			}
+
+			offset = entry.offsets[idx];
+			entry.cursor = idx + 1;
+
+			return true;
 		}
 
 		void Archive::PopBlock()
 		{
 			debug::Assert(m_blockStack.size() > 0, "Archive::PopBlock() - No block to pop");
 
+			if(m_direction == Direction::Out && m_formatVersion >= FormatVersionBlockIndex && (int)m_blockStack.back().children.size() >= s_minIndexEntries)
+			{
+				//Append child index while block is still on top of stack
+				WriteBlockIndex(m_blockStack.back());
+			}
+
 			//Get top block
 			Block block = m_blockStack.back();
 
@@ -176,13 +507,36 @@ namespace ion
 			if(m_direction == Direction::In)
 			{
 				//Seek to block end
-				m_stream.Seek(block.startPos + block.header.size, SeekMode::Start);
+				m_stream->Seek(block.startPos + block.header.size, SeekMode::Start);
+			}
+			else if(m_writeMode == WriteMode::Streaming)
+			{
+				//Payload already written, patch header with final size
+				u64 endPos = m_stream->GetPosition();
+				block.header.size = endPos - block.startPos;
+				m_stream->Seek(block.startPos, SeekMode::Start);
+				Serialise(block.header);
+				m_stream->Seek(endPos, SeekMode::Start);
+
+				if(m_formatVersion >= FormatVersionBlockIndex && m_blockStack.size() > 0)
+				{
+					//Record offset from parent block start
+					Block& parent = m_blockStack.back();
+					parent.children.push_back(std::make_pair(block.header.tag.m_hash, block.startPos - parent.startPos));
+				}
 			}
 			else
 			{
 				//Set block size
 				block.header.size = sizeof(Block::Header) + block.data.GetSize();
 
+				if(m_formatVersion >= FormatVersionBlockIndex && m_blockStack.size() > 0)
+				{
+					//Record offset from parent block start
+					Block& parent = m_blockStack.back();
+					parent.children.push_back(std::make_pair(block.header.tag.m_hash, (u64)sizeof(Block::Header) + parent.data.GetPosition()));
+				}
+
 				//Write current block
 				Serialise(block.header);
 				Serialise(block.data);
@@ -195,41 +549,43 @@ namespace ion
 			archive.Serialise(size);
 		}
 
-		Archive::Tag::Tag()
-		{
-			m_hash = 0;
-		}
+#if !defined ION_ARCHIVE_TAG_REGISTRY
+		static_assert(Archive::Tag("__index").m_hash == HashConst("__index"), "Archive::Tag literals must hash at compile time");
+#endif
 
-		Archive::Tag::Tag(const char* string)
+#if defined ION_ARCHIVE_TAG_REGISTRY
+		void Archive::Tag::RegisterName(const char* string, u32 hash)
 		{
-			m_hash = Hash(string);
-		}
+			//Names this thread has already checked, so repeat tags (every serialise) don't take the registry lock
+			static thread_local std::unordered_map<u32, std::string> checked;
 
-		Archive::Tag::Tag(u32 hash)
-		{
-			m_hash = hash;
-		}
+			std::unordered_map<u32, std::string>::iterator checkedIt = checked.find(hash);
+			if(checkedIt != checked.end() && checkedIt->second == string)
+			{
+				return;
+			}
 
-		Archive::Tag::Tag(const Tag& rhs)
-		{
-			m_hash = rhs.m_hash;
-		}
+			static thread::CriticalSection registryLock;
+			static std::unordered_map<u32, std::string> registry;
 
-		Archive::Tag& Archive::Tag::operator = (u32 hash)
-		{
-			m_hash = hash;
-			return *this;
-		}
+			registryLock.Begin();
 
-		bool Archive::Tag::operator == (const Tag& rhs) const
-		{
-			return m_hash == rhs.m_hash;
-		}
+			std::unordered_map<u32, std::string>::iterator it = registry.find(hash);
+			if(it == registry.end())
+			{
+				it = registry.insert(std::make_pair(hash, std::string(string))).first;
+			}
+			else if(it->second != string)
+			{
+				debug::error << "Archive::Tag - Hash collision, \"" << string << "\" and \"" << it->second.c_str() << "\" both hash to " << hash << debug::end;
+			}
 
-		bool Archive::Tag::operator != (const Tag& rhs) const
-		{
-			return m_hash != rhs.m_hash;
+			//Cache the registered name, a colliding name misses the cache and is reported again
+			checked[hash] = it->second;
+
+			registryLock.End();
 		}
+#endif
 
 		void Archive::Serialise(MemoryStream& stream)
 		{
@@ -272,36 +628,75 @@ namespace ion
 		void Archive::Serialise(u16& data)
 		{
 			Serialise((void*)&data, sizeof(u16));
+
+			if(m_endianSwap)
+				memory::EndianSwap(data);
 		}
 
 		void Archive::Serialise(s16& data)
 		{
 			Serialise((void*)&data, sizeof(s16));
+
+			if(m_endianSwap)
+				memory::EndianSwap(data);
 		}
 
 		void Archive::Serialise(u32& data)
 		{
 			Serialise((void*)&data, sizeof(u32));
+
+			if(m_endianSwap)
+				memory::EndianSwap(data);
 		}
 
 		void Archive::Serialise(s32& data)
 		{
 			Serialise((void*)&data, sizeof(s32));
+
+			if(m_endianSwap)
+				memory::EndianSwap(data);
 		}
 
 		void Archive::Serialise(u64& data)
 		{
 			Serialise((void*)&data, sizeof(u64));
+
+			if(m_endianSwap)
+				memory::EndianSwap(data);
 		}
 
 		void Archive::Serialise(s64& data)
 		{
 			Serialise((void*)&data, sizeof(s64));
+
+			if(m_endianSwap)
+				memory::EndianSwap(data);
 		}
 
 		void Archive::Serialise(float& data)
 		{
 			Serialise((void*)&data, sizeof(float));
+
+			if(m_endianSwap)
+				memory::EndianSwap((u32&)data);
+		}
+
+		void Archive::EndianSwapArray(void* data, u64 count, int wordSize)
+		{
+			switch(wordSize)
+			{
+			case sizeof(u16):
+				memory::EndianSwapArray((u16*)data, count);
+				break;
+			case sizeof(u32):
+				memory::EndianSwapArray((u32*)data, count);
+				break;
+			case sizeof(u64):
+				memory::EndianSwapArray((u64*)data, count);
+				break;
+			default:
+				break;
+			}
 		}
 
 		void Archive::Serialise(bool& data)
@@ -374,16 +769,12 @@ namespace ion
 					int numChars = 0;
 					Serialise(numChars, "count");
 
-					//Clear and reserve string
-					string = "";
-					string.reserve(numChars);
-
 					//Serialise chars
-					for(int i = 0; i < numChars; i++)
+					string.resize(numChars);
+
+					if(numChars > 0)
 					{
-						char character = 0;
-						Serialise(character);
-						string += character;
+						Serialise(&string[0], numChars);
 					}
 
 					PopBlock();
@@ -404,5 +795,75 @@ namespace ion
 				}
 			}
 		}
+
+		void Archive::Serialise(View& view)
+		{
+			if(GetDirection() == Direction::In)
+			{
+				//Serialise in num bytes
+				int numBytes = 0;
+				Serialise(numBytes, "count");
+
+				ReadView(view, numBytes);
+			}
+			else
+			{
+				//Serialise out num bytes
+				int numBytes = (int)view.GetSize();
+				Serialise(numBytes, "count");
+
+				if(numBytes > 0)
+				{
+					Serialise((void*)view.GetData(), numBytes);
+				}
+			}
+		}
+
+		void Archive::Serialise(StringView& view)
+		{
+			if(PushBlock("__string"))
+			{
+				Serialise((View&)view);
+				PopBlock();
+			}
+		}
+
+		void Archive::ReadView(View& view, u64 size)
+		{
+			view.m_copy.clear();
+			view.m_data = NULL;
+			view.m_size = size;
+
+			if(size > 0)
+			{
+				//Point straight into memory backed streams
+				s64 position = m_stream->GetPosition();
+				view.m_data = m_stream->GetView(position, size);
+
+				if(view.m_data)
+				{
+					m_stream->Seek(position + size, SeekMode::Start);
+				}
+				else
+				{
+					//Stream can't be addressed directly (file, decompressor), take a copy
+					view.m_copy.resize(size);
+					Serialise(view.m_copy.data(), size);
+					view.m_data = view.m_copy.data();
+				}
+			}
+		}
+
+		Archive::View& Archive::View::operator = (const View& rhs)
+		{
+			if(this != &rhs)
+			{
+				m_copy = rhs.m_copy;
+				m_data = m_copy.empty() ? rhs.m_data : m_copy.data();
+				m_size = rhs.m_size;
+			}
+
+			return *this;
+		}
 	}
 }
\ No newline at end of file
@@ -16,10 +16,12 @@
 #define ARCHIVE_H
 
 #include "core/io/Stream.h"
+#include "core/io/CompressedStream.h"
 
 //Includes for ion types handled directly by Archive
 #include "core/Types.h"
 #include "core/containers/FixedArray.h"
+#include "core/cryptography/Hash.h"
 #include "maths/Maths.h"
 
 //Includes STL types handled directly by Archive
@@ -27,10 +29,31 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 
 //RTTI
 #include <typeinfo>
+#include <type_traits>
+
+//Opt a trivially copyable struct into bulk vector serialisation, place inside the struct body.
+//All members must be WORD_T sized, so the array can be endian swapped as a flat array of WORD_T.
+//Vectors of these types are written as one raw block, and can still read per-element data written before opting in.
+#define ION_SERIALISE_POD(WORD_T) typedef WORD_T SerialisePODWord;
+
+//Debug builds hash tag literals at runtime and record their names, to catch hash collisions
+#if defined ION_BUILD_DEBUG
+#define ION_ARCHIVE_TAG_REGISTRY 1
+#endif
+
+//String literal tags are hashed at compile time
+#if defined ION_ARCHIVE_TAG_REGISTRY
+#define ION_ARCHIVE_TAG_LITERAL
+#elif defined __cpp_consteval
+#define ION_ARCHIVE_TAG_LITERAL consteval
+#else
+#define ION_ARCHIVE_TAG_LITERAL constexpr
+#endif
 
 namespace ion
 {
@@ -39,31 +62,120 @@ namespace ion
 		class ResourceManager;
 		template <class T> class ResourceHandle;
 
+		//Detects types tagged with ION_SERIALISE_POD
+		template <typename T, typename = void> struct IsSerialisePOD : std::false_type {};
+		template <typename T> struct IsSerialisePOD<T, typename std::conditional<false, typename T::SerialisePODWord, void>::type> : std::true_type {};
+
 		class Archive
 		{
 		public:
 			enum class Direction { In, Out };
 			enum class Content { Full, Minimal };
 
+			//Buffered: blocks are assembled in memory and written on PopBlock, any output stream
+			//Streaming: payload written straight to output, block sizes back-patched, requires a seekable output stream
+			enum class WriteMode { Buffered, Streaming };
+
+			//Archive format versions (block layout, independent of user data version)
+			enum FormatVersion
+			{
+				FormatVersionLegacy = 0,		//Plain sibling blocks, tags found by linear scan
+				FormatVersionBlockIndex = 1,	//Each block ends with a tag->offset index table
+				FormatVersionByteOrder = 2,		//Format header records writer byte order, values swapped on read if it differs
+
+				FormatVersionCurrent = FormatVersionByteOrder
+			};
+
 			struct Tag
 			{
-				Tag();
-				Tag(const char* string);
-				Tag(u32 hash);
-				Tag(const Tag& rhs);
-				Tag& operator = (u32 hash);
-				bool operator == (const Tag& rhs) const;
-				bool operator != (const Tag& rhs) const;
+				constexpr Tag() : m_hash(0) {}
+				constexpr Tag(u32 hash) : m_hash(hash) {}
+				constexpr Tag(const Tag& rhs) : m_hash(rhs.m_hash) {}
+
+				//String literal, hash is a compile time constant
+				template <int N> ION_ARCHIVE_TAG_LITERAL Tag(const char (&string)[N])
+					: m_hash(HashConst(string))
+				{
+#if defined ION_ARCHIVE_TAG_REGISTRY
+					RegisterName(string, m_hash);
+#endif
+				}
+
+				//Runtime string
+				template <typename T, typename std::enable_if<std::is_same<T, const char*>::value || std::is_same<T, char*>::value, int>::type = 0> Tag(T string)
+					: m_hash(Hash(string))
+				{
+#if defined ION_ARCHIVE_TAG_REGISTRY
+					RegisterName(string, m_hash);
+#endif
+				}
+
+				Tag& operator = (u32 hash) { m_hash = hash; return *this; }
+				constexpr bool operator == (const Tag& rhs) const { return m_hash == rhs.m_hash; }
+				constexpr bool operator != (const Tag& rhs) const { return m_hash != rhs.m_hash; }
+
+#if defined ION_ARCHIVE_TAG_REGISTRY
+				//Records first name seen for each hash, errors if a different name has the same hash
+				static void RegisterName(const char* string, u32 hash);
+#endif
 
 				u32 m_hash;
 			};
 
+			//Read-only run of serialised bytes. When read from a memory backed stream it points straight into
+			//the stream (valid while the stream is open and unmodified), otherwise it holds its own copy.
+			class View
+			{
+			public:
+				View() : m_data(NULL), m_size(0) {}
+				View(const void* data, u64 size) : m_data((const u8*)data), m_size(size) {}
+				View(const View& rhs) { *this = rhs; }
+				View& operator = (const View& rhs);
+
+				const u8* GetData() const { return m_data; }
+				u64 GetSize() const { return m_size; }
+				bool IsEmpty() const { return m_size == 0; }
+				bool IsCopy() const { return !m_copy.empty(); }
+
+				std::string ToString() const { return std::string((const char*)m_data, (size_t)m_size); }
+
+			private:
+				const u8* m_data;
+				u64 m_size;
+				std::vector<u8> m_copy;
+
+				friend class Archive;
+			};
+
+			//View using std::string encoding
+			class StringView : public View
+			{
+			public:
+				StringView() {}
+				StringView(const std::string& string) : View(string.data(), string.size()) {}
+			};
+
+			//Compressed input streams are detected and decompressed transparently
 			Archive(Stream& stream, Direction direction, ResourceManager* resourceManager = NULL, u32 version = 0);
+			~Archive();
 
 			void SetContentType(Content content);
 			Content GetContentType() const;
 
-			u64 GetStreamSize() const { return m_stream.GetSize(); }
+			//Output block write mode. Must be set before any blocks are pushed.
+			void SetWriteMode(WriteMode writeMode);
+			WriteMode GetWriteMode() const;
+
+			//Compress output in independently seekable chunks. Must be set before any data is serialised,
+			//buffered write mode only. Output is finalised when the archive is destroyed.
+			void SetCompression(CompressedStream::Codec codec, u32 chunkSize = CompressedStream::s_defaultChunkSize);
+			bool IsCompressed() const { return m_compressedStream != NULL; }
+
+			u64 GetStreamSize() const { return m_stream->GetSize(); }
+
+			//Archive format version. When writing, must be set before any data is serialised.
+			void SetFormatVersion(u32 formatVersion);
+			u32 GetFormatVersion() const;
 
 			//Default named block serialise
 			template <typename T> void Serialise(T& object, const Tag& tag);
@@ -136,6 +248,10 @@ namespace ion
 			//Serialise STL string
 			void Serialise(std::string& string);
 
+			//Zero-copy views, same encoding as std::vector<u8> and std::string
+			void Serialise(View& view);
+			void Serialise(StringView& view);
+
 			//Serialise STL containers
 			template <typename T1, typename T2> void Serialise(std::pair<T1, T2>& pair);
 			//template <typename T1, typename T2, typename T3> void Serialise(std::tuple<T1, T2, T3>& tuple);
@@ -145,8 +261,10 @@ namespace ion
 
 		private:
 
-			//i/o stream
-			Stream& m_stream;
+			//i/o stream, compression layer or user stream
+			Stream* m_stream;
+			Stream* m_baseStream;
+			CompressedStream* m_compressedStream;
 
 			//Stream version
 			u32 m_version;
@@ -157,9 +275,49 @@ namespace ion
 			//Content type
 			Content m_contentType;
 
+			//Output block write mode
+			WriteMode m_writeMode;
+
 			//Resource manager
 			ResourceManager* m_resourceManager;
 
+			//Archive format version
+			u32 m_formatVersion;
+			bool m_formatHeaderWritten;
+
+			//Stream was written with opposite byte order
+			bool m_endianSwap;
+
+			//Vector serialise, per-element or bulk for ION_SERIALISE_POD types
+			template <typename T> void SerialiseVector(std::vector<T>& objects, std::false_type podType);
+			template <typename T> void SerialiseVector(std::vector<T>& objects, std::true_type podType);
+
+			//Endian swap array of wordSize values after reading
+			void EndianSwapArray(void* data, u64 count, int wordSize);
+
+			//Per-scope tag lookup, built once per scope on read
+			struct BlockIndex
+			{
+				struct Entry
+				{
+					Entry() { cursor = 0; }
+
+					//Block offsets (relative to scope owner start) in file order, tags may repeat
+					std::vector<u64> offsets;
+
+					//Next expected offset, sequential reads of repeated tags hit without searching
+					u32 cursor;
+				};
+
+				BlockIndex() { built = false; }
+
+				void Add(u32 tag, u64 offset) { entries[tag].offsets.push_back(offset); }
+				bool Find(u32 tag, u64 position, u64& offset);
+
+				std::unordered_map<u32, Entry> entries;
+				bool built;
+			};
+
 			//Block
 			struct Block
 			{
@@ -189,11 +347,38 @@ namespace ion
 				MemoryStream data;
 				u64 startPos;
 				Block* parent;
+
+				//Child tags and offsets (write), or child lookup (read)
+				std::vector<std::pair<u32, u64>> children;
+				BlockIndex index;
 			};
 
+			//Format and index block tags
+			static const u32 s_formatTag;
+			static const u32 s_byteOrderMark;
+			static const u32 s_indexTag;
+
+			//Blocks with fewer children are cheaper to scan than to index
+			static const int s_minIndexEntries = 4;
+
+			void WriteFormatHeader();
+			void ReadFormatHeader();
+
+			//Block search
+			bool FindBlockLegacy(Block& block, const Tag& tag, u64 scopeStart, u64 scopeEnd);
+			bool FindBlockIndexed(Block& block, const Tag& tag, u64 scopeStart, u64 scopeEnd);
+			void BuildBlockIndex(BlockIndex& index, bool hasTable, u64 scopeOwnerPos, u64 scopeStart, u64 scopeEnd);
+			void WriteBlockIndex(Block& block);
+
+			//Reads size bytes into view, pointing into the stream if it's memory backed
+			void ReadView(View& view, u64 size);
+
 			//Block stack
 			std::vector<Block> m_blockStack;
 
+			//Root scope index (read)
+			BlockIndex m_rootIndex;
+
 			//Pointer constructor/serialiser
 			struct PointerMappingBase
 			{
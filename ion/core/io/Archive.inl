@@ -205,6 +205,74 @@ namespace ion
 		}
 
 		template <typename T> void Archive::Serialise(std::vector<T>& objects)
+		{
+			SerialiseVector(objects, std::integral_constant<bool, IsSerialisePOD<T>::value>());
+		}
+
+		template <typename T> void Archive::SerialiseVector(std::vector<T>& objects, std::true_type podType)
+		{
+			typedef typename T::SerialisePODWord Word;
+			static_assert(std::is_trivially_copyable<T>::value, "ION_SERIALISE_POD type must be trivially copyable");
+			static_assert((sizeof(T) % sizeof(Word)) == 0, "ION_SERIALISE_POD type size must be a multiple of its word size");
+
+			if (GetDirection() == Direction::In)
+			{
+				//Serialise in num objects
+				int numObjects = 0;
+				Serialise(numObjects, "count");
+
+				//Clear and reserve vector
+				objects.clear();
+				objects.resize(numObjects);
+
+				if (numObjects > 0)
+				{
+					if (PushBlock("podData"))
+					{
+						//Read all objects in one go
+						u64 size = m_blockStack.back().header.size - sizeof(Block::Header);
+						if (size == (sizeof(T) * numObjects))
+						{
+							Serialise(objects.data(), size);
+
+							if (m_endianSwap)
+							{
+								EndianSwapArray(objects.data(), size / sizeof(Word), sizeof(Word));
+							}
+						}
+						else
+						{
+							debug::error << "Archive::Serialise(std::vector<T>&) - POD data size mismatch, type layout changed" << debug::end;
+						}
+
+						PopBlock();
+					}
+					else
+					{
+						//Written per-element before type was tagged POD
+						for (int i = 0; i < numObjects; i++)
+						{
+							Serialise(objects[i], "object");
+						}
+					}
+				}
+			}
+			else
+			{
+				//Serialise out num objects
+				int numObjects = (int)objects.size();
+				Serialise(numObjects, "count");
+
+				//Serialise all objects out in one go
+				if (numObjects > 0 && PushBlock("podData"))
+				{
+					Serialise(objects.data(), sizeof(T) * numObjects);
+					PopBlock();
+				}
+			}
+		}
+
+		template <typename T> void Archive::SerialiseVector(std::vector<T>& objects, std::false_type podType)
 		{
 			if (GetDirection() == Direction::In)
 			{
@@ -252,6 +320,11 @@ namespace ion
 				{
 					data.resize(numObjects);
 					Serialise(&data[0], sizeof(T) * numObjects);
+
+					if (m_endianSwap && sizeof(T) > 1)
+					{
+						EndianSwapArray(&data[0], numObjects, sizeof(T));
+					}
 				}
 			}
 			else
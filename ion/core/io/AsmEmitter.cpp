@@ -0,0 +1,165 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		AsmEmitter.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Buffered assembly text writer with table driven hex formatting
+///////////////////////////////////////////////////
+
+#include "AsmEmitter.h"
+#include "maths/Maths.h"
+
+#include <cstring>
+
+namespace ion
+{
+	namespace io
+	{
+		//Two hex digits per byte value
+		static const char s_hexPairs[] =
+			"000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+			"202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+			"404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+			"606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+			"808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+			"A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+			"C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+			"E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+		static const int s_maxHexDigits = 8;
+
+		AsmEmitter::AsmEmitter(std::ostream& stream, int bufferSize)
+			: m_stream(stream)
+			, m_size(0)
+		{
+			//Room for at least one full hex literal
+			m_buffer.resize(maths::Max(bufferSize, s_maxHexDigits + 2));
+		}
+
+		AsmEmitter::~AsmEmitter()
+		{
+			Flush();
+		}
+
+		void AsmEmitter::Flush()
+		{
+			if(m_size > 0)
+			{
+				m_stream.write(m_buffer.data(), m_size);
+				m_size = 0;
+			}
+		}
+
+		AsmEmitter& AsmEmitter::Text(const char* text)
+		{
+			return Text(text, (int)strlen(text));
+		}
+
+		AsmEmitter& AsmEmitter::Text(const std::string& text)
+		{
+			return Text(text.data(), (int)text.size());
+		}
+
+		AsmEmitter& AsmEmitter::Text(const char* text, int length)
+		{
+			if(length > (int)m_buffer.size())
+			{
+				//Larger than buffer, write straight through
+				Flush();
+				m_stream.write(text, length);
+			}
+			else
+			{
+				memcpy(Reserve(length), text, length);
+				m_size += length;
+			}
+
+			return *this;
+		}
+
+		AsmEmitter& AsmEmitter::Char(char character)
+		{
+			*Reserve(1) = character;
+			m_size++;
+			return *this;
+		}
+
+		AsmEmitter& AsmEmitter::NewLine()
+		{
+			return Char('\n');
+		}
+
+		AsmEmitter& AsmEmitter::Hex(u32 value, int minDigits)
+		{
+			//Significant digits, at least one
+			int numDigits = 1;
+			for(u32 remaining = value >> 4; remaining; remaining >>= 4)
+			{
+				numDigits++;
+			}
+
+			numDigits = maths::Clamp(maths::Max(numDigits, minDigits), 1, s_maxHexDigits);
+
+			//Fill from least significant, two digits at a time
+			char* dest = Reserve(numDigits);
+			int pos = numDigits;
+
+			while(pos >= 2)
+			{
+				const char* pair = &s_hexPairs[(value & 0xFF) * 2];
+				dest[--pos] = pair[1];
+				dest[--pos] = pair[0];
+				value >>= 8;
+			}
+
+			if(pos > 0)
+			{
+				dest[0] = s_hexPairs[((value & 0xF) * 2) + 1];
+			}
+
+			m_size += numDigits;
+			return *this;
+		}
+
+		template <typename T> void AsmEmitter::DcValues(const T* values, int count, int digits, const char* separator)
+		{
+			const int separatorLength = (int)strlen(separator);
+
+			for(int i = 0; i < count; i++)
+			{
+				if(i > 0)
+				{
+					Text(separator, separatorLength);
+				}
+
+				HexLiteral(values[i], digits);
+			}
+
+			NewLine();
+		}
+
+		void AsmEmitter::DcB(const u8* values, int count, const char* separator)
+		{
+			BeginDcB();
+			DcValues(values, count, 2, separator);
+		}
+
+		void AsmEmitter::DcW(const u16* values, int count, const char* separator)
+		{
+			BeginDcW();
+			DcValues(values, count, 4, separator);
+		}
+
+		void AsmEmitter::DcL(const u32* values, int count, const char* separator)
+		{
+			BeginDcL();
+			DcValues(values, count, 8, separator);
+		}
+	}
+}
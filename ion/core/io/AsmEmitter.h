@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		AsmEmitter.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Buffered assembly text writer with table driven hex formatting
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ion
+{
+	namespace io
+	{
+		//Formats into a preallocated buffer, written to the stream in large chunks.
+		//Hex is always uppercase and zero padded, stream formatting flags are neither used nor changed.
+		class AsmEmitter
+		{
+		public:
+			static const int s_defaultBufferSize = 64 * 1024;
+
+			AsmEmitter(std::ostream& stream, int bufferSize = s_defaultBufferSize);
+			~AsmEmitter();
+
+			//Write buffered text to stream
+			void Flush();
+
+			AsmEmitter& Text(const char* text);
+			AsmEmitter& Text(const std::string& text);
+			AsmEmitter& Char(char character);
+			AsmEmitter& NewLine();
+
+			//Hex digits, zero padded to at least minDigits, no prefix
+			AsmEmitter& Hex(u32 value, int minDigits);
+
+			//"0x" prefixed hex
+			AsmEmitter& HexLiteral(u32 value, int minDigits) { return Text("0x", 2).Hex(value, minDigits); }
+
+			//Line starts, "\tdc.b\t" etc.
+			AsmEmitter& BeginDcB() { return Text("\tdc.b\t", 6); }
+			AsmEmitter& BeginDcW() { return Text("\tdc.w\t", 6); }
+			AsmEmitter& BeginDcL() { return Text("\tdc.l\t", 6); }
+
+			//Whole lines of "0x" prefixed values at natural width, e.g. "\tdc.w\t0x0001,0x0002\n"
+			void DcB(const u8* values, int count, const char* separator = ",");
+			void DcW(const u16* values, int count, const char* separator = ",");
+			void DcL(const u32* values, int count, const char* separator = ",");
+
+		private:
+			AsmEmitter& Text(const char* text, int length);
+
+			//Make room for size chars, flushing if needed
+			char* Reserve(int size)
+			{
+				if(m_size + size > (int)m_buffer.size())
+					Flush();
+
+				return m_buffer.data() + m_size;
+			}
+
+			template <typename T> void DcValues(const T* values, int count, int digits, const char* separator);
+
+			std::ostream& m_stream;
+			std::vector<char> m_buffer;
+			int m_size;
+		};
+	}
+}
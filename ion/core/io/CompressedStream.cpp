@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		CompressedStream.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Chunked compression layer over another stream
+///////////////////////////////////////////////////
+
+#include "core/io/CompressedStream.h"
+#include "core/debug/Debug.h"
+#include "core/memory/Memory.h"
+
+#include <algorithm>
+
+namespace ion
+{
+	namespace io
+	{
+		//'IONZ'
+		const u32 CompressedStream::s_magic = 0x5A4E4F49;
+
+		static const u32 s_invalidChunk = 0xFFFFFFFF;
+
+		CompressedStream::CompressedStream(Stream& stream, Codec codec, u32 chunkSize)
+			: m_stream(stream)
+		{
+			debug::Assert(chunkSize > 0 && chunkSize < s_chunkStoredFlag, "CompressedStream::CompressedStream() - Invalid chunk size");
+
+			m_direction = Direction::Out;
+			m_codec = codec;
+			m_chunkSize = chunkSize;
+			m_valid = true;
+			m_finished = false;
+			m_basePosition = stream.GetPosition();
+			m_size = 0;
+			m_position = 0;
+			m_chunkIndex = 0;
+			m_chunkFill = 0;
+
+			m_chunk.resize(m_chunkSize);
+			m_compressed.resize(GetMaxCompressedSizeLZ(m_chunkSize));
+
+			Header header;
+			header.magic = s_magic;
+			header.version = s_version;
+			header.codec = (u8)codec;
+			header.reserved = 0;
+			header.chunkSize = chunkSize;
+			m_stream.Write(&header, sizeof(Header));
+		}
+
+		CompressedStream::CompressedStream(Stream& stream)
+			: m_stream(stream)
+		{
+			m_direction = Direction::In;
+			m_codec = Codec::LZ;
+			m_chunkSize = 0;
+			m_valid = false;
+			m_finished = true;
+			m_basePosition = stream.GetPosition();
+			m_size = 0;
+			m_position = 0;
+			m_chunkIndex = s_invalidChunk;
+			m_chunkFill = 0;
+
+			u64 streamEnd = m_stream.GetSize();
+
+			if(streamEnd < m_basePosition + sizeof(Header) + sizeof(Footer))
+			{
+				debug::error << "CompressedStream::CompressedStream() - Stream too small" << debug::end;
+				return;
+			}
+
+			Header header;
+			m_stream.Read(&header, sizeof(Header));
+
+			if(header.magic != s_magic || header.version != s_version || header.chunkSize == 0 || header.chunkSize >= s_chunkStoredFlag)
+			{
+				debug::error << "CompressedStream::CompressedStream() - Bad header" << debug::end;
+				return;
+			}
+
+			Footer footer;
+			m_stream.Seek(streamEnd - sizeof(Footer), SeekMode::Start);
+			m_stream.Read(&footer, sizeof(Footer));
+
+			u64 tableSize = (u64)footer.numChunks * sizeof(ChunkEntry);
+
+			if(footer.magic != s_magic
+				|| m_basePosition + footer.tableOffset + tableSize + sizeof(Footer) != streamEnd
+				|| footer.uncompressedSize > (u64)footer.numChunks * header.chunkSize)
+			{
+				debug::error << "CompressedStream::CompressedStream() - Bad seek table" << debug::end;
+				return;
+			}
+
+			m_chunkTable.resize(footer.numChunks);
+			if(footer.numChunks > 0)
+			{
+				m_stream.Seek(m_basePosition + footer.tableOffset, SeekMode::Start);
+				m_stream.Read(m_chunkTable.data(), tableSize);
+			}
+
+			m_codec = (Codec)header.codec;
+			m_chunkSize = header.chunkSize;
+			m_size = footer.uncompressedSize;
+			m_chunk.resize(m_chunkSize);
+			m_valid = true;
+		}
+
+		CompressedStream::~CompressedStream()
+		{
+			if(m_direction == Direction::Out && !m_finished)
+			{
+				Finish();
+			}
+		}
+
+		bool CompressedStream::IsCompressed(Stream& stream)
+		{
+			u64 position = stream.GetPosition();
+			u32 magic = 0;
+
+			if((u64)stream.GetSize() < position + sizeof(u32))
+				return false;
+
+			stream.Read(&magic, sizeof(u32));
+			stream.Seek(position, SeekMode::Start);
+
+			return magic == s_magic;
+		}
+
+		void CompressedStream::Finish()
+		{
+			debug::Assert(m_direction == Direction::Out, "CompressedStream::Finish() - Stream is read-only");
+
+			if(!m_finished)
+			{
+				if(m_chunkFill > 0)
+				{
+					FlushChunk();
+				}
+
+				Footer footer;
+				footer.tableOffset = m_stream.GetPosition() - m_basePosition;
+				footer.uncompressedSize = m_size;
+				footer.numChunks = (u32)m_chunkTable.size();
+				footer.magic = s_magic;
+
+				if(m_chunkTable.size() > 0)
+				{
+					m_stream.Write(m_chunkTable.data(), m_chunkTable.size() * sizeof(ChunkEntry));
+				}
+
+				m_stream.Write(&footer, sizeof(Footer));
+				m_finished = true;
+			}
+		}
+
+		u64 CompressedStream::GetCompressedSize() const
+		{
+			return m_stream.GetPosition() - m_basePosition;
+		}
+
+		s64 CompressedStream::GetSize() const
+		{
+			return m_size;
+		}
+
+		s64 CompressedStream::GetPosition() const
+		{
+			return m_position;
+		}
+
+		s64 CompressedStream::Read(void* data, s64 size)
+		{
+			debug::Assert(m_direction == Direction::In, "CompressedStream::Read() - Stream is write-only");
+
+			u8* output = (u8*)data;
+			s64 bytesRead = 0;
+
+			size = std::min(size, (s64)(m_size - m_position));
+
+			while(bytesRead < size)
+			{
+				u32 chunkIndex = (u32)(m_position / m_chunkSize);
+				u32 chunkOffset = (u32)(m_position % m_chunkSize);
+
+				if(!LoadChunk(chunkIndex))
+					break;
+
+				u32 bytesToCopy = (u32)std::min((s64)(m_chunkFill - chunkOffset), size - bytesRead);
+				ion::memory::MemCopy(output + bytesRead, m_chunk.data() + chunkOffset, bytesToCopy);
+
+				bytesRead += bytesToCopy;
+				m_position += bytesToCopy;
+			}
+
+			return bytesRead;
+		}
+
+		s64 CompressedStream::Write(const void* data, s64 size)
+		{
+			debug::Assert(m_direction == Direction::Out && !m_finished, "CompressedStream::Write() - Stream is read-only or finished");
+
+			const u8* input = (const u8*)data;
+			s64 bytesWritten = 0;
+
+			while(bytesWritten < size)
+			{
+				u32 bytesToCopy = (u32)std::min((s64)(m_chunkSize - m_chunkFill), size - bytesWritten);
+				ion::memory::MemCopy(m_chunk.data() + m_chunkFill, input + bytesWritten, bytesToCopy);
+
+				m_chunkFill += bytesToCopy;
+				bytesWritten += bytesToCopy;
+
+				if(m_chunkFill == m_chunkSize)
+				{
+					FlushChunk();
+				}
+			}
+
+			m_size += bytesWritten;
+			m_position = m_size;
+
+			return bytesWritten;
+		}
+
+		s64 CompressedStream::Seek(s64 position, SeekMode origin)
+		{
+			s64 newPosition = (origin == SeekMode::Current) ? (m_position + position) : position;
+
+			if(m_direction == Direction::Out)
+			{
+				debug::Assert(newPosition == (s64)m_position, "CompressedStream::Seek() - Output is append-only");
+				return m_position;
+			}
+
+			debug::Assert(newPosition >= 0 && newPosition <= (s64)m_size, "CompressedStream::Seek() - Out of range");
+			m_position = newPosition;
+			return m_position;
+		}
+
+		void CompressedStream::FlushChunk()
+		{
+			CompressionLevel level = (m_codec == Codec::LZHigh) ? CompressionLevel::High : CompressionLevel::Fast;
+
+			ChunkEntry entry;
+			entry.offset = m_stream.GetPosition() - m_basePosition;
+
+			//Store as-is if compression doesn't gain anything
+			u32 compressedSize = CompressLZ(m_chunk.data(), m_chunkFill, m_compressed.data(), m_chunkFill - 1, level);
+
+			if(compressedSize > 0)
+			{
+				entry.size = compressedSize;
+				m_stream.Write(m_compressed.data(), compressedSize);
+			}
+			else
+			{
+				entry.size = m_chunkFill | s_chunkStoredFlag;
+				m_stream.Write(m_chunk.data(), m_chunkFill);
+			}
+
+			m_chunkTable.push_back(entry);
+			m_chunkFill = 0;
+		}
+
+		bool CompressedStream::LoadChunk(u32 chunkIndex)
+		{
+			if(chunkIndex == m_chunkIndex)
+				return true;
+
+			if(chunkIndex >= m_chunkTable.size())
+				return false;
+
+			const ChunkEntry& entry = m_chunkTable[chunkIndex];
+			u32 storedSize = entry.size & ~s_chunkStoredFlag;
+
+			//All chunks but the last are full
+			u32 expectedSize = (chunkIndex == m_chunkTable.size() - 1) ? (u32)(m_size - ((u64)chunkIndex * m_chunkSize)) : m_chunkSize;
+
+			m_stream.Seek(m_basePosition + entry.offset, SeekMode::Start);
+
+			if(entry.size & s_chunkStoredFlag)
+			{
+				if(storedSize != expectedSize || m_stream.Read(m_chunk.data(), storedSize) != storedSize)
+				{
+					debug::error << "CompressedStream::LoadChunk() - Bad stored chunk " << chunkIndex << debug::end;
+					return false;
+				}
+			}
+			else
+			{
+				if(m_compressed.size() < storedSize)
+				{
+					m_compressed.resize(storedSize);
+				}
+
+				if(m_stream.Read(m_compressed.data(), storedSize) != storedSize
+					|| DecompressLZ(m_compressed.data(), storedSize, m_chunk.data(), m_chunkSize) != expectedSize)
+				{
+					debug::error << "CompressedStream::LoadChunk() - Bad compressed chunk " << chunkIndex << debug::end;
+					return false;
+				}
+			}
+
+			m_chunkIndex = chunkIndex;
+			m_chunkFill = expectedSize;
+			return true;
+		}
+	}
+}
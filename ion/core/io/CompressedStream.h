@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		CompressedStream.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Chunked compression layer over another stream
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Types.h"
+#include "core/io/Stream.h"
+#include "core/io/CompressionLZ.h"
+
+#include <vector>
+
+namespace ion
+{
+	namespace io
+	{
+		//Compresses data in independent fixed size chunks, with a seek table at the end so
+		//any position can be read by decompressing a single chunk. The compressed data must
+		//extend to the end of the underlying stream. Writing is append-only.
+		class CompressedStream : public Stream
+		{
+		public:
+			enum class Codec : u8
+			{
+				LZ,			//Fast compression and decompression
+				LZHigh		//Slower compression, better ratio, same decompression speed
+			};
+
+			static const u32 s_defaultChunkSize = 64 * 1024;
+
+			//Write to stream, from its current position
+			CompressedStream(Stream& stream, Codec codec, u32 chunkSize = s_defaultChunkSize);
+
+			//Read from stream, from its current position
+			CompressedStream(Stream& stream);
+
+			virtual ~CompressedStream();
+
+			//Check for compressed stream header at current position, position is unchanged
+			static bool IsCompressed(Stream& stream);
+
+			//Flush last chunk and write seek table. Called on destruction if not called explicitly.
+			void Finish();
+
+			//Header and seek table were valid (read)
+			bool IsValid() const { return m_valid; }
+
+			Codec GetCodec() const { return m_codec; }
+			u64 GetCompressedSize() const;
+
+			virtual s64 GetSize() const;
+			virtual s64 GetPosition() const;
+			virtual s64 Read(void* data, s64 size);
+			virtual s64 Write(const void* data, s64 size);
+			virtual s64 Seek(s64 position, SeekMode origin = SeekMode::Current);
+
+		private:
+			enum class Direction { In, Out };
+
+			#pragma pack(push, 1)
+			struct Header
+			{
+				u32 magic;
+				u16 version;
+				u8 codec;
+				u8 reserved;
+				u32 chunkSize;
+			};
+
+			struct Footer
+			{
+				u64 tableOffset;
+				u64 uncompressedSize;
+				u32 numChunks;
+				u32 magic;
+			};
+
+			struct ChunkEntry
+			{
+				u64 offset;
+				u32 size;
+			};
+			#pragma pack(pop)
+
+			static const u32 s_magic;
+			static const u16 s_version = 1;
+
+			//Set in ChunkEntry::size if the chunk didn't compress and is stored as-is
+			static const u32 s_chunkStoredFlag = 0x80000000;
+
+			void FlushChunk();
+			bool LoadChunk(u32 chunkIndex);
+
+			Stream& m_stream;
+			Direction m_direction;
+			Codec m_codec;
+			u32 m_chunkSize;
+			bool m_valid;
+			bool m_finished;
+
+			//Underlying stream position of header, chunk offsets are relative to this
+			u64 m_basePosition;
+
+			//Uncompressed size and position
+			u64 m_size;
+			u64 m_position;
+
+			std::vector<ChunkEntry> m_chunkTable;
+
+			//Current chunk, uncompressed
+			std::vector<u8> m_chunk;
+			u32 m_chunkIndex;
+			u32 m_chunkFill;
+
+			//Compression/decompression scratch buffer
+			std::vector<u8> m_compressed;
+		};
+	}
+}
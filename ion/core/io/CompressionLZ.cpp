@@ -0,0 +1,333 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		CompressionLZ.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Byte oriented LZ77 block compressor (LZ4 block layout)
+///////////////////////////////////////////////////
+
+#include "CompressionLZ.h"
+#include "core/memory/Memory.h"
+
+#include <vector>
+
+namespace ion
+{
+	namespace io
+	{
+		//Sequence layout: token (4 bits literal length, 4 bits match length - minMatch),
+		//extended literal length, literals, u16 LE match offset, extended match length.
+		//Final sequence is literals only.
+		static const u32 s_minMatch = 4;
+		static const u32 s_lastLiterals = 5;
+		static const u32 s_matchSearchLimit = 12;
+		static const u32 s_maxDistance = 65535;
+		static const u32 s_hashBits = 16;
+		static const u32 s_hashSize = (1 << s_hashBits);
+		static const u32 s_invalidPos = 0xFFFFFFFF;
+		static const int s_maxChainSearchHigh = 64;
+
+		static inline u32 Read32(const u8* data)
+		{
+			u32 value;
+			memory::MemCopy(&value, data, sizeof(u32));
+			return value;
+		}
+
+		static inline u32 HashLZ(u32 sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - s_hashBits);
+		}
+
+		static inline u32 MatchLength(const u8* src, u32 pos, u32 ref, u32 limit)
+		{
+			u32 length = 0;
+			while(pos + length < limit && src[ref + length] == src[pos + length])
+			{
+				length++;
+			}
+
+			return length;
+		}
+
+		static bool WriteLength(u8* dst, u32& out, u32 dstCapacity, u32 length)
+		{
+			while(length >= 255)
+			{
+				if(out >= dstCapacity)
+					return false;
+
+				dst[out++] = 255;
+				length -= 255;
+			}
+
+			if(out >= dstCapacity)
+				return false;
+
+			dst[out++] = (u8)length;
+			return true;
+		}
+
+		static bool WriteSequence(const u8* src, u32 anchor, u32 pos, u32 offset, u32 matchLength, u8* dst, u32& out, u32 dstCapacity)
+		{
+			u32 literalLength = pos - anchor;
+
+			if(out >= dstCapacity)
+				return false;
+
+			u32 tokenPos = out++;
+			u8 token = (u8)((literalLength >= 15 ? 15 : literalLength) << 4);
+
+			if(literalLength >= 15 && !WriteLength(dst, out, dstCapacity, literalLength - 15))
+				return false;
+
+			if(out + literalLength > dstCapacity)
+				return false;
+
+			memory::MemCopy(dst + out, src + anchor, literalLength);
+			out += literalLength;
+
+			if(matchLength > 0)
+			{
+				if(out + 2 > dstCapacity)
+					return false;
+
+				dst[out++] = (u8)(offset & 0xFF);
+				dst[out++] = (u8)(offset >> 8);
+
+				u32 matchCode = matchLength - s_minMatch;
+				token |= (u8)(matchCode >= 15 ? 15 : matchCode);
+
+				if(matchCode >= 15 && !WriteLength(dst, out, dstCapacity, matchCode - 15))
+					return false;
+			}
+
+			dst[tokenPos] = token;
+			return true;
+		}
+
+		u32 GetMaxCompressedSizeLZ(u32 size)
+		{
+			return size + (size / 255) + 16;
+		}
+
+		u32 CompressLZ(const u8* src, u32 srcSize, u8* dst, u32 dstCapacity, CompressionLevel level)
+		{
+			u32 out = 0;
+			u32 anchor = 0;
+
+			if(srcSize > s_matchSearchLimit)
+			{
+				const u32 matchLimit = srcSize - s_lastLiterals;
+				const u32 searchLimit = srcSize - s_matchSearchLimit;
+
+				std::vector<u32> hashTable(s_hashSize, s_invalidPos);
+
+				//Previous position with same hash, per position in window (high level only)
+				std::vector<u32> chain;
+				u32 nextInsert = 0;
+
+				if(level == CompressionLevel::High)
+				{
+					chain.resize(s_maxDistance + 1, s_invalidPos);
+				}
+
+				//Finds best match at pos, inserting all positions up to and including pos
+				auto findMatch = [&](u32 pos, u32& matchPos) -> u32
+				{
+					if(level == CompressionLevel::Fast)
+					{
+						u32 hash = HashLZ(Read32(src + pos));
+						u32 ref = hashTable[hash];
+						hashTable[hash] = pos;
+
+						if(ref != s_invalidPos && (pos - ref) <= s_maxDistance && Read32(src + ref) == Read32(src + pos))
+						{
+							matchPos = ref;
+							return s_minMatch + MatchLength(src, pos + s_minMatch, ref + s_minMatch, matchLimit);
+						}
+
+						return 0;
+					}
+
+					for(; nextInsert <= pos; nextInsert++)
+					{
+						u32 hash = HashLZ(Read32(src + nextInsert));
+						chain[nextInsert & s_maxDistance] = hashTable[hash];
+						hashTable[hash] = nextInsert;
+					}
+
+					u32 bestLength = 0;
+					u32 ref = chain[pos & s_maxDistance];
+					u32 sequence = Read32(src + pos);
+
+					for(int i = 0; i < s_maxChainSearchHigh && ref != s_invalidPos && (pos - ref) <= s_maxDistance; i++)
+					{
+						if(Read32(src + ref) == sequence)
+						{
+							u32 length = s_minMatch + MatchLength(src, pos + s_minMatch, ref + s_minMatch, matchLimit);
+							if(length > bestLength)
+							{
+								bestLength = length;
+								matchPos = ref;
+							}
+						}
+
+						u32 prev = chain[ref & s_maxDistance];
+						if(prev == s_invalidPos || prev >= ref)
+							break;
+
+						ref = prev;
+					}
+
+					return bestLength;
+				};
+
+				u32 pos = 0;
+
+				while(pos < searchLimit)
+				{
+					u32 matchPos = 0;
+					u32 matchLength = findMatch(pos, matchPos);
+
+					if(matchLength < s_minMatch)
+					{
+						//No match, skip faster through incompressible data at fast level
+						pos += (level == CompressionLevel::Fast) ? (1 + ((pos - anchor) >> 6)) : 1;
+						continue;
+					}
+
+					if(level == CompressionLevel::High && pos + 1 < searchLimit)
+					{
+						//Lazy match, prefer a longer match starting at the next byte
+						u32 nextMatchPos = 0;
+						u32 nextMatchLength = findMatch(pos + 1, nextMatchPos);
+						if(nextMatchLength > matchLength + 1)
+						{
+							pos++;
+							matchPos = nextMatchPos;
+							matchLength = nextMatchLength;
+						}
+					}
+
+					//Extend backwards into pending literals
+					while(pos > anchor && matchPos > 0 && src[pos - 1] == src[matchPos - 1])
+					{
+						pos--;
+						matchPos--;
+						matchLength++;
+					}
+
+					if(!WriteSequence(src, anchor, pos, pos - matchPos, matchLength, dst, out, dstCapacity))
+						return 0;
+
+					pos += matchLength;
+					anchor = pos;
+
+					if(level == CompressionLevel::Fast && pos < searchLimit)
+					{
+						//Insert a position inside the match to improve next search
+						hashTable[HashLZ(Read32(src + pos - 2))] = pos - 2;
+					}
+				}
+			}
+
+			//Remaining literals
+			if(!WriteSequence(src, anchor, srcSize, 0, 0, dst, out, dstCapacity))
+				return 0;
+
+			return out;
+		}
+
+		u32 DecompressLZ(const u8* src, u32 srcSize, u8* dst, u32 dstCapacity)
+		{
+			u32 in = 0;
+			u32 out = 0;
+
+			while(in < srcSize)
+			{
+				u8 token = src[in++];
+
+				//Literals
+				u32 literalLength = token >> 4;
+				if(literalLength == 15)
+				{
+					u8 byte = 255;
+					while(byte == 255)
+					{
+						if(in >= srcSize)
+							return 0;
+
+						byte = src[in++];
+						literalLength += byte;
+					}
+				}
+
+				if(in + literalLength > srcSize || out + literalLength > dstCapacity)
+					return 0;
+
+				memory::MemCopy(dst + out, src + in, literalLength);
+				in += literalLength;
+				out += literalLength;
+
+				//Last sequence has no match
+				if(in == srcSize)
+					break;
+
+				//Match
+				if(in + 2 > srcSize)
+					return 0;
+
+				u32 offset = src[in] | (src[in + 1] << 8);
+				in += 2;
+
+				if(offset == 0 || offset > out)
+					return 0;
+
+				u32 matchLength = token & 15;
+				if(matchLength == 15)
+				{
+					u8 byte = 255;
+					while(byte == 255)
+					{
+						if(in >= srcSize)
+							return 0;
+
+						byte = src[in++];
+						matchLength += byte;
+					}
+				}
+
+				matchLength += s_minMatch;
+
+				if(out + matchLength > dstCapacity)
+					return 0;
+
+				u32 ref = out - offset;
+
+				if(offset >= matchLength)
+				{
+					memory::MemCopy(dst + out, dst + ref, matchLength);
+				}
+				else
+				{
+					//Overlapping, repeat pattern
+					for(u32 i = 0; i < matchLength; i++)
+					{
+						dst[out + i] = dst[ref + i];
+					}
+				}
+
+				out += matchLength;
+			}
+
+			return out;
+		}
+	}
+}
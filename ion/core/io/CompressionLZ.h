@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		CompressionLZ.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Byte oriented LZ77 block compressor (LZ4 block layout)
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Types.h"
+
+namespace ion
+{
+	namespace io
+	{
+		enum class CompressionLevel
+		{
+			Fast,	//Single hash probe, for runtime/iteration
+			High	//Hash chain search with lazy matching, for shipping. Same decoder.
+		};
+
+		//Worst case compressed size for incompressible input
+		u32 GetMaxCompressedSizeLZ(u32 size);
+
+		//Returns compressed size, or 0 if output doesn't fit in dstCapacity
+		u32 CompressLZ(const u8* src, u32 srcSize, u8* dst, u32 dstCapacity, CompressionLevel level);
+
+		//Returns decompressed size, or 0 if input is malformed or doesn't fit in dstCapacity
+		u32 DecompressLZ(const u8* src, u32 srcSize, u8* dst, u32 dstCapacity);
+	}
+}
@@ -236,7 +236,7 @@ namespace ion
 				m_stream.write((const char*)Data, Size);
 				m_currentPosition = (s64)m_stream.tellp();
 				bytesWritten = m_currentPosition - startPosition;
-				m_size += bytesWritten;
+				m_size = std::max(m_size, m_currentPosition);
 			}
 
 			return bytesWritten;
@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		MappedFileStream.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Read-only memory mapped file stream
+///////////////////////////////////////////////////
+
+#include "core/io/MappedFileStream.h"
+#include "core/io/File.h"
+#include "core/io/FileDevice.h"
+#include "core/io/FileSystem.h"
+#include "core/debug/Debug.h"
+#include "core/memory/Memory.h"
+
+#include <algorithm>
+
+namespace ion
+{
+	namespace io
+	{
+		MappedFileStream::MappedFileStream()
+		{
+			m_data = nullptr;
+			m_size = 0;
+			m_position = 0;
+			m_open = false;
+		}
+
+		MappedFileStream::MappedFileStream(const std::string& filename)
+		{
+			m_data = nullptr;
+			m_size = 0;
+			m_position = 0;
+			m_open = false;
+
+			Open(filename);
+		}
+
+		MappedFileStream::~MappedFileStream()
+		{
+			if(m_open)
+				Close();
+		}
+
+		bool MappedFileStream::Open(const std::string& filename)
+		{
+			FileDevice* device = FileSystem::FindFileDevice(filename);
+			if(!device)
+			{
+				device = FileDevice::GetDefault();
+			}
+
+			return Open(filename, device);
+		}
+
+		bool MappedFileStream::Open(const std::string& filename, FileDevice* device)
+		{
+			if(m_open)
+				Close();
+
+			std::string fullPath = filename;
+
+			//If we have a file device, prepend mount point and current directory if not already passed
+			if(device)
+			{
+				fullPath = device->GetFullPath(filename);
+			}
+
+			m_filename = filename;
+			m_position = 0;
+
+			if(m_impl.Map(fullPath, m_data, m_size))
+			{
+				m_open = true;
+			}
+			else
+			{
+				//Mapping unavailable, read whole file through file device
+				File file;
+				if(file.Open(filename, device, File::OpenMode::Read))
+				{
+					m_fallbackData.resize((size_t)file.GetSize());
+
+					if(m_fallbackData.size() > 0)
+					{
+						file.Read(m_fallbackData.data(), file.GetSize());
+					}
+
+					m_data = m_fallbackData.data();
+					m_size = (s64)m_fallbackData.size();
+					m_open = true;
+				}
+			}
+
+			return m_open;
+		}
+
+		void MappedFileStream::Close()
+		{
+			if(m_open)
+			{
+				m_impl.Unmap();
+				m_fallbackData.clear();
+				m_fallbackData.shrink_to_fit();
+				m_data = nullptr;
+				m_size = 0;
+				m_position = 0;
+				m_open = false;
+			}
+		}
+
+		bool MappedFileStream::IsOpen() const
+		{
+			return m_open;
+		}
+
+		bool MappedFileStream::IsMapped() const
+		{
+			return m_open && m_fallbackData.empty() && m_size > 0;
+		}
+
+		s64 MappedFileStream::GetSize() const
+		{
+			return m_size;
+		}
+
+		s64 MappedFileStream::GetPosition() const
+		{
+			return m_position;
+		}
+
+		s64 MappedFileStream::Read(void* data, s64 size)
+		{
+			debug::Assert(m_position + size <= m_size, "MappedFileStream::Read() - Attempting to read beyond end of file");
+			size = std::min(size, m_size - m_position);
+
+			if(size > 0)
+			{
+				memory::MemCopy(data, m_data + m_position, (u32)size);
+				m_position += size;
+			}
+
+			return size;
+		}
+
+		s64 MappedFileStream::Write(const void* data, s64 size)
+		{
+			debug::Error("MappedFileStream::Write() - Stream is read-only");
+			return 0;
+		}
+
+		s64 MappedFileStream::Seek(s64 position, SeekMode origin)
+		{
+			if(origin == SeekMode::Start)
+			{
+				m_position = std::min(position, m_size);
+			}
+			else
+			{
+				m_position = std::min(m_position + position, m_size);
+			}
+
+			return m_position;
+		}
+
+		const u8* MappedFileStream::GetView(s64 position, s64 size) const
+		{
+			if(!m_open || position < 0 || size < 0 || position + size > m_size)
+				return nullptr;
+
+			return m_data + position;
+		}
+
+		const u8* MappedFileStream::ReadView(s64 size)
+		{
+			const u8* view = GetView(m_position, size);
+
+			if(view)
+			{
+				m_position += size;
+			}
+
+			return view;
+		}
+
+		const std::string& MappedFileStream::GetFilename() const
+		{
+			return m_filename;
+		}
+	}
+}
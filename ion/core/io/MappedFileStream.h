@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		MappedFileStream.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Read-only memory mapped file stream
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Platform.h"
+#include "core/Types.h"
+#include "core/io/Stream.h"
+
+#include <string>
+#include <vector>
+
+#if defined ION_PLATFORM_WINDOWS
+#include "core/platform/windows/io/MappedFileWindows.h"
+#elif defined ION_PLATFORM_LINUX
+#include "core/platform/linux/io/MappedFileLinux.h"
+#elif defined ION_PLATFORM_MACOSX
+#include "core/platform/macosx/io/MappedFileMacOSX.h"
+#elif defined ION_PLATFORM_DREAMCAST
+#include "core/platform/dreamcast/io/MappedFileDreamcast.h"
+#elif defined ION_PLATFORM_ANDROID
+#include "core/platform/android/io/MappedFileAndroid.h"
+#endif
+
+namespace ion
+{
+	namespace io
+	{
+		class FileDevice;
+
+		//Maps the whole file into the address space. Where mapping isn't available
+		//(platform or file device doesn't support it) the file is read into memory instead.
+		class MappedFileStream : public Stream
+		{
+		public:
+			MappedFileStream();
+			MappedFileStream(const std::string& filename);
+			virtual ~MappedFileStream();
+
+			bool Open(const std::string& filename);
+			bool Open(const std::string& filename, FileDevice* device);
+			void Close();
+
+			bool IsOpen() const;
+			bool IsMapped() const;
+
+			virtual s64 GetSize() const;
+			virtual s64 GetPosition() const;
+			virtual s64 Read(void* data, s64 size);
+			virtual s64 Write(const void* data, s64 size);
+			virtual s64 Seek(s64 position, SeekMode origin = SeekMode::Current);
+
+			//Zero-copy view of a range of the file, valid until Close(). NULL if out of range
+			virtual const u8* GetView(s64 position, s64 size) const;
+
+			//Zero-copy view from current position, advances position. NULL (and no advance) if out of range
+			const u8* ReadView(s64 size);
+
+			const std::string& GetFilename() const;
+
+		private:
+			MappedFileImpl m_impl;
+			std::vector<u8> m_fallbackData;
+			std::string m_filename;
+
+			const u8* m_data;
+			s64 m_size;
+			s64 m_position;
+			bool m_open;
+		};
+	}
+}
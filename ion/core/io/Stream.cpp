@@ -82,6 +82,14 @@ namespace ion
 			return m_position;
 		}
 
+		const u8* MemoryStream::GetView(s64 position, s64 size) const
+		{
+			if(position < 0 || position + size > GetSize())
+				return NULL;
+
+			return m_bytes.data() + position;
+		}
+
 		MemoryStream& MemoryStream::operator = (const MemoryStream& rhs)
 		{
 			m_bytes = rhs.m_bytes;
@@ -33,6 +33,10 @@ namespace ion
 			virtual s64 Read(void* data, s64 size) = 0;
 			virtual s64 Write(const void* data, s64 size) = 0;
 			virtual s64 Seek(s64 position, SeekMode origin = SeekMode::Current) = 0;
+
+			//Direct pointer to a range of the stream's data, or NULL if it isn't memory backed.
+			//Valid while the stream is open and unmodified.
+			virtual const u8* GetView(s64 position, s64 size) const { return NULL; }
 		};
 
 		class MemoryStream : public Stream
@@ -46,6 +50,7 @@ namespace ion
 			virtual s64 Read(void* data, s64 size);
 			virtual s64 Write(const void* data, s64 size);
 			virtual s64 Seek(s64 position, SeekMode origin = SeekMode::Current);
+			virtual const u8* GetView(s64 position, s64 size) const;
 
 			MemoryStream& operator = (const MemoryStream& rhs);
 
@@ -16,14 +16,38 @@
 
 #include "core/Types.h"
 
+//SSSE3 byte shuffle where the compiler targets it, otherwise SSE2 shifts and word shuffles,
+//which every x64 target (including MSVC, which defines no __SSSE3__) has
+#if defined(__SSSE3__) || defined(__AVX__)
+#define ION_ENDIAN_SWAP_SSSE3
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ION_ENDIAN_SWAP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define ION_ENDIAN_SWAP_NEON
+#include <arm_neon.h>
+#endif
+
 namespace ion
 {
 	namespace memory
 	{
+		enum class Endian { Little, Big };
+
+		inline Endian GetNativeEndian();
+
 		inline void EndianSwap(u16& value);
 		inline void EndianSwap(s16& value);
 		inline void EndianSwap(u32& value);
 		inline void EndianSwap(s32& value);
+		inline void EndianSwap(u64& value);
+		inline void EndianSwap(s64& value);
+
+		//Batch swap of contiguous values, vectorised where available
+		inline void EndianSwapArray(u16* values, u64 count);
+		inline void EndianSwapArray(u32* values, u64 count);
+		inline void EndianSwapArray(u64* values, u64 count);
 	}
 }
 
@@ -31,6 +55,12 @@ namespace ion
 {
 	namespace memory
 	{
+		Endian GetNativeEndian()
+		{
+			const u16 value = 1;
+			return (*(const u8*)&value == 1) ? Endian::Little : Endian::Big;
+		}
+
 		void EndianSwap(u16& value)
 		{
 			u8* bytes = (u8*)&value;
@@ -68,5 +98,124 @@ namespace ion
 			bytes[1] = bytes[2];
 			bytes[2] = temp;
 		}
+
+		void EndianSwap(u64& value)
+		{
+			u32* words = (u32*)&value;
+			u32 temp = words[0];
+			words[0] = words[1];
+			words[1] = temp;
+			EndianSwap(words[0]);
+			EndianSwap(words[1]);
+		}
+
+		void EndianSwap(s64& value)
+		{
+			EndianSwap((u64&)value);
+		}
+
+#if defined ION_ENDIAN_SWAP_SSE2
+		inline __m128i SwapBytes16(__m128i block)
+		{
+			return _mm_or_si128(_mm_slli_epi16(block, 8), _mm_srli_epi16(block, 8));
+		}
+#endif
+
+		void EndianSwapArray(u16* values, u64 count)
+		{
+			u64 i = 0;
+
+#if defined ION_ENDIAN_SWAP_SSSE3
+			const __m128i shuffle = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+			for(; i + 8 <= count; i += 8)
+			{
+				__m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+				_mm_storeu_si128((__m128i*)(values + i), _mm_shuffle_epi8(block, shuffle));
+			}
+#elif defined ION_ENDIAN_SWAP_SSE2
+			for(; i + 8 <= count; i += 8)
+			{
+				__m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+				_mm_storeu_si128((__m128i*)(values + i), SwapBytes16(block));
+			}
+#elif defined ION_ENDIAN_SWAP_NEON
+			for(; i + 8 <= count; i += 8)
+			{
+				vst1q_u8((u8*)(values + i), vrev16q_u8(vld1q_u8((const u8*)(values + i))));
+			}
+#endif
+
+			//Remainder (or whole array on scalar targets, written to auto-vectorise)
+			for(; i < count; i++)
+			{
+				u16 value = values[i];
+				values[i] = (u16)((value >> 8) | (value << 8));
+			}
+		}
+
+		void EndianSwapArray(u32* values, u64 count)
+		{
+			u64 i = 0;
+
+#if defined ION_ENDIAN_SWAP_SSSE3
+			const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+			for(; i + 4 <= count; i += 4)
+			{
+				__m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+				_mm_storeu_si128((__m128i*)(values + i), _mm_shuffle_epi8(block, shuffle));
+			}
+#elif defined ION_ENDIAN_SWAP_SSE2
+			for(; i + 4 <= count; i += 4)
+			{
+				//Swap bytes in each half, then the halves
+				__m128i block = SwapBytes16(_mm_loadu_si128((const __m128i*)(values + i)));
+				block = _mm_shufflelo_epi16(block, _MM_SHUFFLE(2, 3, 0, 1));
+				_mm_storeu_si128((__m128i*)(values + i), _mm_shufflehi_epi16(block, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+#elif defined ION_ENDIAN_SWAP_NEON
+			for(; i + 4 <= count; i += 4)
+			{
+				vst1q_u8((u8*)(values + i), vrev32q_u8(vld1q_u8((const u8*)(values + i))));
+			}
+#endif
+
+			for(; i < count; i++)
+			{
+				u32 value = values[i];
+				values[i] = (value >> 24) | ((value >> 8) & 0x0000FF00) | ((value << 8) & 0x00FF0000) | (value << 24);
+			}
+		}
+
+		void EndianSwapArray(u64* values, u64 count)
+		{
+			u64 i = 0;
+
+#if defined ION_ENDIAN_SWAP_SSSE3
+			const __m128i shuffle = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+			for(; i + 2 <= count; i += 2)
+			{
+				__m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+				_mm_storeu_si128((__m128i*)(values + i), _mm_shuffle_epi8(block, shuffle));
+			}
+#elif defined ION_ENDIAN_SWAP_SSE2
+			for(; i + 2 <= count; i += 2)
+			{
+				//Swap bytes in each 16 bit word, then reverse the words
+				__m128i block = SwapBytes16(_mm_loadu_si128((const __m128i*)(values + i)));
+				block = _mm_shufflelo_epi16(block, _MM_SHUFFLE(0, 1, 2, 3));
+				_mm_storeu_si128((__m128i*)(values + i), _mm_shufflehi_epi16(block, _MM_SHUFFLE(0, 1, 2, 3)));
+			}
+#elif defined ION_ENDIAN_SWAP_NEON
+			for(; i + 2 <= count; i += 2)
+			{
+				vst1q_u8((u8*)(values + i), vrev64q_u8(vld1q_u8((const u8*)(values + i))));
+			}
+#endif
+
+			for(; i < count; i++)
+			{
+				EndianSwap(values[i]);
+			}
+		}
 	}
-}
\ No newline at end of file
+}
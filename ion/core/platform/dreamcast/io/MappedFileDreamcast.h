@@ -0,0 +1,34 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		MappedFileDreamcast.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Memory mapped file
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Platform.h"
+#include "core/Types.h"
+
+#include <string>
+
+namespace ion
+{
+	namespace io
+	{
+		//No mapping support, MappedFileStream reads the file into memory
+		class MappedFileImpl
+		{
+		public:
+			bool Map(const std::string& filename, const u8*& data, s64& size) { return false; }
+			void Unmap() {}
+		};
+	}
+}
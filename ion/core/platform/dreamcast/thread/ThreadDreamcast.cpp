@@ -24,6 +24,11 @@ namespace ion
 			return (ThreadId)pthread_self();
 		}
 
+		u32 GetNumHardwareThreads()
+		{
+			return 1;
+		}
+
 		ThreadImpl::ThreadImpl(const std::string& name, void* thread)
 			: m_name(name)
 			, m_thread(thread)
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		MappedFileLinux.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Memory mapped file
+///////////////////////////////////////////////////
+
+#include "MappedFileLinux.h"
+#include "core/debug/Debug.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+namespace ion
+{
+	namespace io
+	{
+		MappedFileImpl::MappedFileImpl()
+		{
+			m_fileHndl = -1;
+			m_mapping = nullptr;
+			m_mappingSize = 0;
+		}
+
+		MappedFileImpl::~MappedFileImpl()
+		{
+			Unmap();
+		}
+
+		bool MappedFileImpl::Map(const std::string& filename, const u8*& data, s64& size)
+		{
+			m_fileHndl = open(filename.c_str(), O_RDONLY);
+			if(m_fileHndl < 0)
+			{
+				return false;
+			}
+
+			struct stat fileStat;
+			if(fstat(m_fileHndl, &fileStat) != 0)
+			{
+				Unmap();
+				return false;
+			}
+
+			m_mappingSize = (size_t)fileStat.st_size;
+
+			if(m_mappingSize > 0)
+			{
+				m_mapping = mmap(nullptr, m_mappingSize, PROT_READ, MAP_PRIVATE, m_fileHndl, 0);
+				if(m_mapping == MAP_FAILED)
+				{
+					debug::log << "MappedFileImpl::Map() - mmap() failed for " << filename << debug::end;
+					m_mapping = nullptr;
+					Unmap();
+					return false;
+				}
+			}
+
+			data = (const u8*)m_mapping;
+			size = (s64)m_mappingSize;
+
+			return true;
+		}
+
+		void MappedFileImpl::Unmap()
+		{
+			if(m_mapping)
+			{
+				munmap(m_mapping, m_mappingSize);
+				m_mapping = nullptr;
+			}
+
+			if(m_fileHndl >= 0)
+			{
+				close(m_fileHndl);
+				m_fileHndl = -1;
+			}
+
+			m_mappingSize = 0;
+		}
+	}
+}
@@ -15,6 +15,8 @@
 #include "core/thread/Thread.h"
 #include "core/debug/Debug.h"
 
+#include <unistd.h>
+
 namespace ion
 {
 	namespace thread
@@ -24,6 +26,12 @@ namespace ion
 			return (ThreadId)pthread_self();
 		}
 
+		u32 GetNumHardwareThreads()
+		{
+			long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+			return (numThreads > 0) ? (u32)numThreads : 1;
+		}
+
 		ThreadImpl::ThreadImpl(const std::string& name, void* thread)
 			: m_name(name)
 			, m_thread(thread)
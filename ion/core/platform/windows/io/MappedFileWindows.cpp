@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		MappedFileWindows.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Memory mapped file
+///////////////////////////////////////////////////
+
+#include "MappedFileWindows.h"
+#include "core/debug/Debug.h"
+
+namespace ion
+{
+	namespace io
+	{
+		MappedFileImpl::MappedFileImpl()
+		{
+			m_fileHndl = INVALID_HANDLE_VALUE;
+			m_mappingHndl = NULL;
+			m_view = nullptr;
+		}
+
+		MappedFileImpl::~MappedFileImpl()
+		{
+			Unmap();
+		}
+
+		bool MappedFileImpl::Map(const std::string& filename, const u8*& data, s64& size)
+		{
+			m_fileHndl = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+			if(m_fileHndl == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+
+			LARGE_INTEGER fileSize;
+			if(!GetFileSizeEx(m_fileHndl, &fileSize))
+			{
+				Unmap();
+				return false;
+			}
+
+			if(fileSize.QuadPart > 0)
+			{
+				m_mappingHndl = CreateFileMappingA(m_fileHndl, NULL, PAGE_READONLY, 0, 0, NULL);
+				if(!m_mappingHndl)
+				{
+					debug::log << "MappedFileImpl::Map() - CreateFileMapping() failed for " << filename << debug::end;
+					Unmap();
+					return false;
+				}
+
+				m_view = MapViewOfFile(m_mappingHndl, FILE_MAP_READ, 0, 0, 0);
+				if(!m_view)
+				{
+					debug::log << "MappedFileImpl::Map() - MapViewOfFile() failed for " << filename << debug::end;
+					Unmap();
+					return false;
+				}
+			}
+
+			data = (const u8*)m_view;
+			size = (s64)fileSize.QuadPart;
+
+			return true;
+		}
+
+		void MappedFileImpl::Unmap()
+		{
+			if(m_view)
+			{
+				UnmapViewOfFile(m_view);
+				m_view = nullptr;
+			}
+
+			if(m_mappingHndl)
+			{
+				CloseHandle(m_mappingHndl);
+				m_mappingHndl = NULL;
+			}
+
+			if(m_fileHndl != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(m_fileHndl);
+				m_fileHndl = INVALID_HANDLE_VALUE;
+			}
+		}
+	}
+}
@@ -25,6 +25,13 @@ namespace ion
 			return (ThreadId)::GetCurrentThreadId();
 		}
 
+		u32 GetNumHardwareThreads()
+		{
+			SYSTEM_INFO systemInfo;
+			GetSystemInfo(&systemInfo);
+			return (systemInfo.dwNumberOfProcessors > 0) ? (u32)systemInfo.dwNumberOfProcessors : 1;
+		}
+
 		ThreadImpl::ThreadImpl(const std::string& name, void* thread)
 			: m_name(name)
 			, m_thread(thread)
@@ -13,6 +13,7 @@
 ///////////////////////////////////////////////////
 
 #include "CriticalSection.h"
+#include "RealTime.h"
 
 namespace ion
 {
@@ -30,11 +31,13 @@ namespace ion
 
 		bool CriticalSection::TryBegin()
 		{
+			ION_CHECK_NOT_REALTIME("CriticalSection::TryBegin()");
 			return m_impl.TryBegin();
 		}
 
 		void CriticalSection::Begin()
 		{
+			ION_CHECK_NOT_REALTIME("CriticalSection::Begin()");
 			m_impl.Begin();
 		}
 
@@ -13,6 +13,7 @@
 ///////////////////////////////////////////////////
 
 #include "Event.h"
+#include "RealTime.h"
 
 namespace ion
 {
@@ -28,11 +29,13 @@ namespace ion
 
 		void Event::Signal()
 		{
+			ION_CHECK_NOT_REALTIME("Event::Signal()");
 			m_impl.Signal();
 		}
 
 		void Event::Wait()
 		{
+			ION_CHECK_NOT_REALTIME("Event::Wait()");
 			m_impl.Wait();
 		}
 	}
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		ParallelFor.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Split a range of work across worker threads
+///////////////////////////////////////////////////
+
+#include "ParallelFor.h"
+#include "Thread.h"
+#include "WorkerPool.h"
+#include "maths/Maths.h"
+
+#include <atomic>
+
+namespace ion
+{
+	namespace thread
+	{
+		namespace
+		{
+			struct ParallelForState
+			{
+				ParallelForState(u32 count, u32 batchSize, const std::function<void(u32 begin, u32 end)>& job)
+					: m_count(count)
+					, m_batchSize(batchSize)
+					, m_nextIndex(0)
+					, m_job(job)
+				{
+				}
+
+				//Take batches until range is exhausted
+				void Run()
+				{
+					for(u32 begin = m_nextIndex.fetch_add(m_batchSize); begin < m_count; begin = m_nextIndex.fetch_add(m_batchSize))
+					{
+						m_job(begin, maths::Min(begin + m_batchSize, m_count));
+					}
+				}
+
+				const u32 m_count;
+				const u32 m_batchSize;
+				std::atomic<u32> m_nextIndex;
+				const std::function<void(u32 begin, u32 end)>& m_job;
+			};
+		}
+
+		void ParallelFor(u32 count, u32 batchSize, const std::function<void(u32 begin, u32 end)>& job, u32 maxThreads)
+		{
+			if(count == 0)
+				return;
+
+			batchSize = maths::Max(batchSize, 1u);
+
+			u32 numBatches = (count + batchSize - 1) / batchSize;
+			u32 numThreads = (maxThreads > 0) ? maxThreads : GetNumHardwareThreads();
+			numThreads = maths::Clamp(numThreads, 1u, numBatches);
+
+			if(numThreads == 1)
+			{
+				job(0, count);
+				return;
+			}
+
+			ParallelForState state(count, batchSize, job);
+
+			//Calling thread takes a share of the batches
+			WorkerPool::Get().Run(numThreads - 1, [&state]()
+			{
+				state.Run();
+			});
+		}
+	}
+}
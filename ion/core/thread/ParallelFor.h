@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		ParallelFor.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Split a range of work across worker threads
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <functional>
+
+namespace ion
+{
+	namespace thread
+	{
+		//Runs job over [0, count) in batches of batchSize, on the shared WorkerPool and the calling thread.
+		//Batches may run in any order and on any thread, returns when all batches are complete.
+		//maxThreads of 0 uses all hardware threads, capped to the pool size. Runs inline if there's only one batch or thread.
+		void ParallelFor(u32 count, u32 batchSize, const std::function<void(u32 begin, u32 end)>& job, u32 maxThreads = 0);
+	}
+}
@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		RealTime.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Debug checks for blocking calls on real-time threads
+///////////////////////////////////////////////////
+
+#include "RealTime.h"
+#include "core/debug/Debug.h"
+
+#if defined ION_REALTIME_ALLOC_CHECKS
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace ion
+{
+	namespace thread
+	{
+		namespace realtime
+		{
+#if defined ION_REALTIME_CHECKS
+			//Scope nesting depth for this thread
+			static thread_local int s_realTimeDepth = 0;
+
+			Scope::Scope()
+			{
+				s_realTimeDepth++;
+			}
+
+			Scope::~Scope()
+			{
+				s_realTimeDepth--;
+			}
+
+			bool IsRealTime()
+			{
+				return s_realTimeDepth > 0;
+			}
+
+			void CheckNotRealTime(const char* operation)
+			{
+				if(s_realTimeDepth > 0)
+				{
+					//Leave real-time while reporting, it allocates. Restore after so the enclosing Scope unwinds to 0.
+					int depth = s_realTimeDepth;
+					s_realTimeDepth = 0;
+					debug::error << "Real-time thread called " << operation << debug::end;
+					s_realTimeDepth = depth;
+				}
+			}
+#else
+			bool IsRealTime()
+			{
+				return false;
+			}
+
+			void CheckNotRealTime(const char* operation)
+			{
+			}
+#endif
+		}
+	}
+}
+
+#if defined ION_REALTIME_ALLOC_CHECKS
+//Catch heap use on real-time threads, including containers and strings. Every replaceable
+//overload is here so none fall through to a runtime version that pairs differently.
+namespace
+{
+	void* RealTimeAlloc(std::size_t size)
+	{
+		ION_CHECK_NOT_REALTIME("operator new");
+		return std::malloc(size ? size : 1);
+	}
+
+	void RealTimeFree(void* ptr)
+	{
+		if(ptr)
+		{
+			ION_CHECK_NOT_REALTIME("operator delete");
+			std::free(ptr);
+		}
+	}
+
+#if defined __cpp_aligned_new
+	//Over allocate and keep the malloc pointer just below the aligned block
+	void* RealTimeAllocAligned(std::size_t size, std::align_val_t alignment)
+	{
+		std::size_t align = (std::size_t)alignment;
+		u8* block = (u8*)RealTimeAlloc(size + align + sizeof(void*));
+		if(!block)
+			return nullptr;
+
+		u8* aligned = (u8*)(((std::uintptr_t)(block + sizeof(void*)) + (align - 1)) & ~(std::uintptr_t)(align - 1));
+		((void**)aligned)[-1] = block;
+		return aligned;
+	}
+
+	void RealTimeFreeAligned(void* ptr)
+	{
+		if(ptr)
+		{
+			RealTimeFree(((void**)ptr)[-1]);
+		}
+	}
+#endif
+}
+
+void* operator new(std::size_t size)
+{
+	if(void* ptr = RealTimeAlloc(size))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return RealTimeAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return RealTimeAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	RealTimeFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	RealTimeFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size) noexcept
+{
+	RealTimeFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t size) noexcept
+{
+	RealTimeFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	RealTimeFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	RealTimeFree(ptr);
+}
+
+#if defined __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	if(void* ptr = RealTimeAllocAligned(size, alignment))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return RealTimeAllocAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return RealTimeAllocAligned(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept
+{
+	RealTimeFreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept
+{
+	RealTimeFreeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size, std::align_val_t alignment) noexcept
+{
+	RealTimeFreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t size, std::align_val_t alignment) noexcept
+{
+	RealTimeFreeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	RealTimeFreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	RealTimeFreeAligned(ptr);
+}
+#endif
+#endif
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		RealTime.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Debug checks for blocking calls on real-time threads
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Types.h"
+
+//Debug builds raise a debug::error on any lock or wait made inside a real-time scope
+#if defined ION_BUILD_DEBUG
+#define ION_REALTIME_CHECKS 1
+#endif
+
+//Define ION_REALTIME_ALLOC_CHECKS project wide to also catch heap allocations. Replaces the global operator
+//new/delete, so leave it off when the game or tools have their own allocator, or when running ASan.
+#if defined ION_REALTIME_ALLOC_CHECKS && !defined ION_REALTIME_CHECKS
+#undef ION_REALTIME_ALLOC_CHECKS
+#endif
+
+namespace ion
+{
+	namespace thread
+	{
+		namespace realtime
+		{
+			//Marks the calling thread as real-time (e.g. an audio callback) for the lifetime of the scope.
+			//Compiles to nothing without ION_REALTIME_CHECKS.
+			class Scope
+			{
+			public:
+#if defined ION_REALTIME_CHECKS
+				Scope();
+				~Scope();
+#else
+				Scope() {}
+#endif
+			};
+
+			//True if calling thread is inside a Scope
+			bool IsRealTime();
+
+			//Raises a debug::error if calling thread is inside a Scope, operation names the offending call
+			void CheckNotRealTime(const char* operation);
+		}
+	}
+}
+
+#if defined ION_REALTIME_CHECKS
+#define ION_CHECK_NOT_REALTIME(operation) ion::thread::realtime::CheckNotRealTime(operation)
+#else
+#define ION_CHECK_NOT_REALTIME(operation)
+#endif
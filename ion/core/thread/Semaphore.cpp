@@ -13,6 +13,7 @@
 ///////////////////////////////////////////////////
 
 #include "Semaphore.h"
+#include "RealTime.h"
 
 namespace ion
 {
@@ -31,11 +32,13 @@ namespace ion
 
 		void Semaphore::Signal()
 		{
+			ION_CHECK_NOT_REALTIME("Semaphore::Signal()");
 			m_impl.Signal();
 		}
 
 		void Semaphore::Wait()
 		{
+			ION_CHECK_NOT_REALTIME("Semaphore::Wait()");
 			m_impl.Wait();
 		}
 	}
@@ -0,0 +1,247 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		TaskGraph.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Run named tasks with dependencies across worker threads
+///////////////////////////////////////////////////
+
+#include "TaskGraph.h"
+#include "Thread.h"
+#include "WorkerPool.h"
+#include "CriticalSection.h"
+#include "Semaphore.h"
+#include "core/debug/Debug.h"
+#include "core/time/Time.h"
+#include "maths/Maths.h"
+
+#include <deque>
+
+namespace ion
+{
+	namespace thread
+	{
+		static const int s_maxSemaphoreCount = 0x7FFFFFFF;
+
+		struct TaskGraph::RunState
+		{
+			RunState()
+				: readySemaphore(s_maxSemaphoreCount)
+				, numCompleted(0)
+				, numWorkers(0)
+			{
+			}
+
+			//Guards ready queue, completion count and task run state
+			CriticalSection lock;
+
+			//Signalled once per ready task, and once per worker when all tasks are complete
+			Semaphore readySemaphore;
+			std::deque<TaskId> readyTasks;
+
+			int numCompleted;
+			int numWorkers;
+		};
+
+		TaskGraph::TaskGraph()
+		{
+			m_totalSeconds = 0.0;
+		}
+
+		TaskGraph::TaskId TaskGraph::AddTask(const std::string& name, const Task& task)
+		{
+			TaskDesc desc;
+			desc.name = name;
+			desc.task = task;
+			desc.numDependencies = 0;
+			desc.remainingDependencies = 0;
+			desc.dependencyFailed = false;
+			desc.result = false;
+			desc.skipped = false;
+			desc.seconds = 0.0;
+
+			m_tasks.push_back(desc);
+			return m_tasks.size() - 1;
+		}
+
+		void TaskGraph::AddDependency(TaskId task, TaskId dependency)
+		{
+			debug::Assert(task < m_tasks.size() && dependency < m_tasks.size(), "TaskGraph::AddDependency() - Invalid task id");
+			debug::Assert(task != dependency, "TaskGraph::AddDependency() - Task can't depend on itself");
+
+			m_tasks[dependency].dependents.push_back(task);
+			m_tasks[task].numDependencies++;
+		}
+
+		bool TaskGraph::CheckAcyclic() const
+		{
+			//Kahn's algorithm, all tasks are visited if there are no cycles
+			std::vector<int> remaining(m_tasks.size());
+			std::vector<TaskId> ready;
+
+			for(int i = 0; i < m_tasks.size(); i++)
+			{
+				remaining[i] = m_tasks[i].numDependencies;
+
+				if(remaining[i] == 0)
+				{
+					ready.push_back(i);
+				}
+			}
+
+			int numVisited = 0;
+
+			while(!ready.empty())
+			{
+				TaskId taskId = ready.back();
+				ready.pop_back();
+				numVisited++;
+
+				for(int i = 0; i < m_tasks[taskId].dependents.size(); i++)
+				{
+					TaskId dependentId = m_tasks[taskId].dependents[i];
+
+					if(--remaining[dependentId] == 0)
+					{
+						ready.push_back(dependentId);
+					}
+				}
+			}
+
+			return numVisited == m_tasks.size();
+		}
+
+		bool TaskGraph::Run(u32 maxThreads)
+		{
+			m_totalSeconds = 0.0;
+
+			if(m_tasks.empty())
+				return true;
+
+			if(!CheckAcyclic())
+			{
+				debug::error << "TaskGraph::Run() - Dependency cycle, no tasks were run" << debug::end;
+				return false;
+			}
+
+			u64 startTicks = time::GetSystemTicks();
+
+			RunState state;
+
+			for(int i = 0; i < m_tasks.size(); i++)
+			{
+				TaskDesc& desc = m_tasks[i];
+				desc.remainingDependencies = desc.numDependencies;
+				desc.dependencyFailed = false;
+				desc.result = false;
+				desc.skipped = false;
+				desc.seconds = 0.0;
+
+				if(desc.numDependencies == 0)
+				{
+					state.readyTasks.push_back(i);
+					state.readySemaphore.Signal();
+				}
+			}
+
+			//No point running more threads than there are tasks
+			u32 numThreads = (maxThreads > 0) ? maxThreads : GetNumHardwareThreads();
+			numThreads = maths::Clamp(numThreads, 1u, (u32)m_tasks.size());
+
+			//Calling thread works too
+			state.numWorkers = numThreads;
+
+			WorkerPool::Get().Run(numThreads - 1, [this, &state]()
+			{
+				RunTasks(state);
+			});
+
+			m_totalSeconds = time::TicksToSeconds(time::GetSystemTicks() - startTicks);
+
+			bool result = true;
+
+			for(int i = 0; i < m_tasks.size(); i++)
+			{
+				result &= m_tasks[i].result;
+			}
+
+			return result;
+		}
+
+		void TaskGraph::RunTasks(RunState& state)
+		{
+			while(true)
+			{
+				state.readySemaphore.Wait();
+
+				//Woken with nothing queued, all tasks are complete
+				state.lock.Begin();
+
+				if(state.readyTasks.empty())
+				{
+					state.lock.End();
+					break;
+				}
+
+				TaskId taskId = state.readyTasks.front();
+				state.readyTasks.pop_front();
+				bool skip = m_tasks[taskId].dependencyFailed;
+
+				state.lock.End();
+
+				TaskDesc& desc = m_tasks[taskId];
+				bool result = false;
+
+				if(skip)
+				{
+					debug::log << "TaskGraph: skipping '" << desc.name << "', a dependency failed" << debug::end;
+				}
+				else
+				{
+					u64 startTicks = time::GetSystemTicks();
+					result = desc.task();
+					desc.seconds = time::TicksToSeconds(time::GetSystemTicks() - startTicks);
+				}
+
+				state.lock.Begin();
+
+				desc.result = result;
+				desc.skipped = skip;
+
+				//Release dependents
+				for(int i = 0; i < desc.dependents.size(); i++)
+				{
+					TaskDesc& dependent = m_tasks[desc.dependents[i]];
+
+					if(!result)
+					{
+						dependent.dependencyFailed = true;
+					}
+
+					if(--dependent.remainingDependencies == 0)
+					{
+						state.readyTasks.push_back(desc.dependents[i]);
+						state.readySemaphore.Signal();
+					}
+				}
+
+				//Last task done, wake every worker to exit
+				if(++state.numCompleted == m_tasks.size())
+				{
+					for(int i = 0; i < state.numWorkers; i++)
+					{
+						state.readySemaphore.Signal();
+					}
+				}
+
+				state.lock.End();
+			}
+		}
+	}
+}
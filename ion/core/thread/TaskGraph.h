@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		TaskGraph.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Run named tasks with dependencies across worker threads
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Types.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ion
+{
+	namespace thread
+	{
+		class TaskGraph
+		{
+		public:
+			typedef u32 TaskId;
+			typedef std::function<bool()> Task;
+
+			static const TaskId InvalidTaskId = 0xFFFFFFFF;
+
+			TaskGraph();
+
+			TaskId AddTask(const std::string& name, const Task& task);
+
+			//Task won't start until dependency has completed. If dependency fails, task is skipped and also fails.
+			void AddDependency(TaskId task, TaskId dependency);
+
+			//Runs all tasks on the shared WorkerPool and the calling thread, returns when all are complete.
+			//maxThreads of 0 uses all hardware threads. Returns false if any task failed or was skipped.
+			bool Run(u32 maxThreads = 0);
+
+			int GetNumTasks() const { return m_tasks.size(); }
+			const std::string& GetTaskName(TaskId task) const { return m_tasks[task].name; }
+			bool GetTaskResult(TaskId task) const { return m_tasks[task].result; }
+			bool GetTaskSkipped(TaskId task) const { return m_tasks[task].skipped; }
+
+			//Time spent in task during last Run()
+			double GetTaskTime(TaskId task) const { return m_tasks[task].seconds; }
+
+			//Wall clock time of last Run()
+			double GetTotalTime() const { return m_totalSeconds; }
+
+		private:
+			struct TaskDesc
+			{
+				std::string name;
+				Task task;
+				std::vector<TaskId> dependents;
+				int numDependencies;
+
+				//Run state
+				int remainingDependencies;
+				bool dependencyFailed;
+				bool result;
+				bool skipped;
+				double seconds;
+			};
+
+			struct RunState;
+
+			void RunTasks(RunState& state);
+			bool CheckAcyclic() const;
+
+			std::vector<TaskDesc> m_tasks;
+			double m_totalSeconds;
+		};
+	}
+}
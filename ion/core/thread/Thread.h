@@ -39,6 +39,9 @@ namespace ion
 	{
 		ThreadId GetCurrentThreadId();
 
+		//Number of hardware threads available to the process
+		u32 GetNumHardwareThreads();
+
 		class Thread
 		{
 		public:
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		WorkerPool.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Persistent worker threads shared by ParallelFor and TaskGraph
+///////////////////////////////////////////////////
+
+#include "WorkerPool.h"
+#include "Thread.h"
+#include "maths/Maths.h"
+
+#include <algorithm>
+
+namespace ion
+{
+	namespace thread
+	{
+		static const int s_maxSemaphoreCount = 0x7FFFFFFF;
+
+		struct WorkerPool::Dispatch
+		{
+			Dispatch(const Job& job)
+				: job(job)
+				, doneSemaphore(s_maxSemaphoreCount)
+			{
+			}
+
+			const Job& job;
+
+			//Signalled once by each helper that took the dispatch
+			Semaphore doneSemaphore;
+		};
+
+		class WorkerPool::Worker : public Thread
+		{
+		public:
+			Worker(WorkerPool& pool)
+				: Thread("WorkerPool")
+				, m_pool(pool)
+			{
+			}
+
+		protected:
+			virtual void Entry()
+			{
+				Dispatch* dispatch = NULL;
+
+				while(m_pool.TakeDispatch(dispatch))
+				{
+					dispatch->job();
+					dispatch->doneSemaphore.Signal();
+				}
+			}
+
+		private:
+			WorkerPool& m_pool;
+		};
+
+		WorkerPool& WorkerPool::Get()
+		{
+			static WorkerPool pool(maths::Max(GetNumHardwareThreads(), 1u) - 1);
+			return pool;
+		}
+
+		WorkerPool::WorkerPool(u32 numWorkers)
+			: m_queueSemaphore(s_maxSemaphoreCount)
+		{
+			m_shutdown = false;
+
+			for(u32 i = 0; i < numWorkers; i++)
+			{
+				m_workers.push_back(new Worker(*this));
+				m_workers.back()->Run();
+			}
+		}
+
+		WorkerPool::~WorkerPool()
+		{
+			m_lock.Begin();
+			m_shutdown = true;
+			m_lock.End();
+
+			for(int i = 0; i < m_workers.size(); i++)
+			{
+				m_queueSemaphore.Signal();
+			}
+
+			for(int i = 0; i < m_workers.size(); i++)
+			{
+				m_workers[i]->Join();
+				delete m_workers[i];
+			}
+		}
+
+		bool WorkerPool::TakeDispatch(Dispatch*& dispatch)
+		{
+			while(true)
+			{
+				m_queueSemaphore.Wait();
+
+				m_lock.Begin();
+
+				if(m_shutdown)
+				{
+					m_lock.End();
+					return false;
+				}
+
+				//Queue may be empty if the helper was dropped after it was signalled
+				if(!m_queue.empty())
+				{
+					dispatch = m_queue.front();
+					m_queue.pop_front();
+					m_lock.End();
+					return true;
+				}
+
+				m_lock.End();
+			}
+		}
+
+		void WorkerPool::Run(u32 numHelpers, const Job& job)
+		{
+			numHelpers = maths::Min(numHelpers, (u32)m_workers.size());
+
+			if(numHelpers == 0)
+			{
+				job();
+				return;
+			}
+
+			Dispatch dispatch(job);
+
+			m_lock.Begin();
+
+			for(u32 i = 0; i < numHelpers; i++)
+			{
+				m_queue.push_back(&dispatch);
+			}
+
+			m_lock.End();
+
+			for(u32 i = 0; i < numHelpers; i++)
+			{
+				m_queueSemaphore.Signal();
+			}
+
+			job();
+
+			//Drop helpers no worker has taken yet, the work is already done
+			m_lock.Begin();
+			std::deque<Dispatch*>::iterator end = std::remove(m_queue.begin(), m_queue.end(), &dispatch);
+			u32 numDropped = std::distance(end, m_queue.end());
+			m_queue.erase(end, m_queue.end());
+			m_lock.End();
+
+			//Wait for the rest to finish
+			for(u32 i = numDropped; i < numHelpers; i++)
+			{
+				dispatch.doneSemaphore.Wait();
+			}
+		}
+	}
+}
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		WorkerPool.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	Persistent worker threads shared by ParallelFor and TaskGraph
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/Types.h"
+#include "CriticalSection.h"
+#include "Semaphore.h"
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace ion
+{
+	namespace thread
+	{
+		class WorkerPool
+		{
+		public:
+			typedef std::function<void()> Job;
+
+			//Shared pool, one worker per hardware thread less the calling thread. Created on first use.
+			static WorkerPool& Get();
+
+			WorkerPool(u32 numWorkers);
+			~WorkerPool();
+
+			u32 GetNumWorkers() const { return m_workers.size(); }
+
+			//Runs job on the calling thread and on up to numHelpers workers at once, returns when all have returned.
+			//Helpers still queued when the calling thread's run returns are dropped, so job must share out its
+			//own work (any number of concurrent runs must complete it). Safe to call from a worker thread.
+			void Run(u32 numHelpers, const Job& job);
+
+		private:
+			struct Dispatch;
+			class Worker;
+
+			bool TakeDispatch(Dispatch*& dispatch);
+
+			std::vector<Worker*> m_workers;
+
+			//Guards queue and shutdown flag
+			CriticalSection m_lock;
+
+			//Signalled once per queued helper, and once per worker on shutdown
+			Semaphore m_queueSemaphore;
+			std::deque<Dispatch*> m_queue;
+			bool m_shutdown;
+		};
+	}
+}
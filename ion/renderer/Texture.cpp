@@ -69,8 +69,16 @@ namespace ion
 
 		void Texture::Serialise(io::Archive& archive)
 		{
+			//Image data is only kept for writing, when reading it's uploaded straight from the archive's stream
+			io::Archive::View imageData;
+
 			archive.Serialise(m_imageFilename);
-			archive.Serialise(m_imageData);
+
+			if(archive.GetDirection() == io::Archive::Direction::In)
+				archive.Serialise(imageData);
+			else
+				archive.Serialise(m_imageData);
+
 			archive.Serialise(m_width);
 			archive.Serialise(m_height);
 			archive.Serialise((int&)m_sourceFormat);
@@ -79,7 +87,7 @@ namespace ion
 			if(archive.GetDirection() == io::Archive::Direction::In)
 			{
 				// TODO: serialise mipmaps and pixelbuffer
-				Load(m_width, m_height, m_sourceFormat, Format::RGBA, m_bitsPerPixel, false, false, m_imageData.data());
+				Load(m_width, m_height, m_sourceFormat, Format::RGBA, m_bitsPerPixel, false, false, imageData.GetData());
 			}
 		}
 	}
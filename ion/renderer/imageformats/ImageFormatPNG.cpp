@@ -3,6 +3,7 @@
 #if ION_RENDER_SUPPORTS_PNG
 
 #include "core/io/Stream.h"
+#include "core/io/MappedFileStream.h"
 #include "core/memory/Memory.h"
 #include <pngstruct.h>
 #include <pnginfo.h>
@@ -21,23 +22,18 @@ namespace ion
 
 	bool ImageFormatPNG::Read(const std::string& filename)
 	{
-		//Read file
-		ion::io::File pngFile(filename, ion::io::File::OpenMode::Read);
+		//Map file
+		ion::io::MappedFileStream pngFile(filename);
 		if (pngFile.IsOpen())
 		{
-			s64 pngSize = pngFile.GetSize();
-			png_byte* pngData = new png_byte[pngSize];
-			pngFile.Read(pngData, pngSize);
-
 			//Create new PNG reader
 			bool readError = false;
 			png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, &readError, ErrorHandlerPNG, NULL);
 			png_infop info_ptr = png_create_info_struct(png_ptr);
 			if (png_ptr && info_ptr)
 			{
-				//Setup stream reader
-				ion::io::MemoryStream stream(pngData, pngSize);
-				png_set_read_fn(png_ptr, &stream, MemoryReadPNG);
+				//Setup stream reader, reads straight from mapped file
+				png_set_read_fn(png_ptr, &pngFile, StreamReadPNG);
 
 				//Read PNG data
 				png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_STRIP_16 | PNG_TRANSFORM_PACKING, NULL);
@@ -79,7 +75,6 @@ namespace ion
 				png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
 			}
 
-			delete[] pngData;
 			return true;
 		}
 
@@ -44,9 +44,9 @@ namespace ion
 		virtual Colour GetPixel(int x, int y) const;
 
 	private:
-		static void MemoryReadPNG(png_structp png_ptr, png_bytep outBytes, png_size_t byteCountToRead)
+		static void StreamReadPNG(png_structp png_ptr, png_bytep outBytes, png_size_t byteCountToRead)
 		{
-			ion::io::MemoryStream* stream = (ion::io::MemoryStream*)png_get_io_ptr(png_ptr);
+			ion::io::Stream* stream = (ion::io::Stream*)png_get_io_ptr(png_ptr);
 			stream->Read(outBytes, byteCountToRead);
 		}
 
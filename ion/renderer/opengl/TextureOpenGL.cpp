@@ -22,6 +22,7 @@
 
 #if ION_RENDER_SUPPORTS_PNG
 #include "core/io/Stream.h"
+#include "core/io/MappedFileStream.h"
 #include <png.h>
 #endif
 
@@ -30,9 +31,9 @@ namespace ion
 	namespace render
 	{
 #if ION_RENDER_SUPPORTS_PNG
-		void MemoryReadPNG(png_structp png_ptr, png_bytep outBytes, png_size_t byteCountToRead)
+		void StreamReadPNG(png_structp png_ptr, png_bytep outBytes, png_size_t byteCountToRead)
 		{
-			ion::io::MemoryStream* stream = (ion::io::MemoryStream*)png_get_io_ptr(png_ptr);
+			ion::io::Stream* stream = (ion::io::Stream*)png_get_io_ptr(png_ptr);
 			stream->Read(outBytes, byteCountToRead);
 		}
 
@@ -163,23 +164,18 @@ namespace ion
 #if ION_RENDER_SUPPORTS_PNG
 			if (ion::string::EndsWith(ion::string::ToLower(m_imageFilename), ".png"))
 			{
-				//Read file
-				ion::io::File pngFile(m_imageFilename, ion::io::File::OpenMode::Read);
+				//Map file
+				ion::io::MappedFileStream pngFile(m_imageFilename);
 				if (pngFile.IsOpen())
 				{
-					s64 pngSize = pngFile.GetSize();
-					png_byte* pngData = new png_byte[pngSize];
-					pngFile.Read(pngData, pngSize);
-
 					//Create new PNG reader
 					bool readError = false;
 					png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, &readError, ErrorHandlerPNG, NULL);
 					png_infop info_ptr = png_create_info_struct(png_ptr);
 					if (png_ptr && info_ptr)
 					{
-						//Setup stream reader
-						ion::io::MemoryStream stream(pngData, pngSize);
-						png_set_read_fn(png_ptr, &stream, MemoryReadPNG);
+						//Setup stream reader, reads straight from mapped file
+						png_set_read_fn(png_ptr, &pngFile, StreamReadPNG);
 
 						//Read PNG data
 						png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_STRIP_16 | PNG_TRANSFORM_PACKING | PNG_TRANSFORM_EXPAND, NULL);
@@ -226,8 +222,6 @@ namespace ion
 						png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
 					}
 
-					delete[] pngData;
-
 					if (m_glTextureId != 0)
 					{
 						return true;
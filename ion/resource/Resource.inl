@@ -6,6 +6,7 @@
 #include "core/io/Archive.h"
 #include "resource/ResourceManager.h"
 #include "core/io/File.h"
+#include "core/io/MappedFileStream.h"
 
 namespace ion
 {
@@ -21,8 +22,8 @@ namespace ion
 			fullPath += m_filename;
 			fullPath += extension;
 
-			//Create and open scene file stream for reading
-			File file(fullPath, File::OpenMode::Read);
+			//Map file for reading, so large payloads can be read in place
+			MappedFileStream file(fullPath);
 
 			if (file.IsOpen())
 			{
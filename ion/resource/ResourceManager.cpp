@@ -16,26 +16,67 @@
 #include "core/thread/Atomic.h"
 #include "core/thread/Semaphore.h"
 
+#include <algorithm>
+
 namespace ion
 {
 	namespace io
 	{
-		ResourceManager::ResourceManager()
+		//Job semaphore is also signalled by cancelled jobs and shutdown, so has no meaningful limit
+		static const int s_maxSemaphoreCount = 0x7FFFFFFF;
+
+		ResourceManager::ResourceManager(u32 numWorkers)
+			: m_jobSemaphore(s_maxSemaphoreCount)
+			, m_queueSpaceSemaphore(s_maxSemaphoreCount)
+			, m_idleSemaphore(s_maxSemaphoreCount)
+			, m_jobEndedSemaphore(s_maxSemaphoreCount)
 		{
-			m_workerThread = new WorkerThread();
+			m_numQueuedJobs = 0;
+			m_numJobs = 0;
+			m_shuttingDown = false;
+			m_numBlockedRequests = 0;
+			m_numIdleWaiters = 0;
+			m_numJobEndedWaiters = 0;
 
 #if ION_RESOURCE_MGR_MULTITHREADED
-			m_workerThread->Run();
+			if(numWorkers == 0)
+			{
+				//Leave a hardware thread for the main thread
+				numWorkers = std::max(1u, thread::GetNumHardwareThreads() - 1);
+			}
+
+			for(u32 i = 0; i < numWorkers; i++)
+			{
+				WorkerThread* workerThread = new WorkerThread(*this);
+				m_workerThreads.push_back(workerThread);
+				workerThread->Run();
+			}
 #endif
 		}
 
 		ResourceManager::~ResourceManager()
 		{
-			delete m_workerThread;
+			//Workers finish all queued jobs before exiting
+			m_jobLock.Begin();
+			m_shuttingDown = true;
+			m_jobLock.End();
+
+			for(int i = 0; i < m_workerThreads.size(); i++)
+			{
+				m_jobSemaphore.Signal();
+			}
+
+			for(int i = 0; i < m_workerThreads.size(); i++)
+			{
+				m_workerThreads[i]->Join();
+				delete m_workerThreads[i];
+			}
 		}
 
 		void ResourceManager::RemoveResource(const std::string& filename)
 		{
+			m_resourceMapLock.Begin();
+
 			std::map<std::string, ResourceEntry*>::iterator it = m_resourceMap.find(filename);
 
 			if(it != m_resourceMap.end())
@@ -43,167 +84,413 @@ namespace ion
 				ion::debug::Assert(it->second->m_resource->GetResourceCount() == 0, "ResourceManager::RemoveResource() - Resource is still referenced");
 				m_resourceMap.erase(it);
 			}
+
+			m_resourceMapLock.End();
 		}
 
 		u32 ResourceManager::GetNumResourcesWaiting() const
 		{
-			return m_workerThread->GetNumJobsInQueue();
+			//Job count is guarded by job lock
+			m_jobLock.Begin();
+			u32 numJobs = m_numJobs;
+			m_jobLock.End();
+
+			return numJobs;
+		}
+
+		u32 ResourceManager::GetNumWorkers() const
+		{
+			return (u32)m_workerThreads.size();
 		}
 
 		void ResourceManager::WaitForResources()
 		{
 #if ION_RESOURCE_MGR_MULTITHREADED
-			m_workerThread->WaitForAllJobs();
+			m_jobLock.Begin();
+
+			if(m_numJobs > 0)
+			{
+				m_numIdleWaiters++;
+				m_jobLock.End();
+				m_idleSemaphore.Wait();
+			}
+			else
+			{
+				m_jobLock.End();
+			}
 #endif
 		}
 
-		void ResourceManager::RequestLoad(Resource& resource)
+		ResourceManager::ResourceEntry* ResourceManager::FindEntry(Resource& resource)
 		{
 			m_resourceMapLock.Begin();
 			std::map<std::string, ResourceEntry*>::iterator it = m_resourceMap.find(resource.GetFilename());
-			ion::debug::Assert(it != m_resourceMap.end(), "ResourceManager::RequestLoad() - resource does not exist");
+			ion::debug::Assert(it != m_resourceMap.end(), "ResourceManager::FindEntry() - resource does not exist");
+			ResourceEntry* resourceEntry = it->second;
 			m_resourceMapLock.End();
 
-#if ION_RESOURCE_MGR_MULTITHREADED
-			if(thread::GetCurrentThreadId() == m_workerThread->GetId())
-#endif
+			return resourceEntry;
+		}
+
+		bool ResourceManager::IsWorkerThread() const
+		{
+			for(int i = 0; i < m_workerThreads.size(); i++)
 			{
-				//Already on worker thread, do job immediately
-				it->second->m_resource->Load();
+				if(m_workerThreads[i]->IsCurrentThread())
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void ResourceManager::RequestLoad(Resource& resource)
+		{
+			ResourceEntry* resourceEntry = FindEntry(resource);
 
-				//Add to callback queue
 #if ION_RESOURCE_MGR_MULTITHREADED
-				m_workerThread->m_pendingOnLoaded.Push(it->second);
-#else
-				it->second->Broadcast_OnLoaded();
+			if(IsWorkerThread())
 #endif
+			{
+				//Already on worker thread (or single threaded), do job immediately
+				RunJobImmediate(*resourceEntry, JobType::Load);
 			}
 #if ION_RESOURCE_MGR_MULTITHREADED
 			else
 			{
-				//Push to job to worker thread
-				WorkerThread::Job job(WorkerThread::Job::JobType::Load, *it->second);
-				m_workerThread->PushJob(job);
+				m_jobLock.Begin();
+
+				if(resourceEntry->m_queuedJob == JobType::Unload)
+				{
+					//Unload hasn't started, resource is still loaded (or its load is still running)
+					CancelJob(*resourceEntry);
+
+					if(!resourceEntry->m_running)
+					{
+						QueueOnLoaded(resourceEntry);
+					}
+				}
+				else if(resourceEntry->m_queuedJob == JobType::None)
+				{
+					//Push job to workers
+					WaitForQueueSpace();
+					QueueJob(*resourceEntry, JobType::Load, resourceEntry->m_priority);
+				}
+
+				m_jobLock.End();
 			}
 #endif
 		}
 
 		void ResourceManager::RequestUnload(Resource& resource)
 		{
-			m_resourceMapLock.Begin();
-			std::map<std::string, ResourceEntry*>::iterator it = m_resourceMap.find(resource.GetFilename());
-			ion::debug::Assert(it != m_resourceMap.end(), "ResourceManager::RequestLoad() - resource does not exist");
-			m_resourceMapLock.End();
+			ResourceEntry* resourceEntry = FindEntry(resource);
 
 #if ION_RESOURCE_MGR_MULTITHREADED
-			if(thread::GetCurrentThreadId() == m_workerThread->GetId())
+			if(IsWorkerThread())
 #endif
 			{
-				//Already on worker thread, do job immediately
-				it->second->m_resource->Unload();
+				//Already on worker thread (or single threaded), do job immediately
+				RunJobImmediate(*resourceEntry, JobType::Unload);
 			}
 #if ION_RESOURCE_MGR_MULTITHREADED
 			else
 			{
-				//Push to job to worker thread
-				WorkerThread::Job job(WorkerThread::Job::JobType::Unload, *it->second);
-				m_workerThread->PushJob(job);
+				m_jobLock.Begin();
+
+				if(resourceEntry->m_queuedJob == JobType::Load)
+				{
+					//Handle released before load started, nothing to unload
+					CancelJob(*resourceEntry);
+				}
+				else if(resourceEntry->m_queuedJob == JobType::None)
+				{
+					//Push job to workers, unloads are cheap and free memory so go first
+					WaitForQueueSpace();
+					QueueJob(*resourceEntry, JobType::Unload, Priority::High);
+				}
+
+				m_jobLock.End();
 			}
 #endif
 		}
 
-		void ResourceManager::Update()
+		void ResourceManager::SetLoadPriority(ResourceEntry& resourceEntry, Priority priority)
 		{
-			while (!m_workerThread->m_pendingOnLoaded.IsEmpty())
+			m_jobLock.Begin();
+
+			if(priority > resourceEntry.m_priority)
 			{
-				ResourceEntry* resourceEntry = m_workerThread->m_pendingOnLoaded.Pop();
-				resourceEntry->Broadcast_OnLoaded();
+				resourceEntry.m_priority = priority;
+
+				if(resourceEntry.m_queuedJob == JobType::Load && priority > resourceEntry.m_queuedPriority)
+				{
+					if(!resourceEntry.m_deferred)
+					{
+						//Move to higher priority queue
+						std::deque<ResourceEntry*>& queue = m_jobQueues[(int)resourceEntry.m_queuedPriority];
+						queue.erase(std::find(queue.begin(), queue.end(), &resourceEntry));
+						m_jobQueues[(int)priority].push_back(&resourceEntry);
+					}
+
+					resourceEntry.m_queuedPriority = priority;
+				}
 			}
+
+			m_jobLock.End();
 		}
 
-		ResourceManager::WorkerThread::WorkerThread()
-			: thread::Thread("ResourceManagerWorker")
-			, m_jobQueueSemaphore(s_jobQueueSize)
-			, m_waitSemaphore(s_jobQueueSize)
+		void ResourceManager::WaitForQueueSpace()
+		{
+			while(m_numQueuedJobs >= s_maxQueuedJobs)
+			{
+				m_numBlockedRequests++;
+				m_jobLock.End();
+				m_queueSpaceSemaphore.Wait();
+				m_jobLock.Begin();
+			}
+		}
+
+		void ResourceManager::QueueJob(ResourceEntry& resourceEntry, JobType jobType, Priority priority)
+		{
+			resourceEntry.m_queuedJob = jobType;
+			resourceEntry.m_queuedPriority = priority;
+			m_jobQueues[(int)priority].push_back(&resourceEntry);
+
+			m_numQueuedJobs++;
+			m_numJobs++;
+			m_jobSemaphore.Signal();
+		}
+
+		void ResourceManager::CancelJob(ResourceEntry& resourceEntry)
+		{
+			if(resourceEntry.m_deferred)
+			{
+				//Already popped, waiting on running job
+				resourceEntry.m_deferred = false;
+			}
+			else
+			{
+				std::deque<ResourceEntry*>& queue = m_jobQueues[(int)resourceEntry.m_queuedPriority];
+				queue.erase(std::find(queue.begin(), queue.end(), &resourceEntry));
+			}
+
+			//Job semaphore stays signalled, a worker wakes to an empty queue and goes back to waiting
+			resourceEntry.m_queuedJob = JobType::None;
+			ReleaseQueueSlot();
+			FinishJob();
+		}
+
+		void ResourceManager::ReleaseQueueSlot()
 		{
-			m_numJobsInQueue = 0;
-			m_threadRunning = true;
+			m_numQueuedJobs--;
+
+			if(m_numBlockedRequests > 0)
+			{
+				m_numBlockedRequests--;
+				m_queueSpaceSemaphore.Signal();
+			}
 		}
 
-		ResourceManager::WorkerThread::~WorkerThread()
+		void ResourceManager::FinishJob()
 		{
-			Terminate();
+			m_numJobs--;
+
+			if(m_numJobs == 0)
+			{
+				while(m_numIdleWaiters > 0)
+				{
+					m_numIdleWaiters--;
+					m_idleSemaphore.Signal();
+				}
+			}
 		}
 
-		void ResourceManager::WorkerThread::PushJob(Job& job)
+		void ResourceManager::EndJob(ResourceEntry& resourceEntry)
 		{
-			m_jobQueue.Push(job);
-			thread::atomic::Increment(m_numJobsInQueue);
-			m_jobQueueSemaphore.Signal();
+			resourceEntry.m_running = false;
+
+			//Wake immediate jobs waiting on a running resource
+			while(m_numJobEndedWaiters > 0)
+			{
+				m_numJobEndedWaiters--;
+				m_jobEndedSemaphore.Signal();
+			}
+
+			if(resourceEntry.m_deferred)
+			{
+				//Requeue job popped while this one was running
+				resourceEntry.m_deferred = false;
+				m_jobQueues[(int)resourceEntry.m_queuedPriority].push_front(&resourceEntry);
+				m_jobSemaphore.Signal();
+			}
+
+			FinishJob();
 		}
 
-		u32 ResourceManager::WorkerThread::GetNumJobsInQueue() const
+		ResourceManager::ResourceEntry* ResourceManager::PopJob()
 		{
-			return m_numJobsInQueue;
+			for(int i = s_numPriorities - 1; i >= 0; i--)
+			{
+				if(!m_jobQueues[i].empty())
+				{
+					ResourceEntry* resourceEntry = m_jobQueues[i].front();
+					m_jobQueues[i].pop_front();
+					return resourceEntry;
+				}
+			}
+
+			return nullptr;
 		}
 
-		void ResourceManager::WorkerThread::WaitForAllJobs()
+		void ResourceManager::RunJob(ResourceEntry& resourceEntry, JobType jobType)
 		{
-			Job waitJob;
-			waitJob.m_jobType = Job::JobType::Wait;
-			PushJob(waitJob);
-			m_waitSemaphore.Wait();
+			if(jobType == JobType::Load)
+			{
+				//Load resource
+				resourceEntry.m_resource->Load();
+
+				//Add to callback queue
+#if ION_RESOURCE_MGR_MULTITHREADED
+				QueueOnLoaded(&resourceEntry);
+#else
+				resourceEntry.Broadcast_OnLoaded();
+#endif
+			}
+			else if(jobType == JobType::Unload)
+			{
+				//Unload resource
+				resourceEntry.m_resource->Unload();
+			}
 		}
 
-		void ResourceManager::WorkerThread::Terminate()
+		void ResourceManager::RunJobImmediate(ResourceEntry& resourceEntry, JobType jobType)
 		{
-			Job shutdownJob;
-			shutdownJob.m_jobType = Job::JobType::Shutdown;
-			PushJob(shutdownJob);
-			Join();
+			m_jobLock.Begin();
+
+			//Wait for another worker to finish with this resource, re-checking each time a job ends
+			while(resourceEntry.m_running)
+			{
+				m_numJobEndedWaiters++;
+				m_jobLock.End();
+				m_jobEndedSemaphore.Wait();
+				m_jobLock.Begin();
+			}
+
+			if(resourceEntry.m_queuedJob != JobType::None)
+			{
+				bool opposingJob = (resourceEntry.m_queuedJob != jobType);
+
+				//Take over queued job, or cancel out the opposite request
+				CancelJob(resourceEntry);
+
+				if(opposingJob)
+				{
+					if(jobType == JobType::Load)
+					{
+						//Still loaded
+						QueueOnLoaded(&resourceEntry);
+					}
+
+					m_jobLock.End();
+					return;
+				}
+			}
+
+			resourceEntry.m_running = true;
+			m_numJobs++;
+			m_jobLock.End();
+
+			RunJob(resourceEntry, jobType);
+
+			m_jobLock.Begin();
+			EndJob(resourceEntry);
+			m_jobLock.End();
 		}
 
-		void ResourceManager::WorkerThread::Entry()
+		void ResourceManager::ProcessJobs()
 		{
-			while(m_threadRunning)
+			while(true)
 			{
 				//Wait for job
-				m_jobQueueSemaphore.Wait();
+				m_jobSemaphore.Wait();
+
+				m_jobLock.Begin();
 
-				//Pop job from queue
-				Job job = m_jobQueue.Pop();
+				ResourceEntry* resourceEntry = PopJob();
 
-				switch (job.m_jobType)
+				if(!resourceEntry)
 				{
-					case Job::JobType::Load:
-					{
-						//Load resource
-						job.m_resourceEntry->m_resource->Load();
+					//Cancelled job or shutdown
+					bool shuttingDown = m_shuttingDown;
+					m_jobLock.End();
 
-						//Add to callback queue
-						m_pendingOnLoaded.Push(job.m_resourceEntry);
-						break;
-					}
-					case Job::JobType::Unload:
-					{
-						//Unload resource
-						job.m_resourceEntry->m_resource->Unload();
-						break;
-					}
-					case Job::JobType::Wait:
-					{
-						m_waitSemaphore.Signal();
-						break;
-					}
-					case Job::JobType::Shutdown:
-					{
-						m_threadRunning = false;
-						break;
-					}
+					if(shuttingDown)
+						return;
+					else
+						continue;
 				}
 
-				thread::atomic::Decrement(m_numJobsInQueue);
+				if(resourceEntry->m_running)
+				{
+					//Another worker is still running a job on this resource, requeue when it finishes
+					resourceEntry->m_deferred = true;
+					m_jobLock.End();
+					continue;
+				}
+
+				JobType jobType = resourceEntry->m_queuedJob;
+				resourceEntry->m_queuedJob = JobType::None;
+				resourceEntry->m_running = true;
+				ReleaseQueueSlot();
+
+				m_jobLock.End();
+
+				RunJob(*resourceEntry, jobType);
+
+				m_jobLock.Begin();
+				EndJob(*resourceEntry);
+				m_jobLock.End();
 			}
 		}
+
+		void ResourceManager::QueueOnLoaded(ResourceEntry* resourceEntry)
+		{
+			m_pendingOnLoadedLock.Begin();
+			m_pendingOnLoaded.push_back(resourceEntry);
+			m_pendingOnLoadedLock.End();
+		}
+
+		void ResourceManager::Update()
+		{
+			m_pendingOnLoadedLock.Begin();
+			std::vector<ResourceEntry*> pendingOnLoaded;
+			pendingOnLoaded.swap(m_pendingOnLoaded);
+			m_pendingOnLoadedLock.End();
+
+			for(int i = 0; i < pendingOnLoaded.size(); i++)
+			{
+				pendingOnLoaded[i]->Broadcast_OnLoaded();
+			}
+		}
+
+		ResourceManager::WorkerThread::WorkerThread(ResourceManager& resourceManager)
+			: thread::Thread("ResourceManagerWorker")
+			, m_resourceManager(resourceManager)
+		{
+			m_threadId = 0;
+		}
+
+		bool ResourceManager::WorkerThread::IsCurrentThread() const
+		{
+			return m_threadId == thread::GetCurrentThreadId();
+		}
+
+		void ResourceManager::WorkerThread::Entry()
+		{
+			m_threadId = thread::GetCurrentThreadId();
+			m_resourceManager.ProcessJobs();
+		}
 	}
-}
\ No newline at end of file
+}
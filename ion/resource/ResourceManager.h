@@ -18,10 +18,11 @@
 #include "core/thread/Thread.h"
 #include "core/thread/CriticalSection.h"
 #include "core/thread/Semaphore.h"
-#include "core/containers/Queue.h"
 #include "Resource.h"
 
+#include <atomic>
 #include <map>
+#include <deque>
 #include <string>
 #include <vector>
 #include <functional>
@@ -37,7 +38,16 @@ namespace ion
 		class ResourceManager
 		{
 		public:
-			ResourceManager();
+			//Load job priority, higher priority jobs are started first
+			enum class Priority
+			{
+				Low,
+				Normal,
+				High
+			};
+
+			//numWorkers = 0 to size worker pool to hardware thread count
+			ResourceManager(u32 numWorkers = 0);
 			~ResourceManager();
 
 			//Set/get resource directory
@@ -45,17 +55,20 @@ namespace ion
 			template <class T> std::string GetResourceDirectory() const;
 			template <class T> std::string GetResourceExtension() const;
 
-			//Get resource handle
-			template <class T> ResourceHandle<T> GetResource(const std::string& filename);
-			template <class T> ResourceHandle<T> GetResource(const std::string& filename, std::function<void(T&)> const& onLoaded);
+			//Get resource handle. Requesting a queued resource again at a higher priority promotes its load job.
+			template <class T> ResourceHandle<T> GetResource(const std::string& filename, Priority priority = Priority::Normal);
+			template <class T> ResourceHandle<T> GetResource(const std::string& filename, std::function<void(T&)> const& onLoaded, Priority priority = Priority::Normal);
 
 			//Manually add/remove resource
 			template <class T> ResourceHandle<T> AddResource(const std::string& filename, T& resourceObject);
 			void RemoveResource(const std::string& filename);
 
-			//Get number of resources in thread queue
+			//Get number of queued and in-progress load/unload jobs
 			u32 GetNumResourcesWaiting() const;
 
+			//Get number of worker threads
+			u32 GetNumWorkers() const;
+
 			//Wait for all resources
 			void WaitForResources();
 
@@ -63,67 +76,85 @@ namespace ion
 			void Update();
 
 		protected:
+			static const int s_numPriorities = (int)Priority::High + 1;
+
+			//Max queued jobs, requests block until workers catch up
+			static const int s_maxQueuedJobs = 1024;
+
+			enum class JobType { None, Load, Unload };
 
 			//Bookkeeping data
 			struct ResourceEntry
 			{
 				ResourceEntry(Resource* resource)
-					: m_resource(resource) {}
+					: m_resource(resource)
+				{
+					m_priority = Priority::Normal;
+					m_queuedPriority = Priority::Normal;
+					m_queuedJob = JobType::None;
+					m_running = false;
+					m_deferred = false;
+				}
 
 				virtual void Broadcast_OnLoaded() = 0;
 
 				Resource* m_resource;
+
+				//Job state, guarded by job lock. At most one job per resource is queued, and at most one runs at a time.
+				Priority m_priority;
+				Priority m_queuedPriority;
+				JobType m_queuedJob;
+				bool m_running;
+				bool m_deferred;
 			};
 
-			//Add load/unload requests to thread queue
+			//Add load/unload requests to job queue. Loads not yet started are cancelled by an unload request.
 			void RequestLoad(Resource& resource);
 			void RequestUnload(Resource& resource);
 
+			//Promote queued load job
+			void SetLoadPriority(ResourceEntry& resourceEntry, Priority priority);
+
 			//Thread worker
 			class WorkerThread : public thread::Thread
 			{
-			private:
-				static const int s_jobQueueSize = 1024;
-
 			public:
+				WorkerThread(ResourceManager& resourceManager);
 
-				struct Job
-				{
-					enum class JobType { Load, Unload, Wait, Shutdown };
+				//Running on this worker
+				bool IsCurrentThread() const;
 
-					Job() {}
-					Job(JobType jobType, ResourceEntry& resourceEntry)
-					{
-						m_jobType = jobType;
-						m_resourceEntry = &resourceEntry;
-					}
+			protected:
+				virtual void Entry();
 
-					JobType m_jobType;
-					ResourceEntry* m_resourceEntry;
-				};
+			private:
+				ResourceManager& m_resourceManager;
 
-				WorkerThread();
-				~WorkerThread();
+				//Set by worker on start, read by requesting threads
+				std::atomic<thread::ThreadId> m_threadId;
+			};
 
-				void PushJob(Job& job);
-				u32 GetNumJobsInQueue() const;
-				void WaitForAllJobs();
+			ResourceEntry* FindEntry(Resource& resource);
+			bool IsWorkerThread() const;
 
-				void Terminate();
+			//Job queue, call with job lock held
+			void WaitForQueueSpace();
+			void QueueJob(ResourceEntry& resourceEntry, JobType jobType, Priority priority);
+			void CancelJob(ResourceEntry& resourceEntry);
+			void ReleaseQueueSlot();
+			void EndJob(ResourceEntry& resourceEntry);
+			void FinishJob();
+			ResourceEntry* PopJob();
 
-				//Callbacks waiting on main thread
-				Queue<ResourceEntry*, s_jobQueueSize> m_pendingOnLoaded;
+			//Run job on calling worker thread
+			void RunJob(ResourceEntry& resourceEntry, JobType jobType);
+			void RunJobImmediate(ResourceEntry& resourceEntry, JobType jobType);
 
-			protected:
-				virtual void Entry();
+			//Worker loop
+			void ProcessJobs();
 
-			private:
-				Queue<Job, s_jobQueueSize> m_jobQueue;
-				thread::Semaphore m_jobQueueSemaphore;
-				thread::Semaphore m_waitSemaphore;
-				u32 m_numJobsInQueue;
-				bool m_threadRunning;
-			};
+			//Add to main thread callback list
+			void QueueOnLoaded(ResourceEntry* resourceEntry);
 
 			//Directories
 			struct DirectoryEntry
@@ -161,8 +192,32 @@ namespace ion
 			//Resources
 			std::map<std::string, ResourceEntry*> m_resourceMap;
 
-			//Worker thread
-			WorkerThread* m_workerThread;
+			//Worker threads
+			std::vector<WorkerThread*> m_workerThreads;
+
+			//Jobs by priority
+			std::deque<ResourceEntry*> m_jobQueues[s_numPriorities];
+			mutable thread::CriticalSection m_jobLock;
+			thread::Semaphore m_jobSemaphore;
+			u32 m_numQueuedJobs;
+			u32 m_numJobs;
+			bool m_shuttingDown;
+
+			//Back-pressure
+			thread::Semaphore m_queueSpaceSemaphore;
+			u32 m_numBlockedRequests;
+
+			//WaitForResources()
+			thread::Semaphore m_idleSemaphore;
+			u32 m_numIdleWaiters;
+
+			//RunJobImmediate() waiting for another worker's job on the same resource, woken as jobs end
+			thread::Semaphore m_jobEndedSemaphore;
+			u32 m_numJobEndedWaiters;
+
+			//Callbacks waiting on main thread
+			std::vector<ResourceEntry*> m_pendingOnLoaded;
+			thread::CriticalSection m_pendingOnLoadedLock;
 
 			//Resource map lock
 			ion::thread::CriticalSection m_resourceMapLock;
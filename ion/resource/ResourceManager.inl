@@ -57,7 +57,7 @@ namespace ion
 			return extension;
 		}
 
-		template <class T> ResourceHandle<T> ResourceManager::GetResource(const std::string& filename)
+		template <class T> ResourceHandle<T> ResourceManager::GetResource(const std::string& filename, Priority priority)
 		{
 			m_resourceMapLock.Begin();
 
@@ -70,11 +70,17 @@ namespace ion
 
 				//Create new bookkeeping entry
 				ResourceEntryT<T>* resourceEntry = new ResourceEntryT<T>(resource);
+				resourceEntry->m_priority = priority;
 
 				//Add to map
 				std::pair<std::map<std::string, ResourceEntry*>::iterator, bool> result = m_resourceMap.insert(std::pair<std::string, ResourceEntry*>(filename, resourceEntry));
 				it = result.first;
 			}
+			else
+			{
+				//Resource exists, promote if still queued
+				SetLoadPriority(*it->second, priority);
+			}
 
 			m_resourceMapLock.End();
 
@@ -82,7 +88,7 @@ namespace ion
 			return ResourceHandle<T>((ResourceT<T>*)it->second->m_resource);
 		}
 
-		template <class T> ResourceHandle<T> ResourceManager::GetResource(const std::string& filename, std::function<void(T&)> const& onLoaded)
+		template <class T> ResourceHandle<T> ResourceManager::GetResource(const std::string& filename, std::function<void(T&)> const& onLoaded, Priority priority)
 		{
 			m_resourceMapLock.Begin();
 
@@ -97,6 +103,7 @@ namespace ion
 
 				//Create new bookkeeping entry
 				resourceEntry = new ResourceEntryT<T>(resource);
+				resourceEntry->m_priority = priority;
 
 				//Add to map
 				std::pair<std::map<std::string, ResourceEntry*>::iterator, bool> result = m_resourceMap.insert(std::pair<std::string, ResourceEntry*>(filename, resourceEntry));
@@ -115,12 +122,18 @@ namespace ion
 				if(onLoaded)
 					resourceEntry->Subscribe_OnLoaded(onLoaded);
 
-				//Add to callback queue
+				//Resource exists, promote if still queued
+				SetLoadPriority(*resourceEntry, priority);
+
+				//If already loaded, add to callback queue, otherwise called when load completes
+				if(resourceEntry->m_resource->IsLoaded())
+				{
 #if ION_RESOURCE_MGR_MULTITHREADED
-				m_workerThread->m_pendingOnLoaded.Push(it->second);
+					QueueOnLoaded(resourceEntry);
 #else
-				it->second->Broadcast_OnLoaded();
+					resourceEntry->Broadcast_OnLoaded();
 #endif
+				}
 			}
 
 			m_resourceMapLock.End();
@@ -0,0 +1,148 @@
+#include <core/Types.h>
+#include <core/io/Archive.h>
+#include <core/io/Stream.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+//Archive round trips through a MemoryStream: each write mode, format version and codec, and out of order block lookup
+
+struct TestObject
+{
+	TestObject()
+	{
+		m_int = 0;
+		m_float = 0.0f;
+		m_bool = false;
+		m_u64 = 0;
+	}
+
+	void Fill(int seed)
+	{
+		m_int = -seed * 7;
+		m_float = (float)seed * 0.25f;
+		m_bool = (seed & 1) != 0;
+		m_u64 = 0x0123456789ABCDEFull + seed;
+		m_string = "string" + std::to_string(seed);
+
+		for(int i = 0; i < 300; i++)
+		{
+			m_words.push_back((u16)(i * seed));
+			m_strings.push_back(std::string(i % 17, (char)('a' + (i % 26))));
+			m_map[i * 3] = std::to_string(i);
+		}
+	}
+
+	bool operator == (const TestObject& rhs) const
+	{
+		return m_int == rhs.m_int && m_float == rhs.m_float && m_bool == rhs.m_bool && m_u64 == rhs.m_u64
+			&& m_string == rhs.m_string && m_words == rhs.m_words && m_strings == rhs.m_strings && m_map == rhs.m_map;
+	}
+
+	void Serialise(ion::io::Archive& archive)
+	{
+		archive.Serialise(m_int, "int");
+		archive.Serialise(m_float, "float");
+		archive.Serialise(m_bool, "bool");
+		archive.Serialise(m_u64, "u64");
+		archive.Serialise(m_string, "string");
+		archive.Serialise(m_words, "words");
+		archive.Serialise(m_strings, "strings");
+		archive.Serialise(m_map, "map");
+	}
+
+	int m_int;
+	float m_float;
+	bool m_bool;
+	u64 m_u64;
+	std::string m_string;
+	std::vector<u16> m_words;
+	std::vector<std::string> m_strings;
+	std::map<int, std::string> m_map;
+};
+
+struct Config
+{
+	const char* name;
+	ion::io::Archive::WriteMode writeMode;
+	u32 formatVersion;
+	bool compressed;
+	ion::io::CompressedStream::Codec codec;
+};
+
+static bool RunRoundTrip(const Config& config)
+{
+	TestObject first;
+	TestObject second;
+	first.Fill(3);
+	second.Fill(8);
+
+	ion::io::MemoryStream stream;
+
+	{
+		ion::io::Archive archive(stream, ion::io::Archive::Direction::Out);
+		archive.SetFormatVersion(config.formatVersion);
+		archive.SetWriteMode(config.writeMode);
+
+		if(config.compressed)
+		{
+			archive.SetCompression(config.codec);
+		}
+
+		archive.Serialise(first, "first");
+		archive.Serialise(second, "second");
+	}
+
+	stream.Seek(0, ion::io::SeekMode::Start);
+
+	//Read back in reverse order, blocks are found by tag
+	TestObject secondIn;
+	TestObject firstIn;
+
+	{
+		ion::io::Archive archive(stream, ion::io::Archive::Direction::In);
+		archive.Serialise(secondIn, "second");
+		archive.Serialise(firstIn, "first");
+	}
+
+	bool passed = (firstIn == first) && (secondIn == second);
+	printf("%-24s %8u bytes  %s\n", config.name, (u32)stream.GetSize(), passed ? "OK" : "FAILED");
+	return passed;
+}
+
+static bool RunTagTests()
+{
+	//Literal tags hash at compile time, runtime strings must produce the same hash
+	std::string runtimeName = "someFieldName";
+	ion::io::Archive::Tag literalTag("someFieldName");
+	ion::io::Archive::Tag runtimeTag(runtimeName.c_str());
+
+	bool passed = (literalTag == runtimeTag) && (literalTag != ion::io::Archive::Tag("otherFieldName"));
+	printf("%-24s %8s        %s\n", "Tag literal/runtime", "", passed ? "OK" : "FAILED");
+	return passed;
+}
+
+int main(int numargs, char** args)
+{
+	const Config configs[] =
+	{
+		{ "Buffered",			ion::io::Archive::WriteMode::Buffered,	ion::io::Archive::FormatVersionCurrent,		false,	ion::io::CompressedStream::Codec::LZ },
+		{ "Streaming",			ion::io::Archive::WriteMode::Streaming,	ion::io::Archive::FormatVersionCurrent,		false,	ion::io::CompressedStream::Codec::LZ },
+		{ "Legacy format",		ion::io::Archive::WriteMode::Buffered,	ion::io::Archive::FormatVersionLegacy,		false,	ion::io::CompressedStream::Codec::LZ },
+		{ "Block index format",	ion::io::Archive::WriteMode::Buffered,	ion::io::Archive::FormatVersionBlockIndex,	false,	ion::io::CompressedStream::Codec::LZ },
+		{ "LZ",					ion::io::Archive::WriteMode::Buffered,	ion::io::Archive::FormatVersionCurrent,		true,	ion::io::CompressedStream::Codec::LZ },
+		{ "LZHigh",				ion::io::Archive::WriteMode::Buffered,	ion::io::Archive::FormatVersionCurrent,		true,	ion::io::CompressedStream::Codec::LZHigh },
+	};
+
+	bool passed = RunTagTests();
+
+	for(int i = 0; i < sizeof(configs) / sizeof(configs[0]); i++)
+	{
+		passed &= RunRoundTrip(configs[i]);
+	}
+
+	printf(passed ? "All archive tests passed\n" : "Archive tests FAILED\n");
+	return passed ? 0 : 1;
+}
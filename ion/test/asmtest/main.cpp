@@ -0,0 +1,91 @@
+#include <core/Types.h>
+#include <core/io/AsmEmitter.h>
+#include <core/time/Time.h>
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+//Rows of dc.w map data, as Map::Export() writes them
+static const int s_mapWidth = 256;
+static const int s_mapHeight = 256;
+
+static void ExportStringStream(const std::vector<u16>& words, std::stringstream& stream)
+{
+	stream << std::hex << std::setfill('0') << std::uppercase;
+
+	for(int y = 0; y < s_mapHeight; y++)
+	{
+		stream << "\tdc.w\t";
+
+		for(int x = 0; x < s_mapWidth; x++)
+		{
+			stream << "0x" << std::setw(4) << words[(y * s_mapWidth) + x];
+
+			if(x < (s_mapWidth - 1))
+				stream << ",";
+		}
+
+		stream << std::endl;
+	}
+
+	stream << std::dec;
+}
+
+static void ExportEmitter(const std::vector<u16>& words, std::stringstream& stream)
+{
+	ion::io::AsmEmitter emitter(stream);
+
+	for(int y = 0; y < s_mapHeight; y++)
+	{
+		emitter.DcW(&words[y * s_mapWidth], s_mapWidth);
+	}
+}
+
+template <typename EXPORT_FUNC> double MeasureThroughput(const std::vector<u16>& words, std::string& output, EXPORT_FUNC exportFunc)
+{
+	const int numPasses = 16;
+	u64 numBytes = 0;
+
+	u64 startTicks = ion::time::GetSystemTicks();
+
+	for(int pass = 0; pass < numPasses; pass++)
+	{
+		std::stringstream stream;
+		exportFunc(words, stream);
+		output = stream.str();
+		numBytes += output.size();
+	}
+
+	u64 endTicks = ion::time::GetSystemTicks();
+
+	double seconds = ion::time::TicksToSeconds(endTicks - startTicks);
+	double megabytes = (double)numBytes / (1024.0 * 1024.0);
+	return (seconds > 0.0) ? (megabytes / seconds) : 0.0;
+}
+
+int main(int numargs, char** args)
+{
+	std::vector<u16> words(s_mapWidth * s_mapHeight);
+	u32 seed = 12345;
+	for(int i = 0; i < words.size(); i++)
+	{
+		seed = (seed * 1103515245) + 12345;
+		words[i] = (u16)(seed >> 16);
+	}
+
+	std::string streamOutput;
+	std::string emitterOutput;
+
+	double streamRate = MeasureThroughput(words, streamOutput, ExportStringStream);
+	double emitterRate = MeasureThroughput(words, emitterOutput, ExportEmitter);
+
+	printf("stringstream\tAsmEmitter\t(MB/sec)\n");
+	printf("%.0f\t\t%.0f\n", streamRate, emitterRate);
+
+	bool outputsMatch = (streamOutput == emitterOutput);
+	printf("AsmEmitter matches stringstream: %s\n", outputsMatch ? "OK" : "FAILED");
+
+	return outputsMatch ? 0 : 1;
+}
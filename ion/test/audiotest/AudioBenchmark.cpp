@@ -0,0 +1,431 @@
+#include "AudioBenchmark.h"
+
+#include <core/Types.h>
+#include <core/io/File.h>
+#include <core/thread/Sleep.h>
+#include <core/time/Time.h>
+#include <audio/EffectFader.h>
+#include <audio/FileReaderOGG.h>
+#include <audio/FileReaderWAV.h>
+#include <audio/FileSource.h>
+#include <audio/Mixer.h>
+#include <audio/Voice.h>
+#include <audio/null/EngineNull.h>
+#include <audio/null/OutputDeviceNull.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static const char* s_testFilename = "audiobenchmark_test.wav";
+static const char* s_oneShotFilename = "audiobenchmark_oneshot.wav";
+static const u32 s_sampleRate = 48000;
+static const u32 s_testFileSeconds = 20;
+
+//2.5 s, ends part way through the second stream buffer
+static const u32 s_oneShotFrames = (s_sampleRate * 5) / 2;
+static const u32 s_mixSeconds = 10;
+static const u32 s_streamSeconds = 5;
+static const u32 s_decodeChunkSize = 1024 * 256;
+static const int s_numSeeks = 100;
+static const u32 s_dspVoices = 64;
+
+//Stereo 16 bit sine sweep
+static bool WriteTestWAV(const char* filename, u32 numFrames)
+{
+	std::vector<s16> samples(numFrames * 2);
+
+	for(u32 i = 0; i < numFrames; i++)
+	{
+		float t = (float)i / (float)s_sampleRate;
+		float frequency = 220.0f + (t * 20.0f);
+		samples[(i * 2)] = (s16)(sinf(t * frequency * 6.2831853f) * 8192.0f);
+		samples[(i * 2) + 1] = (s16)(sinf(t * frequency * 6.2831853f * 1.5f) * 8192.0f);
+	}
+
+	ion::io::File file;
+	if(!file.Open(filename, ion::io::File::OpenMode::Write))
+		return false;
+
+	ion::audio::WaveHeader waveHeader = { 0 };
+	waveHeader.format = 1;
+	waveHeader.numChannels = 2;
+	waveHeader.samplesPerSec = s_sampleRate;
+	waveHeader.blockSize = 2 * sizeof(s16);
+	waveHeader.bytesPerSec = s_sampleRate * waveHeader.blockSize;
+	waveHeader.bitsPerSample = 16;
+
+	const u32 fmtSize = 16;
+	const u32 dataSize = numFrames * waveHeader.blockSize;
+	const u32 riffSize = 4 + (8 + fmtSize) + (8 + dataSize);
+
+	file.Write("RIFF", 4);
+	file.Write(&riffSize, 4);
+	file.Write("WAVE", 4);
+	file.Write("fmt ", 4);
+	file.Write(&fmtSize, 4);
+	file.Write(&waveHeader, fmtSize);
+	file.Write("data", 4);
+	file.Write(&dataSize, 4);
+	file.Write(samples.data(), dataSize);
+	file.Close();
+
+	return true;
+}
+
+static bool BenchmarkVoices(u32 numVoices)
+{
+	ion::audio::EngineNull engine(s_sampleRate);
+	ion::audio::OutputDeviceNull& device = engine.GetOutputDevice();
+
+	ion::audio::FileReaderWAV reader(s_testFilename);
+	ion::audio::FileSource source(ion::audio::Source::FeedType::SingleBuffer, reader, true);
+
+	if(!source.Load())
+	{
+		printf("Could not load %s\n", s_testFilename);
+		return false;
+	}
+
+	std::vector<ion::audio::Voice*> voices;
+	for(u32 i = 0; i < numVoices; i++)
+	{
+		ion::audio::Voice* voice = engine.CreateVoice(source, true);
+		voice->SetVolume(1.0f / (float)numVoices);
+		voice->SetPan((numVoices > 1) ? (((float)i / (float)(numVoices - 1)) * 2.0f) - 1.0f : 0.0f);
+		voice->Play();
+		voices.push_back(voice);
+	}
+
+	device.Render(s_sampleRate * s_mixSeconds);
+
+	double mixSeconds = device.GetMixTime();
+	double voiceSeconds = device.GetVirtualTime() * (double)numVoices;
+	double voicesPerSecond = (mixSeconds > 0.0) ? (voiceSeconds / mixSeconds) : 0.0;
+
+	//Voice-seconds mixed per second of mixing, i.e. how many voices would fit in real-time
+	printf("%4u voices: %8.3f ms mixing %.1f s, %10.1f voices mixed per second, %u starved blocks\n",
+		numVoices, mixSeconds * 1000.0, device.GetVirtualTime(), voicesPerSecond, engine.GetMixer()->GetStarvationCount());
+
+	for(int i = 0; i < voices.size(); i++)
+	{
+		engine.ReleaseVoice(*voices[i]);
+	}
+
+	source.CloseStream(nullptr);
+	return true;
+}
+
+//Per voice DSP stages to enable
+enum DSPFlags
+{
+	DSPPitch = (1 << 0),
+	DSPGainRamp = (1 << 1),
+	DSPFader = (1 << 2),
+};
+
+static bool BenchmarkVoiceDSP(const char* name, u32 flags)
+{
+	ion::audio::EngineNull engine(s_sampleRate);
+	ion::audio::OutputDeviceNull& device = engine.GetOutputDevice();
+
+	ion::audio::FileReaderWAV reader(s_testFilename);
+	ion::audio::FileSource source(ion::audio::Source::FeedType::SingleBuffer, reader, true);
+
+	if(!source.Load())
+	{
+		printf("Could not load %s\n", s_testFilename);
+		return false;
+	}
+
+	std::vector<ion::audio::Voice*> voices;
+	for(u32 i = 0; i < s_dspVoices; i++)
+	{
+		ion::audio::Voice* voice = engine.CreateVoice(source, true);
+		voice->SetVolume(1.0f / (float)s_dspVoices);
+
+		if(flags & DSPPitch)
+		{
+			//Not a whole frame step, every output frame is interpolated
+			voice->SetPitch(1.07f);
+		}
+
+		if(flags & DSPFader)
+		{
+			//Fades for the whole run, ramping every block
+			voice->CreateEffect<ion::audio::EffectFader>()->FadeIn(1.0f / (float)(s_mixSeconds * 2));
+		}
+
+		voice->Play();
+		voices.push_back(voice);
+	}
+
+	//One device block per render, so volume changes land on every device block
+	for(u32 block = 0; device.GetFramesRendered() < (s_sampleRate * s_mixSeconds); block++)
+	{
+		if(flags & DSPGainRamp)
+		{
+			for(int i = 0; i < voices.size(); i++)
+			{
+				voices[i]->SetVolume(((block & 1) ? 0.5f : 1.0f) / (float)s_dspVoices);
+			}
+		}
+
+		device.Render(ion::audio::Mixer::s_blockFrames);
+	}
+
+	//Wall clock cost of one voice for one second of output, and the share of a core it takes
+	double voiceSeconds = device.GetVirtualTime() * (double)s_dspVoices;
+	double costPerVoiceSecond = (voiceSeconds > 0.0) ? (device.GetMixTime() / voiceSeconds) : 0.0;
+
+	printf("%-10s: %8.3f ms mixing %u voices for %.1f s, %7.2f us per voice-second (%.4f%% of a core), %u starved blocks\n",
+		name, device.GetMixTime() * 1000.0, s_dspVoices, device.GetVirtualTime(), costPerVoiceSecond * 1000000.0, costPerVoiceSecond * 100.0,
+		engine.GetMixer()->GetStarvationCount());
+
+	for(int i = 0; i < voices.size(); i++)
+	{
+		engine.ReleaseVoice(*voices[i]);
+	}
+
+	source.CloseStream(nullptr);
+	return true;
+}
+
+static bool BenchmarkStreaming(ion::audio::FileReader& reader, int decodeAhead, ion::audio::OutputDeviceNull::Pacing pacing, const char* outputWAV)
+{
+	ion::audio::EngineNull engine(s_sampleRate);
+	ion::audio::OutputDeviceNull& device = engine.GetOutputDevice();
+
+	ion::audio::FileSource source(ion::audio::Source::FeedType::Streaming, reader, true);
+	source.SetDecodeAhead(decodeAhead, ion::audio::FileSource::s_defaultStreamBufferSize);
+
+	std::atomic<bool> opened(false);
+	std::atomic<bool> closed(false);
+	std::atomic<bool> openResult(false);
+
+	source.OpenStream([&](ion::audio::Source& source, bool success) { openResult = success; opened = true; });
+
+	while(!opened)
+	{
+		ion::thread::Sleep(1);
+	}
+
+	if(!openResult)
+	{
+		printf("Could not open stream %s\n", reader.GetFilename().c_str());
+		return false;
+	}
+
+	if(outputWAV)
+	{
+		device.OpenWAV(outputWAV);
+	}
+
+	ion::audio::Voice* voice = engine.CreateVoice(source, true);
+	voice->Play();
+
+	const char* pacingName = "";
+
+	if(pacing == ion::audio::OutputDeviceNull::Pacing::RealTime)
+	{
+		pacingName = "real-time";
+		device.Start(pacing);
+		ion::thread::Sleep(s_streamSeconds * 1000);
+		device.Stop();
+	}
+	else
+	{
+		pacingName = "offline";
+		device.Render(s_sampleRate * s_streamSeconds);
+	}
+
+	device.CloseWAV();
+
+	printf("Streaming %-9s: %.1f s rendered in %8.3f ms mixing, %d buffers decode-ahead, %u stream buffers starved, %u starved blocks\n",
+		pacingName, device.GetVirtualTime(), device.GetMixTime() * 1000.0, decodeAhead, source.GetStarvationCount(), engine.GetMixer()->GetStarvationCount());
+
+	engine.ReleaseVoice(*voice);
+
+	source.CloseStream([&](ion::audio::Source& source, bool success) { closed = true; });
+
+	while(!closed)
+	{
+		ion::thread::Sleep(1);
+	}
+
+	return true;
+}
+
+//Non-looping stream must stop once played to the end, and not replay stale buffers
+static bool BenchmarkStreamingOneShot(ion::audio::FileReader& reader)
+{
+	ion::audio::EngineNull engine(s_sampleRate);
+	ion::audio::OutputDeviceNull& device = engine.GetOutputDevice();
+
+	ion::audio::FileSource source(ion::audio::Source::FeedType::Streaming, reader, false);
+
+	std::atomic<bool> opened(false);
+	std::atomic<bool> closed(false);
+	std::atomic<bool> openResult(false);
+
+	source.OpenStream([&](ion::audio::Source& source, bool success) { openResult = success; opened = true; });
+
+	while(!opened)
+	{
+		ion::thread::Sleep(1);
+	}
+
+	if(!openResult)
+	{
+		printf("Could not open stream %s\n", reader.GetFilename().c_str());
+		return false;
+	}
+
+	ion::audio::Voice* voice = engine.CreateVoice(source, false);
+	voice->Play();
+
+	//Render in 10 ms steps until the voice stops
+	const u32 stepFrames = s_sampleRate / 100;
+	const u64 maxFrames = (u64)s_sampleRate * s_streamSeconds;
+
+	while(voice->GetState() == ion::audio::Voice::State::Playing && device.GetFramesRendered() < maxFrames)
+	{
+		device.Render(stepFrames);
+	}
+
+	const double fileSeconds = (double)s_oneShotFrames / (double)s_sampleRate;
+	const double stopSeconds = device.GetVirtualTime();
+	const bool stopped = (voice->GetState() == ion::audio::Voice::State::Stopped) && (stopSeconds >= fileSeconds);
+
+	printf("Streaming one-shot: %.2f s stream stopped at %.2f s, %u stream buffers starved, %u starved blocks %s\n",
+		fileSeconds, stopSeconds, source.GetStarvationCount(), engine.GetMixer()->GetStarvationCount(), stopped ? "OK" : "FAILED");
+
+	engine.ReleaseVoice(*voice);
+
+	source.CloseStream([&](ion::audio::Source& source, bool success) { closed = true; });
+
+	while(!closed)
+	{
+		ion::thread::Sleep(1);
+	}
+
+	return stopped;
+}
+
+int RunAudioBenchmark(const char* outputWAV)
+{
+	if(!WriteTestWAV(s_testFilename, s_sampleRate * s_testFileSeconds) || !WriteTestWAV(s_oneShotFilename, s_oneShotFrames))
+	{
+		printf("Could not write test WAVs\n");
+		return 1;
+	}
+
+	printf("Mixing looping single buffer voices, %u Hz, %u s virtual time\n", s_sampleRate, s_mixSeconds);
+
+	const u32 voiceCounts[] = { 1, 16, 64, 128 };
+	for(int i = 0; i < sizeof(voiceCounts) / sizeof(voiceCounts[0]); i++)
+	{
+		if(!BenchmarkVoices(voiceCounts[i]))
+			return 1;
+	}
+
+	printf("Per voice DSP cost, %u voices\n", s_dspVoices);
+
+	if(!BenchmarkVoiceDSP("unity", 0)
+		|| !BenchmarkVoiceDSP("pitch", DSPPitch)
+		|| !BenchmarkVoiceDSP("gain ramp", DSPGainRamp)
+		|| !BenchmarkVoiceDSP("fader", DSPFader)
+		|| !BenchmarkVoiceDSP("all", DSPPitch | DSPGainRamp | DSPFader))
+		return 1;
+
+	printf("Streaming one looping FileSource, %u s\n", s_streamSeconds);
+
+	ion::audio::FileReaderWAV reader(s_testFilename);
+
+	if(!BenchmarkStreaming(reader, ion::audio::FileSource::s_defaultStreamBuffers, ion::audio::OutputDeviceNull::Pacing::RealTime, nullptr))
+		return 1;
+
+	if(!BenchmarkStreaming(reader, ion::audio::FileSource::s_defaultStreamBuffers, ion::audio::OutputDeviceNull::Pacing::Offline, outputWAV))
+		return 1;
+
+	ion::audio::FileReaderWAV oneShotReader(s_oneShotFilename);
+
+	if(!BenchmarkStreamingOneShot(oneShotReader))
+		return 1;
+
+	if(outputWAV)
+	{
+		printf("Wrote %s\n", outputWAV);
+	}
+
+	return 0;
+}
+
+int RunDecodeBenchmark(const char* oggFilename, int decodeAhead)
+{
+	ion::audio::FileReaderOGG reader(oggFilename);
+
+	if(!reader.Open())
+	{
+		printf("Could not open %s\n", oggFilename);
+		return 1;
+	}
+
+	const ion::audio::StreamDesc& streamDesc = reader.GetStreamDesc();
+	const double durationSeconds = (double)streamDesc.GetSizeSamples() / (double)streamDesc.GetSampleRate();
+
+	printf("%s: %u channels, %u Hz, %.1f s\n", oggFilename, streamDesc.GetNumChannels(), streamDesc.GetSampleRate(), durationSeconds);
+
+	//Whole file, in stream buffer sized reads
+	std::vector<char> chunk(s_decodeChunkSize);
+	u32 decodedBytes = 0;
+	u32 bytesRead = 0;
+
+	u64 startTicks = ion::time::GetSystemTicks();
+
+	while((bytesRead = reader.Read(chunk.data(), s_decodeChunkSize)) > 0)
+	{
+		decodedBytes += bytesRead;
+	}
+
+	double decodeSeconds = ion::time::TicksToSeconds(ion::time::GetSystemTicks() - startTicks);
+
+	if(decodedBytes != streamDesc.GetDecodedSizeBytes())
+	{
+		printf("Decoded %u bytes, expected %u\n", decodedBytes, streamDesc.GetDecodedSizeBytes());
+		return 1;
+	}
+
+	//Streaming reads encoded bytes from disk, where a WAV would read decoded bytes
+	printf("Decode: %8.3f ms, %.1fx real-time, %.2f MB/s decoded\n",
+		decodeSeconds * 1000.0, (decodeSeconds > 0.0) ? (durationSeconds / decodeSeconds) : 0.0, ((double)decodedBytes / (1024.0 * 1024.0)) / decodeSeconds);
+	printf("I/O: %u bytes encoded, %u bytes decoded, %.1f%% of WAV bandwidth (%.1f KB/s vs %.1f KB/s)\n",
+		streamDesc.GetEncodedSizeBytes(), decodedBytes, ((double)streamDesc.GetEncodedSizeBytes() * 100.0) / (double)decodedBytes,
+		((double)streamDesc.GetEncodedSizeBytes() / 1024.0) / durationSeconds, ((double)decodedBytes / 1024.0) / durationSeconds);
+
+	//Random sample accurate seeks, each followed by one buffer of decoding
+	u32 seed = 1;
+	startTicks = ion::time::GetSystemTicks();
+
+	for(int i = 0; i < s_numSeeks; i++)
+	{
+		seed = (seed * 1103515245) + 12345;
+		reader.SeekSample((seed >> 8) % streamDesc.GetSizeSamples());
+		reader.Read(chunk.data(), 4096 * streamDesc.GetBlockSize());
+	}
+
+	double seekSeconds = ion::time::TicksToSeconds(ion::time::GetSystemTicks() - startTicks);
+	printf("Seek: %.3f ms average, including first 4096 frames\n", (seekSeconds * 1000.0) / (double)s_numSeeks);
+
+	reader.Close();
+
+	//Mixer voices play mono and stereo. Real-time only, offline rendering would outrun any decoder.
+	if(streamDesc.GetNumChannels() <= 2)
+	{
+		if(!BenchmarkStreaming(reader, decodeAhead, ion::audio::OutputDeviceNull::Pacing::RealTime, nullptr))
+			return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+//Mixes voices through the null audio backend and reports throughput, per voice DSP cost (resampling, gain ramps, effects),
+//streaming starvation, and that a non-looping stream stops at its end.
+//Optionally records the streaming pass to outputWAV. Returns 0 on success.
+int RunAudioBenchmark(const char* outputWAV);
+
+
+//Decodes an Ogg Vorbis file and reports decode speed, I/O bandwidth against the equivalent WAV,
+//seek cost, and streaming starvation with decodeAhead stream buffers. Returns 0 on success.
+int RunDecodeBenchmark(const char* oggFilename, int decodeAhead);
@@ -18,7 +18,7 @@ bool AudioTest::Initialise()
 	mAudioEngine = ion::audio::Engine::Create();
 
 	ion::audio::FileReaderWAV wavReader("..\\audio\\test.wav");
-	ion::audio::FileSource source(ion::audio::Source::SingleBuffer, wavReader);
+	ion::audio::FileSource source(ion::audio::Source::FeedType::SingleBuffer, wavReader, false);
 
 	if(source.Load())
 	{
@@ -27,14 +27,14 @@ bool AudioTest::Initialise()
 		{
 			voice->Play();
 
-			while(voice->GetState() == ion::audio::Voice::Playing)
+			while(voice->GetState() == ion::audio::Voice::State::Playing)
 			{
 			}
 
 			mAudioEngine->ReleaseVoice(*voice);
 		}
 
-		source.CloseStream();
+		source.CloseStream(nullptr);
 	}
 
 	return true;
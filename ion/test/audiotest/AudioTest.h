@@ -1,5 +1,4 @@
 #include <core/bootstrap/Application.h>
-#include <core/Version.h>
 #include <core/time/Time.h>
 #include <audio/Engine.h>
 #include <audio/FileSource.h>
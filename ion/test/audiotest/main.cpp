@@ -1,8 +1,25 @@
 #include "AudioTest.h"
+#include "AudioBenchmark.h"
 #include "core/time/Time.h"
+#include "audio/FileSource.h"
 
-int main(char** args, int numargs)
+#include <cstdlib>
+#include <cstring>
+
+int main(int numargs, char** args)
 {
+	//audiotest -benchmark [output.wav]
+	if(numargs > 1 && strcmp(args[1], "-benchmark") == 0)
+	{
+		return RunAudioBenchmark((numargs > 2) ? args[2] : nullptr);
+	}
+
+	//audiotest -decodebenchmark file.ogg [decode-ahead buffers]
+	if(numargs > 2 && strcmp(args[1], "-decodebenchmark") == 0)
+	{
+		return RunDecodeBenchmark(args[2], (numargs > 3) ? atoi(args[3]) : ion::audio::FileSource::s_defaultStreamBuffers);
+	}
+
 	AudioTest app;
 	
 	if(app.Initialise())
@@ -24,4 +41,6 @@ int main(char** args, int numargs)
 
 		app.Shutdown();
 	}
-}
\ No newline at end of file
+
+	return 0;
+}
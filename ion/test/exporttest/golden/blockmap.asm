@@ -0,0 +1,27 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+map_blockmap_Unnamed_copy_copy:
+
+Block_Map:
+	dc.w	0x0000,0x0001,0x0002,0x0001,0x0002,0x0001,0x0002,0x0001,0x0002,0x0001,0x0002,0x0001
+	dc.w	0x0003,0x0004,0x0005,0x0006,0x0007,0x0008,0x0003,0x0004,0x0003,0x0004,0x0005,0x0006
+	dc.w	0x0009,0x000A,0x0002,0x000B,0x000C,0x0001,0x0009,0x000A,0x0009,0x000A,0x0002,0x000B
+	dc.w	0x0002,0x000D,0x0002,0x000D,0x0002,0x000D,0x0002,0x000D,0x0002,0x000D,0x0002,0x000D
+
+map_blockmap_Unnamed_copy_copy_end:
+map_blockmap_Unnamed_copy_copy_size_b	equ (map_blockmap_Unnamed_copy_copy_end-map_Unnamed_copy_copy)	; Size in bytes
+map_blockmap_Unnamed_copy_copy_size_w	equ (map_blockmap_Unnamed_copy_copy_size_b/2)	; Size in words
+map_blockmap_Unnamed_copy_copy_size_l	equ (map_blockmap_Unnamed_copy_copy_size_b/4)	; Size in longwords
+map_Unnamed_copy_copy_width	equ 0x30
+map_Unnamed_copy_copy_height	equ 0x10
+map_blockmap_Unnamed_copy_copy_width	equ 0x0C
+map_blockmap_Unnamed_copy_copy_height	equ 0x04
+
+map_blockmap_Unnamed_copy_copy_coloffsets:
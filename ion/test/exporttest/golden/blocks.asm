@@ -0,0 +1,72 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+map_blocks_golden:
+	dc.w	0x0000,0x2003,0x0000,0x2003
+	dc.w	0x2001,0x0004,0x2001,0x0004
+	dc.w	0x0002,0x2005,0x2001,0x0002
+	dc.w	0x2003,0x0000,0x2003,0x0804
+	dc.w	0x0000,0x2803,0x1000,0x2003
+	dc.w	0x2001,0x0804,0x3001,0x0004
+	dc.w	0x0002,0x2805,0x1002,0x2005
+	dc.w	0x2003,0x0800,0x3003,0x0000
+	dc.w	0x0000,0x2003,0x0000,0x2003
+	dc.w	0x2001,0x0004,0x2001,0x0004
+	dc.w	0x0002,0x2005,0x0002,0x2005
+	dc.w	0x2003,0x0000,0x2003,0x0000
+	dc.w	0x0004,0x2001,0x0004,0x2001
+	dc.w	0x2005,0x0002,0x2005,0x0002
+	dc.w	0x8000,0xA003,0x8000,0xA003
+	dc.w	0x2001,0x0004,0x2001,0x0004
+	dc.w	0x2005,0x0802,0x3005,0x0002
+	dc.w	0x0000,0x2803,0x1000,0x2003
+	dc.w	0xA001,0x8804,0xB001,0x8004
+	dc.w	0x0002,0x2805,0x1002,0x2005
+	dc.w	0x0000,0x2003,0x0000,0x2003
+	dc.w	0x2001,0x0004,0x2001,0x0004
+	dc.w	0x8002,0xA005,0x8002,0xA005
+	dc.w	0x2003,0x0000,0x2003,0x0000
+	dc.w	0x2001,0x0804,0x3001,0x0004
+	dc.w	0x0002,0x2805,0x1002,0x2005
+	dc.w	0xA003,0x8800,0xB003,0x8000
+	dc.w	0x0004,0x2801,0x1004,0x2001
+	dc.w	0x0002,0x2005,0x0002,0x2005
+	dc.w	0x2003,0x0000,0x2003,0x0000
+	dc.w	0x8004,0xA001,0x8004,0xA001
+	dc.w	0x2005,0x0002,0x2005,0x0002
+	dc.w	0x2003,0x0800,0x3003,0x0000
+	dc.w	0x0004,0x2801,0x1004,0x2001
+	dc.w	0xA005,0x8802,0xB005,0x8002
+	dc.w	0x0000,0x2803,0x1000,0x2003
+	dc.w	0x0002,0x2005,0x0002,0x2005
+	dc.w	0x2003,0x0000,0x2003,0x0000
+	dc.w	0x0004,0x2001,0x0004,0x2001
+	dc.w	0x2005,0x0002,0x2005,0x0002
+	dc.w	0x0004,0x2801,0x1004,0x2001
+	dc.w	0x2005,0x0802,0x3005,0x0002
+	dc.w	0x0000,0x2803,0x1000,0x2003
+	dc.w	0x2001,0x0804,0x3001,0x0004
+	dc.w	0x0002,0x2805,0x1002,0x2005
+	dc.w	0x2003,0x0800,0x3003,0x0000
+	dc.w	0x0004,0x2801,0x1004,0x2001
+	dc.w	0x2005,0x0802,0x3005,0x0002
+	dc.w	0x0004,0x2001,0x0004,0x2001
+	dc.w	0x2005,0x0002,0x2005,0x0002
+	dc.w	0x0000,0x2003,0x0000,0x2003
+	dc.w	0x2001,0x0004,0x2001,0x0004
+	dc.w	0x2003,0x0800,0x3003,0x0000
+	dc.w	0x0004,0x2801,0x1004,0x2001
+	dc.w	0x2005,0x0802,0x3005,0x0002
+	dc.w	0x0000,0x2803,0x1000,0x2003
+
+map_blocks_golden_end:
+map_blocks_golden_size_b	equ (map_blocks_golden_end-map_golden)	; Size in bytes
+map_blocks_golden_size_w	equ (map_blocks_golden_size_b/2)	; Size in words
+map_blocks_golden_size_l	equ (map_blocks_golden_size_b/4)	; Size in longwords
+map_blocks_golden_num_blocks	equ 14	; Size in blocks
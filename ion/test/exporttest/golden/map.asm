@@ -0,0 +1,33 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+map_Unnamed_copy_copy:
+	dc.w	0x0000,0x2003,0x0000,0x2003,0x0000,0x2803,0x1000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2803,0x1000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2803,0x1000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2803,0x1000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2803,0x1000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2803,0x1000,0x2003
+	dc.w	0x2001,0x0004,0x2001,0x0004,0x2001,0x0804,0x3001,0x0004,0x2001,0x0004,0x2001,0x0004,0x2001,0x0804,0x3001,0x0004,0x2001,0x0004,0x2001,0x0004,0x2001,0x0804,0x3001,0x0004,0x2001,0x0004,0x2001,0x0004,0x2001,0x0804,0x3001,0x0004,0x2001,0x0004,0x2001,0x0004,0x2001,0x0804,0x3001,0x0004,0x2001,0x0004,0x2001,0x0004,0x2001,0x0804,0x3001,0x0004
+	dc.w	0x0002,0x2005,0x2001,0x0002,0x0002,0x2805,0x1002,0x2005,0x0002,0x2005,0x0002,0x2005,0x0002,0x2805,0x1002,0x2005,0x0002,0x2005,0x0002,0x2005,0x0002,0x2805,0x1002,0x2005,0x0002,0x2005,0x0002,0x2005,0x0002,0x2805,0x1002,0x2005,0x0002,0x2005,0x0002,0x2005,0x0002,0x2805,0x1002,0x2005,0x0002,0x2005,0x0002,0x2005,0x0002,0x2805,0x1002,0x2005
+	dc.w	0x2003,0x0000,0x2003,0x0804,0x2003,0x0800,0x3003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0800,0x3003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0800,0x3003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0800,0x3003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0800,0x3003,0x0000,0x2003,0x0000,0x2003,0x0000,0x2003,0x0800,0x3003,0x0000
+	dc.w	0x0004,0x2001,0x0004,0x2001,0x2005,0x0802,0x3005,0x0002,0x0000,0x2003,0x0000,0x2003,0x2001,0x0804,0x3001,0x0004,0x0002,0x2005,0x0002,0x2005,0x2003,0x0800,0x3003,0x0000,0x0004,0x2001,0x0004,0x2001,0x2005,0x0802,0x3005,0x0002,0x0004,0x2001,0x0004,0x2001,0x2005,0x0802,0x3005,0x0002,0x0000,0x2003,0x0000,0x2003,0x2001,0x0804,0x3001,0x0004
+	dc.w	0x2005,0x0002,0x2005,0x0002,0x0000,0x2803,0x1000,0x2003,0x2001,0x0004,0x2001,0x0004,0x0002,0x2805,0x1002,0x2005,0x2003,0x0000,0x2003,0x0000,0x0004,0x2801,0x1004,0x2001,0x2005,0x0002,0x2005,0x0002,0x0000,0x2803,0x1000,0x2003,0x2005,0x0002,0x2005,0x0002,0x0000,0x2803,0x1000,0x2003,0x2001,0x0004,0x2001,0x0004,0x0002,0x2805,0x1002,0x2005
+	dc.w	0x0000,0x2003,0x0000,0x2003,0x2001,0x0804,0x3001,0x0004,0x0002,0x2005,0x0002,0x2005,0x2003,0x0800,0x3003,0x0000,0x0004,0x2001,0x0004,0x2001,0x2005,0x0802,0x3005,0x0002,0x0000,0x2003,0x0000,0x2003,0x2001,0x0804,0x3001,0x0004,0x0000,0x2003,0x0000,0x2003,0x2001,0x0804,0x3001,0x0004,0x0002,0x2005,0x0002,0x2005,0x2003,0x0800,0x3003,0x0000
+	dc.w	0x2001,0x0004,0x2001,0x0004,0x0002,0x2805,0x1002,0x2005,0x2003,0x0000,0x2003,0x0000,0x0004,0x2801,0x1004,0x2001,0x2005,0x0002,0x2005,0x0002,0x0000,0x2803,0x1000,0x2003,0x2001,0x0004,0x2001,0x0004,0x0002,0x2805,0x1002,0x2005,0x2001,0x0004,0x2001,0x0004,0x0002,0x2805,0x1002,0x2005,0x2003,0x0000,0x2003,0x0000,0x0004,0x2801,0x1004,0x2001
+	dc.w	0x0002,0x2005,0x0002,0x2005,0x0004,0x2801,0x1004,0x2001,0x0000,0x2003,0x0000,0x2003,0x0002,0x2805,0x1002,0x2005,0x0004,0x2001,0x0004,0x2001,0x0000,0x2803,0x1000,0x2003,0x0002,0x2005,0x0002,0x2005,0x0004,0x2801,0x1004,0x2001,0x0002,0x2005,0x0002,0x2005,0x0004,0x2801,0x1004,0x2001,0x0000,0x2003,0x0000,0x2003,0x0002,0x2805,0x1002,0x2005
+	dc.w	0x2003,0x0000,0x2003,0x0000,0x2005,0x0802,0x3005,0x0002,0x2001,0x0004,0x2001,0x0004,0x2003,0x0800,0x3003,0x0000,0x2005,0x0002,0x2005,0x0002,0x2001,0x0804,0x3001,0x0004,0x2003,0x0000,0x2003,0x0000,0x2005,0x0802,0x3005,0x0002,0x2003,0x0000,0x2003,0x0000,0x2005,0x0802,0x3005,0x0002,0x2001,0x0004,0x2001,0x0004,0x2003,0x0800,0x3003,0x0000
+	dc.w	0x0004,0x2001,0x0004,0x2001,0x0000,0x2803,0x1000,0x2003,0x0002,0x2005,0x0002,0x2005,0x0004,0x2801,0x1004,0x2001,0x0000,0x2003,0x0000,0x2003,0x0002,0x2805,0x1002,0x2005,0x0004,0x2001,0x0004,0x2001,0x0000,0x2803,0x1000,0x2003,0x0004,0x2001,0x0004,0x2001,0x0000,0x2803,0x1000,0x2003,0x0002,0x2005,0x0002,0x2005,0x0004,0x2801,0x1004,0x2001
+	dc.w	0x2005,0x0002,0x2005,0x0002,0x2001,0x0804,0x3001,0x0004,0x2003,0x0000,0x2003,0x0000,0x2005,0x0802,0x3005,0x0002,0x2001,0x0004,0x2001,0x0004,0x2003,0x0800,0x3003,0x0000,0x2005,0x0002,0x2005,0x0002,0x2001,0x0804,0x3001,0x0004,0x2005,0x0002,0x2005,0x0002,0x2001,0x0804,0x3001,0x0004,0x2003,0x0000,0x2003,0x0000,0x2005,0x0802,0x3005,0x0002
+	dc.w	0x0000,0x2003,0x0000,0x2003,0x2003,0x0800,0x3003,0x0000,0x0000,0x2003,0x0000,0x2003,0x2003,0x0800,0x3003,0x0000,0x0000,0x2003,0x0000,0x2003,0x2003,0x0800,0x3003,0x0000,0x0000,0x2003,0x0000,0x2003,0x2003,0x0800,0x3003,0x0000,0x0000,0x2003,0x0000,0x2003,0x2003,0x0800,0x3003,0x0000,0x0000,0x2003,0x0000,0x2003,0x2003,0x0800,0x3003,0x0000
+	dc.w	0x2001,0x0004,0x2001,0x0004,0x0004,0x2801,0x1004,0x2001,0x2001,0x0004,0x2001,0x0004,0x0004,0x2801,0x1004,0x2001,0x2001,0x0004,0x2001,0x0004,0x0004,0x2801,0x1004,0x2001,0x2001,0x0004,0x2001,0x0004,0x0004,0x2801,0x1004,0x2001,0x2001,0x0004,0x2001,0x0004,0x0004,0x2801,0x1004,0x2001,0x2001,0x0004,0x2001,0x0004,0x0004,0x2801,0x1004,0x2001
+	dc.w	0x0002,0x2005,0x0002,0x2005,0x2005,0x0802,0x3005,0x0002,0x0002,0x2005,0x0002,0x2005,0x2005,0x0802,0x3005,0x0002,0x0002,0x2005,0x0002,0x2005,0x2005,0x0802,0x3005,0x0002,0x0002,0x2005,0x0002,0x2005,0x2005,0x0802,0x3005,0x0002,0x0002,0x2005,0x0002,0x2005,0x2005,0x0802,0x3005,0x0002,0x0002,0x2005,0x0002,0x2005,0x2005,0x0802,0x3005,0x0002
+	dc.w	0x2003,0x0000,0x2003,0x0000,0x0000,0x2803,0x1000,0x2003,0x2003,0x0000,0x2003,0x0000,0x0000,0x2803,0x1000,0x2003,0x2003,0x0000,0x2003,0x0000,0x0000,0x2803,0x1000,0x2003,0x2003,0x0000,0x2003,0x0000,0x0000,0x2803,0x1000,0x2003,0x2003,0x0000,0x2003,0x0000,0x0000,0x2803,0x1000,0x2003,0x2003,0x0000,0x2003,0x0000,0x0000,0x2803,0x1000,0x2003
+
+map_Unnamed_copy_copy_end:
+map_Unnamed_copy_copy_size_b	equ (map_Unnamed_copy_copy_end-map_Unnamed_copy_copy)	; Size in bytes
+map_Unnamed_copy_copy_size_w	equ (map_Unnamed_copy_copy_size_b/2)	; Size in words
+map_Unnamed_copy_copy_size_l	equ (map_Unnamed_copy_copy_size_b/4)	; Size in longwords
+map_Unnamed_copy_copy_width	equ 0x30
+map_Unnamed_copy_copy_height	equ 0x10
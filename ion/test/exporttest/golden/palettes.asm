@@ -0,0 +1,78 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+palette_golden:
+	dc.w	0x0E00
+	dc.w	0x0E00
+	dc.w	0x0C02
+	dc.w	0x0C02
+	dc.w	0x0A04
+	dc.w	0x0A04
+	dc.w	0x0806
+	dc.w	0x0806
+	dc.w	0x0608
+	dc.w	0x0608
+	dc.w	0x040A
+	dc.w	0x040A
+	dc.w	0x020C
+	dc.w	0x020C
+	dc.w	0x000E
+	dc.w	0x000E
+
+	dc.w	0x0E80
+	dc.w	0x0E80
+	dc.w	0x0C82
+	dc.w	0x0C82
+	dc.w	0x0A84
+	dc.w	0x0A84
+	dc.w	0x0886
+	dc.w	0x0886
+	dc.w	0x0688
+	dc.w	0x0688
+	dc.w	0x048A
+	dc.w	0x048A
+	dc.w	0x028C
+	dc.w	0x028C
+	dc.w	0x008E
+	dc.w	0x008E
+
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+	dc.w	0x0000
+
@@ -0,0 +1,30 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+stampmap_Unnamed_copy_copy:
+stampmap_golden_count equ 0x0001
+
+stampmap_golden_x_table:
+stampentry_x_golden_0_xpos:	dc.w 0x0002
+stampentry_x_golden_0_ypos:	dc.w 0x0002
+stampentry_x_golden_0_idx:	dc.w 0x0000
+stampentry_x_golden_0_flags:	dc.w 0x0000
+
+stampmap_golden_y_table:
+stampentry_y_golden_0_xpos:	dc.w 0x0002
+stampentry_y_golden_0_ypos:	dc.w 0x0002
+stampentry_y_golden_0_idx:	dc.w 0x0000
+stampentry_y_golden_0_flags:	dc.w 0x0000
+
+stampmap_Unnamed_copy_copy_end:
+stampmap_Unnamed_copy_copy_size_b	equ (stampmap_Unnamed_copy_copy_end-stampmap_Unnamed_copy_copy)	; Size in bytes
+stampmap_Unnamed_copy_copy_size_w	equ (stampmap_Unnamed_copy_copy_size_b/2)	; Size in words
+stampmap_Unnamed_copy_copy_size_l	equ (stampmap_Unnamed_copy_copy_size_b/4)	; Size in longwords
+stampmap_Unnamed_copy_copy_width	equ 0x30
+stampmap_Unnamed_copy_copy_height	equ 0x10
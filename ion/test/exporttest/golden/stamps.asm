@@ -0,0 +1,25 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+stamps_golden:
+stamp_1:
+	dc.w	0x2001,0x0002
+	dc.w	0x2003,0x0804
+
+stamps_golden_table:
+
+stamp_0_offset:	dc.l 0x00000000
+stamp_0_width:	dc.w 0x0002
+stamp_0_height:	dc.w 0x0002
+
+
+stamps_golden_end:
+stamps_golden_size_b	equ (stamps_golden_end-stamps_golden)	; Size in bytes
+stamps_golden_size_w	equ (stamps_golden_size_b/2)	; Size in words
+stamps_golden_size_l	equ (stamps_golden_size_b/4)	; Size in longwords
@@ -0,0 +1,35 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+terrainmap_blockmap_Unnamed_copy_copy:
+
+Terrain_Block_Map:
+	dc.w	0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0001
+	dc.w	0x0001,0x0002,0x0003,0x0000,0x0000,0x0000,0x0001,0x0002,0x0003,0x0000,0x0000,0x0000,0x0004
+	dc.w	0x0004,0x0005,0x0000,0x0006,0x0007,0x0008,0x0005,0x0000,0x0009,0x000A,0x000B,0x0003,0x000C
+
+terrainmap_blockmap_Unnamed_copy_copy_end:
+terrainmap_blockmap_Unnamed_copy_copy_size_b	equ (terrainmap_blockmap_Unnamed_copy_copy_end-terrainmap_Unnamed_copy_copy)	; Size in bytes
+terrainmap_blockmap_Unnamed_copy_copy_size_w	equ (terrainmap_blockmap_Unnamed_copy_copy_size_b/2)	; Size in words
+terrainmap_blockmap_Unnamed_copy_copy_size_l	equ (terrainmap_blockmap_Unnamed_copy_copy_size_b/4)	; Size in longwords
+terrainmap_Unnamed_copy_copy_left	equ 0x00
+terrainmap_Unnamed_copy_copy_top	equ 0x00
+terrainmap_Unnamed_copy_copy_width	equ 0x34
+terrainmap_Unnamed_copy_copy_height	equ 0x0C
+terrainmap_blockmap_Unnamed_copy_copy_left	equ 0x00
+terrainmap_blockmap_Unnamed_copy_copy_top	equ 0x00
+terrainmap_blockmap_Unnamed_copy_copy_width	equ 0x0D
+terrainmap_blockmap_Unnamed_copy_copy_height	equ 0x03
+
+collisionmap_blockmap_yoffs_Unnamed_copy_copy:
+
+; Terrain bezier bounds
+terrainmap_Unnamed_copy_copy_num_special_terrain_descs	equ 0x00
+terrainmap_Unnamed_copy_copy_special_terrain_descs:
+
@@ -0,0 +1,112 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+terrainmap_blocks_golden:
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0002,0x0001,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0002,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0001,0x0002
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0002,0x0001,0x0002
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0002,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0001,0x0002,0x0001,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0002,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0001,0x0002
+	dc.w	0x0000,0x0001,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0002,0x0002,0x0002
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0002,0x0001,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0001,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0002,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0001,0x0002
+	dc.w	0x0000,0x0000,0x0002,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x2001,0x2000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x2000,0x2000,0x0002,0x2000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0001,0x0000,0x0000
+	dc.w	0x0000,0x0001,0x0000,0x0000
+	dc.w	0x2000,0x0000,0x2000,0x2002
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0002,0x0000
+	dc.w	0x0000,0x0000,0x0002,0x0000
+	dc.w	0x0000,0x2000,0x2000,0x0000
+	dc.w	0x0000,0x0001,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x2001,0x2000,0x0000,0x2000
+	dc.w	0x0000,0x0000,0x0002,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x2000,0x0001,0x2000,0x2000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x2000,0x2002,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0001,0x0000,0x0000
+	dc.w	0x0000,0x0001,0x0000,0x0000
+	dc.w	0x2000,0x2000,0x0000,0x2002
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0002,0x0000
+	dc.w	0x0000,0x0000,0x0002,0x0000
+	dc.w	0x2000,0x0000,0x2000,0x2000
+	dc.w	0x0000,0x0001,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0001,0x2000,0x2000,0x0000
+	dc.w	0x0000,0x0000,0x0002,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x2000,0x2001,0x0000,0x2000
+	dc.w	0x0000,0x0000,0x0000,0x0002
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x0001,0x0000,0x0000,0x0000
+	dc.w	0x2000,0x0000,0x2002,0x2000
+	dc.w	0x0000,0x0000,0x0000,0x0000
+	dc.w	0x0000,0x0001,0x0000,0x0000
+
+terrainmap_blocks_golden_end:
+terrainmap_blocks_golden_size_b	equ (terrainmap_blocks_golden_end-terrainmap_golden)	; Size in bytes
+terrainmap_blocks_golden_size_w	equ (terrainmap_blocks_golden_size_b/2)	; Size in words
+terrainmap_blocks_golden_size_l	equ (terrainmap_blocks_golden_size_b/4)	; Size in longwords
+terrainmap_blocks_golden_num_blocks	equ 24	; Size in blocks
@@ -0,0 +1,19 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+TerrainTiles_golden:
+	dc.b	0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7
+	dc.b	0x0, 0x2, 0x4, 0x6, 0x0, 0x2, 0x4, 0x6
+	dc.b	0x0, 0x3, 0x6, 0x1, 0x4, 0x7, 0x2, 0x5
+
+TerrainTiles_golden_end
+TerrainTiles_golden_size_b	equ (TerrainTiles_golden_end-TerrainTiles_golden)	; Size in bytes
+TerrainTiles_golden_size_w	equ (TerrainTiles_golden_size_b/2)	; Size in words
+TerrainTiles_golden_size_l	equ (TerrainTiles_golden_size_b/4)	; Size in longwords
+TerrainTiles_golden_size_t	equ 3	; Size in tiles
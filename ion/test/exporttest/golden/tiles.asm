@@ -0,0 +1,70 @@
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   **AUTOGENERATED WITH BEEHIVE** - the complete art tool for SEGA Mega Drive
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   http://www.bigevilcorporation.co.uk
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+;   Beehive and SEGA Genesis Framework (c) Matt Phillips 2015
+; == == == == == == == == == == == == == == == == == == == == == == == == == == == == == == ==
+
+
+tiles_golden:
+	dc.l	0x01234567
+	dc.l	0x3456789A
+	dc.l	0x6789ABCD
+	dc.l	0x9ABCDEF0
+	dc.l	0xCDEF0123
+	dc.l	0xF0123456
+	dc.l	0x23456789
+	dc.l	0x56789ABC
+
+	dc.l	0x56789ABC
+	dc.l	0x89ABCDEF
+	dc.l	0xBCDEF012
+	dc.l	0xEF012345
+	dc.l	0x12345678
+	dc.l	0x456789AB
+	dc.l	0x789ABCDE
+	dc.l	0xABCDEF01
+
+	dc.l	0xABCDEF01
+	dc.l	0xDEF01234
+	dc.l	0x01234567
+	dc.l	0x3456789A
+	dc.l	0x6789ABCD
+	dc.l	0x9ABCDEF0
+	dc.l	0xCDEF0123
+	dc.l	0xF0123456
+
+	dc.l	0xF0123456
+	dc.l	0x23456789
+	dc.l	0x56789ABC
+	dc.l	0x89ABCDEF
+	dc.l	0xBCDEF012
+	dc.l	0xEF012345
+	dc.l	0x12345678
+	dc.l	0x456789AB
+
+	dc.l	0x456789AB
+	dc.l	0x789ABCDE
+	dc.l	0xABCDEF01
+	dc.l	0xDEF01234
+	dc.l	0x01234567
+	dc.l	0x3456789A
+	dc.l	0x6789ABCD
+	dc.l	0x9ABCDEF0
+
+	dc.l	0x9ABCDEF0
+	dc.l	0xCDEF0123
+	dc.l	0xF0123456
+	dc.l	0x23456789
+	dc.l	0x56789ABC
+	dc.l	0x89ABCDEF
+	dc.l	0xBCDEF012
+	dc.l	0xEF012345
+
+
+tiles_golden_end
+tiles_golden_size_b	equ (tiles_golden_end-tiles_golden)	; Size in bytes
+tiles_golden_size_w	equ (tiles_golden_size_b/2)	; Size in words
+tiles_golden_size_l	equ (tiles_golden_size_b/4)	; Size in longwords
+tiles_golden_size_t	equ 6	; Size in tiles
@@ -0,0 +1,356 @@
+#include <core/Types.h>
+#include <beehive/Project.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+//Incremental export: stages rebuild when, and only when, an input they read changes.
+//Golden export: text exporters produce the same output as before they moved onto AsmEmitter.
+//Usage: exporttest [golden directory], defaults to ./golden
+
+static const char* s_manifestFilename = "exporttest.manifest";
+
+static std::string ReadFile(const std::string& filename)
+{
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static const Project::ExportStageTiming* FindStage(const std::vector<Project::ExportStageTiming>& timings, const std::string& name)
+{
+	for(int i = 0; i < timings.size(); i++)
+	{
+		if(timings[i].name == name)
+			return &timings[i];
+	}
+
+	return NULL;
+}
+
+//Check a stage ran (or was skipped as up to date) on the last export
+static bool CheckStage(const std::vector<Project::ExportStageTiming>& timings, const std::string& name, bool expectRebuilt)
+{
+	const Project::ExportStageTiming* timing = FindStage(timings, name);
+	bool passed = timing && timing->result && (timing->upToDate != expectRebuilt);
+	printf("  %-32s %-10s %s\n", name.c_str(), (timing && !timing->upToDate) ? "rebuilt" : "up to date", passed ? "OK" : "FAILED");
+	return passed;
+}
+
+static bool RunDefaultTerrainTileTest()
+{
+	PlatformConfig config = PlatformPresets::s_configs[PlatformPresets::ePresetMegaDrive];
+	Project project(config);
+
+	TerrainTileId firstTile = project.GetTerrainTileset().AddTerrainTile();
+	TerrainTileId secondTile = project.GetTerrainTileset().AddTerrainTile();
+
+	//Mostly blank, blank cells export as the default tile
+	MapId mapId = project.GetEditingMapId();
+	CollisionMap& collisionMap = project.GetCollisionMap(mapId);
+	collisionMap.SetTerrainTile(1, 1, secondTile);
+	project.SetDefaultTerrainTile(firstTile);
+
+	const std::string& mapName = project.GetMap(mapId).GetName();
+	const std::string collisionMapStage = mapName + " collision map";
+
+	//Binary format writes <name>.bin alongside the .asm header
+	Project::ExportFilenames& filenames = project.m_exportFilenames;
+	filenames.exportFormat = Project::ExportFormat::Binary;
+	filenames.terrainTiles = "exporttest_terraintiles.asm";
+	filenames.terrainTilesExportEnabled = true;
+	filenames.terrainBlocks = "exporttest_terrainblocks.asm";
+	filenames.terrainBlockExportEnabled = true;
+
+	Map::ExportFilenames& mapFilenames = project.GetMap(mapId).m_exportFilenames;
+	mapFilenames.collisionMap = "exporttest_collisionmap.asm";
+	mapFilenames.collisionMapExportEnabled = true;
+
+	std::remove(s_manifestFilename);
+
+	std::vector<Project::ExportStageTiming> timings;
+	bool passed = true;
+
+	printf("First export\n");
+	passed &= project.ExportAll(timings, s_manifestFilename);
+	passed &= CheckStage(timings, "Terrain tiles", true);
+	passed &= CheckStage(timings, "Terrain blocks", true);
+	passed &= CheckStage(timings, collisionMapStage, true);
+
+	std::string collisionMapBefore = ReadFile("exporttest_collisionmap.bin");
+
+	printf("Unchanged\n");
+	passed &= project.ExportAll(timings, s_manifestFilename);
+	passed &= CheckStage(timings, "Terrain tiles", false);
+	passed &= CheckStage(timings, "Terrain blocks", false);
+	passed &= CheckStage(timings, collisionMapStage, false);
+
+	//Changes every blank cell, but not the tiles themselves
+	printf("Default terrain tile changed\n");
+	project.SetDefaultTerrainTile(secondTile);
+	passed &= project.ExportAll(timings, s_manifestFilename);
+	passed &= CheckStage(timings, "Terrain tiles", false);
+	passed &= CheckStage(timings, "Terrain blocks", true);
+	passed &= CheckStage(timings, collisionMapStage, true);
+
+	bool outputChanged = ReadFile("exporttest_collisionmap.bin") != collisionMapBefore;
+	printf("  %-32s %-10s %s\n", "Collision map output", outputChanged ? "changed" : "unchanged", outputChanged ? "OK" : "FAILED");
+	passed &= outputChanged;
+
+	std::remove(s_manifestFilename);
+
+	const char* outputs[] = { "exporttest_terraintiles", "exporttest_terrainblocks", "exporttest_collisionmap" };
+	for(int i = 0; i < sizeof(outputs) / sizeof(outputs[0]); i++)
+	{
+		std::remove((std::string(outputs[i]) + ".asm").c_str());
+		std::remove((std::string(outputs[i]) + ".bin").c_str());
+	}
+
+	return passed;
+}
+
+static bool RunTilePaletteTest()
+{
+	PlatformConfig config = PlatformPresets::s_configs[PlatformPresets::ePresetMegaDrive];
+	Project project(config);
+
+	//Tile 0 stays blank, the rest of the map
+	project.GetTileset().AddTile();
+	TileId secondTile = project.GetTileset().AddTile();
+	project.GetTileset().GetTile(secondTile)->SetPixelColour(0, 0, 1);
+
+	//Map, stamp and stamp map exports all write the tile's palette id
+	MapId mapId = project.GetEditingMapId();
+	Map& map = project.GetMap(mapId);
+	map.SetTile(0, 0, secondTile);
+
+	Stamp* stamp = project.GetStamp(project.AddStamp(1, 1));
+	stamp->SetTile(0, 0, secondTile);
+	map.SetStamp(2, 2, *stamp, 0);
+
+	const std::string& mapName = map.GetName();
+	const std::string mapStage = mapName + " map";
+	const std::string stampMapStage = mapName + " stamp map";
+
+	Project::ExportFilenames& filenames = project.m_exportFilenames;
+	filenames.exportFormat = Project::ExportFormat::Text;
+	filenames.tileset = "exporttest_tiles.asm";
+	filenames.tilesetExportEnabled = true;
+	filenames.stamps = "exporttest_stamps.asm";
+	filenames.stampsExportEnabled = true;
+
+	Map::ExportFilenames& mapFilenames = map.m_exportFilenames;
+	mapFilenames.map = "exporttest_map.asm";
+	mapFilenames.mapExportEnabled = true;
+	mapFilenames.stampMap = "exporttest_stampmap.asm";
+	mapFilenames.stampMapExportEnabled = true;
+
+	std::remove(s_manifestFilename);
+
+	std::vector<Project::ExportStageTiming> timings;
+	bool passed = true;
+
+	printf("First export\n");
+	passed &= project.ExportAll(timings, s_manifestFilename);
+	passed &= CheckStage(timings, "Stamps", true);
+	passed &= CheckStage(timings, mapStage, true);
+	passed &= CheckStage(timings, stampMapStage, true);
+
+	std::string mapBefore = ReadFile("exporttest_map.asm");
+
+	printf("Unchanged\n");
+	passed &= project.ExportAll(timings, s_manifestFilename);
+	passed &= CheckStage(timings, "Stamps", false);
+	passed &= CheckStage(timings, mapStage, false);
+	passed &= CheckStage(timings, stampMapStage, false);
+
+	//Palette only, pixels and placement unchanged
+	printf("Tile palette changed\n");
+	project.GetTileset().GetTile(secondTile)->SetPaletteId(1);
+	passed &= project.ExportAll(timings, s_manifestFilename);
+	passed &= CheckStage(timings, "Tiles", true);
+	passed &= CheckStage(timings, "Stamps", true);
+	passed &= CheckStage(timings, mapStage, true);
+	passed &= CheckStage(timings, stampMapStage, true);
+
+	bool outputChanged = ReadFile("exporttest_map.asm") != mapBefore;
+	printf("  %-32s %-10s %s\n", "Map output", outputChanged ? "changed" : "unchanged", outputChanged ? "OK" : "FAILED");
+	passed &= outputChanged;
+
+	std::remove(s_manifestFilename);
+
+	const char* outputs[] = { "exporttest_tiles", "exporttest_stamps", "exporttest_map", "exporttest_stampmap" };
+	for(int i = 0; i < sizeof(outputs) / sizeof(outputs[0]); i++)
+	{
+		std::remove((std::string(outputs[i]) + ".asm").c_str());
+	}
+
+	return passed;
+}
+
+//Small fixed project touching every text exporter: duplicate and flipped blocks, two palettes, a stamp, terrain and beziers
+static void BuildGoldenProject(Project& project)
+{
+	project.SetName("golden");
+
+	MapId mapId = project.GetEditingMapId();
+	Map& map = project.GetMap(mapId);
+	CollisionMap& collisionMap = project.GetCollisionMap(mapId);
+	map.Resize(48, 16, false, false);
+	collisionMap.Resize(48, 16, false, false);
+
+	for(int paletteId = 0; paletteId < 2; paletteId++)
+	{
+		for(int i = 0; i < Palette::coloursPerPalette; i++)
+		{
+			project.GetPalette(paletteId)->SetColour(i, Colour(i * 16, paletteId * 128, 255 - (i * 16)));
+		}
+	}
+
+	for(int i = 0; i < 6; i++)
+	{
+		Tile* tile = project.GetTileset().GetTile(project.GetTileset().AddTile());
+		tile->SetPaletteId(i & 1);
+
+		for(int y = 0; y < tile->GetHeight(); y++)
+		{
+			for(int x = 0; x < tile->GetWidth(); x++)
+			{
+				tile->SetPixelColour(x, y, (x + (y * 3) + (i * 5)) & 15);
+			}
+		}
+	}
+
+	//Last third repeats the first, so blocks are deduplicated. Enough unique blocks for double digit counts.
+	for(int y = 0; y < map.GetHeight(); y++)
+	{
+		for(int x = 0; x < map.GetWidth(); x++)
+		{
+			int column = x % 32;
+			u32 flags = (((column % 8) == 5) ? Map::eFlipX : 0) | (((column % 8) == 6) ? Map::eFlipY : 0) | ((y == 6) ? Map::eHighPlane : 0);
+			map.SetTile(x, y, ((column * 3) + y + ((column / 4) * (y / 4))) % 6);
+			map.SetTileFlags(x, y, flags);
+		}
+	}
+
+	Stamp* stamp = project.GetStamp(project.AddStamp(2, 2));
+	stamp->SetTile(0, 0, 1);
+	stamp->SetTile(1, 0, 2);
+	stamp->SetTile(0, 1, 3);
+	stamp->SetTile(1, 1, 4);
+	stamp->SetTileFlags(1, 1, Map::eFlipX);
+	map.SetStamp(2, 2, *stamp, 0);
+
+	for(int i = 0; i < 3; i++)
+	{
+		TerrainTile* terrainTile = project.GetTerrainTileset().GetTerrainTile(project.GetTerrainTileset().AddTerrainTile());
+
+		for(int x = 0; x < project.GetPlatformConfig().tileWidth; x++)
+		{
+			terrainTile->SetHeight(x, (x * (i + 1)) % project.GetPlatformConfig().tileHeight);
+		}
+	}
+
+	project.SetDefaultTerrainTile(0);
+
+	for(int x = 0; x < collisionMap.GetWidth(); x++)
+	{
+		collisionMap.SetTerrainTile(x, 4 + ((x / 3) % 8), 1 + (x % 2));
+		collisionMap.SetTerrainTile(x, 15 - ((x * 7) % 5), 1 + ((x / 2) % 2));
+		collisionMap.SetCollisionTileFlags(x, 13, (x % 3) ? eCollisionTileFlagSolid : 0);
+	}
+
+	ion::gamekit::BezierPath* bezier = collisionMap.AddTerrainBezier();
+	bezier->AddPoint(ion::Vector2(0.0f, 40.0f), ion::Vector2(0.0f, 0.0f), ion::Vector2(64.0f, 0.0f));
+	bezier->AddPoint(ion::Vector2(384.0f, 96.0f), ion::Vector2(-64.0f, 0.0f), ion::Vector2(0.0f, 0.0f));
+}
+
+//Text output of the block and map exporters must match the files in goldenDirectory. These are the output of the
+//exporters from before they moved onto AsmEmitter, with two intended changes: block map hex digits are uppercase, and
+//num_blocks is decimal (it used to pick up hex from the block data without a 0x prefix, e.g. "equ E").
+static bool RunGoldenTest(const std::string& goldenDirectory)
+{
+	PlatformConfig config = PlatformPresets::s_configs[PlatformPresets::ePresetMegaDrive];
+	Project project(config);
+	BuildGoldenProject(project);
+
+	const MapId mapId = project.GetEditingMapId();
+	const Project::ExportFormat format = Project::ExportFormat::Text;
+	const int blockWidth = config.blockWidth;
+	const int blockHeight = config.blockHeight;
+
+	struct Export
+	{
+		const char* name;
+		std::function<bool(const std::string&)> run;
+	};
+
+	//In dependency order, block maps read the blocks generated by the block exporters
+	const Export exports[] =
+	{
+		{ "palettes",			[&](const std::string& filename) { return project.ExportPalettes(filename, format); } },
+		{ "tiles",				[&](const std::string& filename) { return project.ExportTiles(filename, format); } },
+		{ "terraintiles",		[&](const std::string& filename) { return project.ExportTerrainTiles(filename, format); } },
+		{ "stamps",				[&](const std::string& filename) { return project.ExportStamps(filename, format); } },
+		{ "map",				[&](const std::string& filename) { return project.ExportMap(mapId, filename, format); } },
+		{ "stampmap",			[&](const std::string& filename) { return project.ExportStampMap(mapId, filename, format); } },
+		{ "collisionmap",		[&](const std::string& filename) { return project.ExportCollisionMap(mapId, filename, format); } },
+		{ "blocks",				[&](const std::string& filename) { return project.ExportBlocks(filename, format, blockWidth, blockHeight); } },
+		{ "blockmap",			[&](const std::string& filename) { return project.ExportBlockMap(mapId, filename, format, blockWidth, blockHeight); } },
+		{ "terrainblocks",		[&](const std::string& filename) { return project.ExportTerrainBlocks(filename, format, blockWidth, blockHeight); } },
+		{ "terrainblockmap",	[&](const std::string& filename) { return project.ExportTerrainBlockMap(mapId, filename, format, blockWidth, blockHeight); } },
+	};
+
+	bool passed = true;
+
+	for(int i = 0; i < sizeof(exports) / sizeof(exports[0]); i++)
+	{
+		std::string filename = std::string("exporttest_golden_") + exports[i].name + ".asm";
+		std::string goldenFilename = goldenDirectory + "/" + exports[i].name + ".asm";
+
+		bool exported = exports[i].run(filename);
+		std::string output = ReadFile(filename);
+		std::string golden = ReadFile(goldenFilename);
+		std::remove(filename.c_str());
+
+		//Report first differing line
+		int line = 1;
+		size_t length = std::min(output.size(), golden.size());
+		size_t offset = std::mismatch(output.begin(), output.begin() + length, golden.begin()).first - output.begin();
+		line += std::count(output.begin(), output.begin() + offset, '\n');
+
+		bool matched = exported && !golden.empty() && (output == golden);
+		printf("  %-32s %s", exports[i].name, matched ? "OK\n" : "FAILED");
+
+		if(!matched)
+		{
+			if(golden.empty())
+				printf(" (missing %s)\n", goldenFilename.c_str());
+			else
+				printf(" (differs at line %d)\n", line);
+		}
+
+		passed &= matched;
+	}
+
+	return passed;
+}
+
+int main(int numargs, char** args)
+{
+	std::string goldenDirectory = (numargs > 1) ? args[1] : "golden";
+
+	printf("Incremental export\n");
+	bool passed = RunDefaultTerrainTileTest();
+	passed &= RunTilePaletteTest();
+
+	printf("Golden text export\n");
+	passed &= RunGoldenTest(goldenDirectory);
+
+	printf(passed ? "All export tests passed\n" : "Export tests FAILED\n");
+	return passed ? 0 : 1;
+}
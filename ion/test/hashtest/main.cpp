@@ -0,0 +1,132 @@
+#include <core/Types.h>
+#include <core/cryptography/Hash.h>
+#include <core/time/Time.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+//Accumulated so the optimiser can't discard hash calls
+static u64 s_sink = 0;
+
+template <typename HASH_FUNC> double MeasureThroughput(const std::vector<u8>& data, int blockSize, HASH_FUNC hashFunc)
+{
+	const int numBlocks = (int)data.size() / blockSize;
+	const int numPasses = 8;
+
+	u64 startTicks = ion::time::GetSystemTicks();
+
+	for(int pass = 0; pass < numPasses; pass++)
+	{
+		for(int block = 0; block < numBlocks; block++)
+		{
+			s_sink += hashFunc(data.data() + (block * blockSize), blockSize);
+		}
+	}
+
+	u64 endTicks = ion::time::GetSystemTicks();
+
+	double seconds = ion::time::TicksToSeconds(endTicks - startTicks);
+	double megabytes = (double)((u64)numBlocks * blockSize * numPasses) / (1024.0 * 1024.0);
+	return (seconds > 0.0) ? (megabytes / seconds) : 0.0;
+}
+
+//HashStream64 must match a one shot HashFast64 however the data is split. Stream blocks are 48 bytes, lengths
+//cover empty, the 16 byte tail, either side of one and several blocks, and chunk sizes smaller and larger than a block.
+static bool CheckStreamMatchesOneShot(const std::vector<u8>& data)
+{
+	const int lengths[] = { 0, 1, 15, 16, 17, 47, 48, 49, 95, 96, 97, 144, 200, 1000, 4099 };
+	const int chunkSizes[] = { 1, 3, 16, 47, 48, 49, 64, 1000 };
+	const u64 seeds[] = { 0, 0x9E3779B97F4A7C15ull };
+	bool passed = true;
+
+	for(int seed = 0; seed < sizeof(seeds) / sizeof(seeds[0]); seed++)
+	{
+		for(int i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+		{
+			const int length = lengths[i];
+			const u64 expected = ion::HashFast64(data.data(), length, seeds[seed]);
+
+			//Fixed size chunks
+			for(int j = 0; j < sizeof(chunkSizes) / sizeof(chunkSizes[0]); j++)
+			{
+				ion::HashStream64 stream(seeds[seed]);
+
+				for(int offset = 0; offset < length; offset += chunkSizes[j])
+				{
+					stream.Update(data.data() + offset, std::min(chunkSizes[j], length - offset));
+				}
+
+				if(stream.Finalise() != expected)
+				{
+					printf("HashStream64 length %d, chunk size %d, seed %d: FAILED\n", length, chunkSizes[j], seed);
+					passed = false;
+				}
+			}
+
+			//Every single split point, including empty updates either end
+			for(int split = 0; split <= length; split++)
+			{
+				ion::HashStream64 stream(seeds[seed]);
+				stream.Update(data.data(), split);
+				stream.Update(data.data() + split, length - split);
+
+				if(stream.Finalise() != expected)
+				{
+					printf("HashStream64 length %d, split at %d, seed %d: FAILED\n", length, split, seed);
+					passed = false;
+					break;
+				}
+			}
+		}
+	}
+
+	return passed;
+}
+
+int main(int numargs, char** args)
+{
+	//32x32 tile at 8bpp is 1024 bytes, 8x8 is 64 bytes
+	const int blockSizes[] = { 8, 16, 64, 256, 1024, 64 * 1024 };
+	const int numBlockSizes = sizeof(blockSizes) / sizeof(int);
+
+	std::vector<u8> data(64 * 1024 * 1024);
+	u32 seed = 12345;
+	for(int i = 0; i < data.size(); i++)
+	{
+		seed = (seed * 1103515245) + 12345;
+		data[i] = (u8)(seed >> 16);
+	}
+
+	printf("block size\tHash\t\tHash64\t\tHashFast64\tHashFast128\tHashStream64\t(MB/sec)\n");
+
+	for(int i = 0; i < numBlockSizes; i++)
+	{
+		int blockSize = blockSizes[i];
+
+		double hash32 = MeasureThroughput(data, blockSize, [](const u8* block, int size) { return (u64)ion::Hash(block, size); });
+		double hash64 = MeasureThroughput(data, blockSize, [](const u8* block, int size) { return ion::Hash64(block, size); });
+		double hashFast64 = MeasureThroughput(data, blockSize, [](const u8* block, int size) { return ion::HashFast64(block, size); });
+		double hashFast128 = MeasureThroughput(data, blockSize, [](const u8* block, int size) { return ion::HashFast128(block, size).low; });
+		double hashStream64 = MeasureThroughput(data, blockSize, [](const u8* block, int size)
+		{
+			ion::HashStream64 stream;
+			stream.Update(block, size / 2);
+			stream.Update(block + (size / 2), size - (size / 2));
+			return stream.Finalise();
+		});
+
+		printf("%d\t\t%.0f\t\t%.0f\t\t%.0f\t\t%.0f\t\t%.0f\n", blockSize, hash32, hash64, hashFast64, hashFast128, hashStream64);
+	}
+
+	//Tag hashes resolve at compile time
+	static_assert(ion::HashConst("tiles") != 0, "HashConst not constexpr");
+
+	bool tagsMatch = (ion::HashConst("tiles") == ion::Hash("tiles")) && (ion::HashConst("__archive_format") == ion::Hash("__archive_format"));
+	printf("HashConst matches Hash: %s\n", tagsMatch ? "OK" : "FAILED");
+
+	bool streamMatches = CheckStreamMatchesOneShot(data);
+	printf("HashStream64 matches HashFast64: %s\n", streamMatches ? "OK" : "FAILED");
+
+	return (tagsMatch && streamMatches && s_sink != 0) ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		QueueTest.cpp
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	ion::Queue MPMC stress test and benchmark
+///////////////////////////////////////////////////
+
+#include "QueueTest.h"
+
+#include <core/time/Time.h>
+
+static const int s_producerShift = 48;
+static const u64 s_sequenceMask = (1ull << s_producerShift) - 1;
+
+QueueTest::ProducerThread::ProducerThread(QueueTest& test, u64 producerIdx, u64 numItems)
+	: ion::thread::Thread("QueueTestProducer")
+	, m_test(test)
+{
+	m_producerIdx = producerIdx;
+	m_numItems = numItems;
+}
+
+void QueueTest::ProducerThread::Entry()
+{
+	while(!m_test.m_start.load(std::memory_order_acquire)) {}
+
+	for(u64 i = 0; i < m_numItems; i++)
+	{
+		m_test.m_queue.Push((m_producerIdx << s_producerShift) | i);
+	}
+}
+
+QueueTest::ConsumerThread::ConsumerThread(QueueTest& test, int numProducers)
+	: ion::thread::Thread("QueueTestConsumer")
+	, m_test(test)
+	, m_lastSequence(numProducers, -1)
+{
+	m_orderValid = true;
+	m_numPopped = 0;
+	m_checksum = 0;
+}
+
+void QueueTest::ConsumerThread::Entry()
+{
+	while(!m_test.m_start.load(std::memory_order_acquire)) {}
+
+	u64 item = 0;
+
+	while(m_test.m_itemsRemaining.load(std::memory_order_relaxed) > 0)
+	{
+		if(m_test.m_queue.TryPop(item))
+		{
+			m_test.m_itemsRemaining.fetch_sub(1, std::memory_order_relaxed);
+
+			//Items from one producer must arrive in push order
+			u64 producerIdx = item >> s_producerShift;
+			s64 sequence = (s64)(item & s_sequenceMask);
+
+			if(producerIdx >= m_lastSequence.size() || sequence <= m_lastSequence[producerIdx])
+			{
+				m_orderValid = false;
+			}
+			else
+			{
+				m_lastSequence[producerIdx] = sequence;
+			}
+
+			m_checksum += item;
+			m_numPopped++;
+		}
+	}
+}
+
+QueueTest::Result QueueTest::Run(int numProducers, int numConsumers, u64 itemsPerProducer)
+{
+	Result result;
+	result.opsPerSecond = 0.0;
+	result.passed = true;
+
+	m_start = false;
+	m_itemsRemaining = itemsPerProducer * numProducers;
+
+	std::vector<ProducerThread*> producers;
+	std::vector<ConsumerThread*> consumers;
+
+	for(int i = 0; i < numProducers; i++)
+	{
+		producers.push_back(new ProducerThread(*this, i, itemsPerProducer));
+		producers.back()->Run();
+	}
+
+	for(int i = 0; i < numConsumers; i++)
+	{
+		consumers.push_back(new ConsumerThread(*this, numProducers));
+		consumers.back()->Run();
+	}
+
+	u64 startTicks = ion::time::GetSystemTicks();
+	m_start.store(true, std::memory_order_release);
+
+	for(int i = 0; i < numProducers; i++)
+	{
+		producers[i]->Join();
+		delete producers[i];
+	}
+
+	u64 numPopped = 0;
+	u64 checksum = 0;
+
+	for(int i = 0; i < numConsumers; i++)
+	{
+		consumers[i]->Join();
+		numPopped += consumers[i]->m_numPopped;
+		checksum += consumers[i]->m_checksum;
+		result.passed &= consumers[i]->m_orderValid;
+		delete consumers[i];
+	}
+
+	u64 endTicks = ion::time::GetSystemTicks();
+
+	//Every item popped exactly once
+	u64 expectedChecksum = 0;
+	for(u64 producerIdx = 0; producerIdx < (u64)numProducers; producerIdx++)
+	{
+		expectedChecksum += (producerIdx << s_producerShift) * itemsPerProducer;
+		expectedChecksum += (itemsPerProducer * (itemsPerProducer - 1)) / 2;
+	}
+
+	result.passed &= (numPopped == itemsPerProducer * numProducers);
+	result.passed &= (checksum == expectedChecksum);
+	result.passed &= m_queue.IsEmpty();
+
+	//One push and one pop per item
+	double seconds = ion::time::TicksToSeconds(endTicks - startTicks);
+	result.opsPerSecond = (seconds > 0.0) ? ((double)(numPopped * 2) / seconds) : 0.0;
+
+	return result;
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////
+// (c) 2016 Matt Phillips, Big Evil Corporation
+// http://www.bigevilcorporation.co.uk
+// mattphillips@mail.com
+// @big_evil_corp
+//
+// Licensed under GPLv3, see http://www.gnu.org/licenses/gpl-3.0.html
+//
+// File:		QueueTest.h
+// Date:		17th October 2026
+// Authors:		agent
+// Description:	ion::Queue MPMC stress test and benchmark
+///////////////////////////////////////////////////
+
+#pragma once
+
+#include <core/Types.h>
+#include <core/containers/Queue.h>
+#include <core/thread/Thread.h>
+
+#include <atomic>
+#include <vector>
+
+class QueueTest
+{
+public:
+	static const int s_queueSize = 1024;
+
+	//Item encodes producer index in top 16 bits, sequence in the rest
+	typedef ion::Queue<u64, s_queueSize> TestQueue;
+
+	struct Result
+	{
+		double opsPerSecond;
+		bool passed;
+	};
+
+	Result Run(int numProducers, int numConsumers, u64 itemsPerProducer);
+
+private:
+	class ProducerThread : public ion::thread::Thread
+	{
+	public:
+		ProducerThread(QueueTest& test, u64 producerIdx, u64 numItems);
+
+	protected:
+		virtual void Entry();
+
+	private:
+		QueueTest& m_test;
+		u64 m_producerIdx;
+		u64 m_numItems;
+	};
+
+	class ConsumerThread : public ion::thread::Thread
+	{
+	public:
+		ConsumerThread(QueueTest& test, int numProducers);
+
+		bool m_orderValid;
+		u64 m_numPopped;
+		u64 m_checksum;
+
+	protected:
+		virtual void Entry();
+
+	private:
+		QueueTest& m_test;
+
+		//Last sequence seen per producer, must increase
+		std::vector<s64> m_lastSequence;
+	};
+
+	TestQueue m_queue;
+	std::atomic<bool> m_start;
+	std::atomic<u64> m_itemsRemaining;
+};
@@ -0,0 +1,36 @@
+#include "QueueTest.h"
+#include <core/debug/Debug.h>
+
+#include <cstdio>
+
+int main(int numargs, char** args)
+{
+	const u64 itemsPerThreadPair = 1000000;
+	const int threadCounts[] = { 1, 2, 4, 8, 16 };
+	const int numThreadCounts = sizeof(threadCounts) / sizeof(int);
+
+	bool passed = true;
+
+	printf("producers\tconsumers\tMops/sec\tresult\n");
+
+	for(int p = 0; p < numThreadCounts; p++)
+	{
+		for(int c = 0; c < numThreadCounts; c++)
+		{
+			int numProducers = threadCounts[p];
+			int numConsumers = threadCounts[c];
+
+			//Same total work for each configuration
+			u64 itemsPerProducer = (itemsPerThreadPair * 4) / numProducers;
+
+			QueueTest* test = new QueueTest();
+			QueueTest::Result result = test->Run(numProducers, numConsumers, itemsPerProducer);
+			delete test;
+
+			printf("%d\t\t%d\t\t%.2f\t\t%s\n", numProducers, numConsumers, result.opsPerSecond / 1000000.0, result.passed ? "OK" : "FAILED");
+			passed &= result.passed;
+		}
+	}
+
+	return passed ? 0 : 1;
+}
@@ -132,7 +132,13 @@ int main(int numargs, char** args)
 	ion::Queue<std::string, sMaxTokens> tokens;
 
 	for (int i = 1; i < numargs; i++)
-		tokens.Push(std::string(args[i]));
+	{
+		if (!tokens.TryPush(std::string(args[i])))
+		{
+			ion::debug::error << "Too many arguments" << ion::debug::end;
+			return -1;
+		}
+	}
 
 	std::string resourceType ;
 
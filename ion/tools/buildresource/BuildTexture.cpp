@@ -91,6 +91,9 @@ namespace ion
 			delete[] pngData;
 		}
 
+		//Texel payloads this size and above are written uncompressed
+		static const u32 s_minUncompressedTexelBytes = 256 * 1024;
+
 		int BuildTexture(const std::string& outputFilename, const std::string& inputFilename, TextureFiletype filetype)
 		{
 			ion::io::File inputFile(inputFilename, ion::io::File::OpenMode::Read);
@@ -130,9 +133,20 @@ namespace ion
 
 			ion::render::Texture* texture = ion::render::Texture::Create();
 			texture->SetSerialiseData(inputFilename, imageData, width, height, sourceFormat, bitsPerPixel);
-			ion::io::Archive archive(outputFile, ion::io::Archive::Direction::Out);
-			ion::render::Texture::RegisterSerialiseType(archive);
-			archive.Serialise(texture);
+			{
+				ion::io::Archive archive(outputFile, ion::io::Archive::Direction::Out);
+
+				//Small textures are built offline with the ratio codec, resource loads detect compression automatically.
+				//Large ones are left uncompressed, so loads upload texels straight from the mapped file (Archive::View)
+				//instead of decompressing a copy, which costs more than the extra disk read it saves.
+				if (imageData.size() < s_minUncompressedTexelBytes)
+				{
+					archive.SetCompression(ion::io::CompressedStream::Codec::LZHigh);
+				}
+
+				ion::render::Texture::RegisterSerialiseType(archive);
+				archive.Serialise(texture);
+			}
 
 			debug::log << "Written: " << outputFilename << debug::end;
 